@@ -31,10 +31,13 @@
 list (APPEND MAIN_SOURCE_FILES
   opm/grid/cpgrid/Intersection.cpp
   opm/grid/cpgrid/CpGridData.cpp
+  opm/grid/cpgrid/ConstructionTimings.cpp
   opm/grid/cpgrid/CpGrid.cpp
+  opm/grid/cpgrid/CpGridVtuWriter.cpp
   opm/grid/cpgrid/DataHandleWrappers.cpp
   opm/grid/cpgrid/GridHelpers.cpp
   opm/grid/cpgrid/PartitionTypeIndicator.cpp
+  opm/grid/cpgrid/createCartesian.cpp
   opm/grid/cpgrid/processEclipseFormat.cpp
   opm/grid/cpgrid/readSintefLegacyFormat.cpp
   opm/grid/cpgrid/writeSintefLegacyFormat.cpp
@@ -54,6 +57,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/grid/cpgpreprocess/uniquepoints.c
   opm/grid/UnstructuredGrid.c
   opm/grid/grid_equal.cpp
+  opm/grid/read_grid_text.cpp
   opm/grid/utility/compressedToCartesian.cpp
   opm/grid/utility/cartesianToCompressed.cpp
   opm/grid/utility/StopWatch.cpp
@@ -85,24 +89,34 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_cpgrid.cpp
   tests/test_communication_utils.cpp
   tests/test_column_extract.cpp
+  tests/test_compute_geometry.cpp
+  tests/cpgrid/constructiontimings_test.cpp
+  tests/cpgrid/createcartesian_test.cpp
   tests/cpgrid/distribution_test.cpp
   tests/cpgrid/entityrep_test.cpp
   tests/cpgrid/entity_test.cpp
   tests/cpgrid/facetag_test.cpp
   tests/cpgrid/grid_pinch.cpp
   tests/cpgrid/geometry_test.cpp
+  tests/cpgrid/lazygeometry_test.cpp
+  tests/cpgrid/memoryusage_test.cpp
   tests/cpgrid/orientedentitytable_test.cpp
   tests/cpgrid/partition_iterator_test.cpp
+  tests/cpgrid/vtuwriter_test.cpp
   tests/cpgrid/zoltan_test.cpp
   tests/test_geom2d.cpp
   tests/test_gridutilities.cpp
   tests/test_minpvprocessor.cpp
   tests/test_polyhedralgrid.cpp
+  tests/test_preprocess.cpp
   tests/p2pcommunicator_test.cc
   tests/test_repairzcorn.cpp
   tests/test_sparsetable.cpp
   tests/test_quadratures.cpp
   tests/test_compressed_cartesian_mapping.cpp
+  tests/test_read_grid.cpp
+  tests/test_velocityinterpolation.cpp
+  tests/test_wachspresscoord.cpp
 	)
 
 if(HAVE_ECL_INPUT)
@@ -129,6 +143,16 @@ list (APPEND TEST_DATA_FILES
 # originally generated with the command:
 # find tutorials examples -name '*.c*' -printf '\t%p\n' | sort
 list (APPEND EXAMPLE_SOURCE_FILES
+  examples/bench_cell_communication.cpp
+  examples/bench_communication_backends.cpp
+  examples/bench_face_communication.cpp
+  examples/bench_grid_traversal.cpp
+  examples/bench_lazy_geometry.cpp
+  examples/bench_minpv.cpp
+  examples/bench_nnc.cpp
+  examples/bench_remote_indices.cpp
+  examples/bench_uniquepoints.cpp
+  examples/bench_velocity_interpolation.cpp
   examples/finitevolume/finitevolume.cc
   examples/mirror_grid.cpp
   )
@@ -140,6 +164,7 @@ list (APPEND PROGRAM_SOURCE_FILES
   )
 if(HAVE_ECL_INPUT)
   list(APPEND EXAMPLE_SOURCE_FILES examples/grdecl2vtu.cpp)
+  list(APPEND EXAMPLE_SOURCE_FILES examples/grid_memory_usage.cpp)
   list(APPEND PROGRAM_SOURCE_FILES examples/grdecl2vtu.cpp)
 endif()
 
@@ -154,7 +179,10 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/grid/common/p2pcommunicator.hh
   opm/grid/common/p2pcommunicator_impl.hh
   opm/grid/cpgrid/CartesianIndexMapper.hpp
+  opm/grid/cpgrid/CommunicationStatistics.hpp
+  opm/grid/cpgrid/ConstructionTimings.hpp
   opm/grid/cpgrid/CpGridData.hpp
+  opm/grid/cpgrid/CpGridVtuWriter.hpp
   opm/grid/cpgrid/DataHandleWrappers.hpp
   opm/grid/cpgrid/DefaultGeometryPolicy.hpp
   opm/grid/cpgrid/dgfparser.hh
@@ -167,6 +195,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/grid/CpGrid.hpp
   opm/grid/cpgrid/Indexsets.hpp
   opm/grid/cpgrid/Intersection.hpp
+  opm/grid/cpgrid/MemoryUsage.hpp
   opm/grid/cpgrid/Iterators.hpp
   opm/grid/cpgrid/OrientedEntityTable.hpp
   opm/grid/cpgrid/PartitionIteratorRule.hpp
@@ -215,10 +244,12 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/grid/transmissibility/TransTpfa_impl.hpp
   opm/grid/utility/compressedToCartesian.hpp
   opm/grid/utility/cartesianToCompressed.hpp
+  opm/grid/utility/CommunicationCounters.hpp
   opm/grid/utility/IteratorRange.hpp
   opm/grid/utility/RegionMapping.hpp
   opm/grid/utility/SparseTable.hpp
   opm/grid/utility/StopWatch.hpp
+  opm/grid/utility/ThreadedPackCommunicator.hpp
   opm/grid/utility/VariableSizeCommunicator.hpp
   opm/grid/utility/VelocityInterpolation.hpp
   opm/grid/utility/WachspressCoord.hpp
@@ -0,0 +1,162 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <dune/common/version.hh>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file bench_cell_communication.cpp
+ * @brief Timing of the exchange of cell values stored in a vector.
+ *
+ * Usage: bench_cell_communication [nx ny nz [repetitions]]
+ *
+ * Load balances a cartesian grid of 100 x 100 x 20 cells (default) and
+ * exchanges 1, 3 and 10 doubles per cell over the InteriorBorder_All
+ * interface, 100 (default) times each, once with a data handle and once
+ * directly from the vector. Reports the times and whether the results
+ * agree.
+ */
+
+namespace
+{
+    /// Copies a block of values per cell.
+    class BlockHandle
+    {
+    public:
+        BlockHandle(std::vector<double>& values, int block_size)
+            : values_(values), block_size_(block_size)
+        {}
+
+        typedef double DataType;
+
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+        bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+        bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+        {
+            return true;
+        }
+
+        template<class T>
+        std::size_t size(const T&)
+        {
+            return block_size_;
+        }
+        template<class B, class T>
+        void gather(B& buffer, const T& t)
+        {
+            for (int i = 0; i < block_size_; ++i) {
+                buffer.write(values_[t.index() * block_size_ + i]);
+            }
+        }
+        template<class B, class T>
+        void scatter(B& buffer, const T& t, std::size_t)
+        {
+            for (int i = 0; i < block_size_; ++i) {
+                buffer.read(values_[t.index() * block_size_ + i]);
+            }
+        }
+        bool contains(int dim, int codim)
+        {
+            return dim == 3 && codim == 0;
+        }
+
+    private:
+        std::vector<double>& values_;
+        int block_size_;
+    };
+
+    std::vector<double> initialValues(const Dune::CpGrid& grid, int block_size)
+    {
+        std::vector<double> values(block_size * grid.numCells(), -1.0);
+        for (const auto& element : elements(grid.leafGridView())) {
+            if (element.partitionType() == Dune::InteriorEntity) {
+                for (int i = 0; i < block_size; ++i) {
+                    values[element.index() * block_size + i] = grid.globalIdSet().id(element) + i;
+                }
+            }
+        }
+        return values;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    std::array<int, 3> dims = {{ 100, 100, 20 }};
+    int repetitions = 100;
+    if (argc >= 4) {
+        dims = {{ std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]) }};
+    }
+    if (argc >= 5) {
+        repetitions = std::atoi(argv[4]);
+    }
+
+    Dune::CpGrid grid;
+    grid.createCartesian(dims, {{ 1.0, 1.0, 1.0 }});
+    grid.loadBalance();
+    const bool root = grid.comm().rank() == 0;
+    if (root) {
+        std::cout << "Grid: " << dims[0] << " x " << dims[1] << " x " << dims[2]
+                  << " on " << grid.comm().size() << " ranks\n";
+    }
+
+    for (const int block_size : { 1, 3, 10 }) {
+        auto handle_values = initialValues(grid, block_size);
+        BlockHandle handle(handle_values, block_size);
+        Opm::time::StopWatch clock;
+        grid.comm().barrier();
+        clock.start();
+        for (int i = 0; i < repetitions; ++i) {
+            grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+        }
+        const double handle_secs = grid.comm().max(clock.secsSinceStart());
+
+        auto direct_values = initialValues(grid, block_size);
+        // The first call creates the datatypes.
+        grid.communicate(direct_values, block_size, Dune::InteriorBorder_All_Interface,
+                         Dune::ForwardCommunication);
+        grid.comm().barrier();
+        clock.start();
+        for (int i = 0; i < repetitions; ++i) {
+            grid.communicate(direct_values, block_size, Dune::InteriorBorder_All_Interface,
+                             Dune::ForwardCommunication);
+        }
+        const double direct_secs = grid.comm().max(clock.secsSinceStart());
+        const int same = grid.comm().min(int(handle_values == direct_values));
+
+        if (root) {
+            std::cout << "Block size " << block_size << ": data handle " << handle_secs
+                      << " s, direct " << direct_secs << " s, results "
+                      << (same ? "agree" : "DIFFER") << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <dune/common/version.hh>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file bench_communication_backends.cpp
+ * @brief Timing of CpGrid::communicate with the different backends.
+ *
+ * Usage: bench_communication_backends [nx ny nz [repetitions]]
+ *
+ * Load balances a cartesian grid of 100 x 100 x 20 cells (default) and
+ * exchanges 4 doubles per cell (fixed size) and 1 to 4 doubles per cell
+ * (variable size) over the InteriorBorder_All interface, 100 (default)
+ * times each. This is done with point-to-point messages, serially and
+ * threaded packed point-to-point messages, and neighborhood collectives.
+ * Reports the maximum time over the ranks. Run with increasing numbers
+ * of processes to compare the scaling of the backends.
+ *
+ * The point-to-point backends duplicate the MPI communicator in each
+ * call, which synchronizes all ranks. The neighborhood collectives reuse
+ * the graph communicator, hence their lead grows with the number of ranks.
+ */
+
+namespace
+{
+    /// Copies a number of doubles per cell that is either fixed or
+    /// varies with the cell index.
+    class CellDataHandle
+    {
+    public:
+        CellDataHandle(std::vector<double>& values, bool fixed)
+            : values_(values), fixed_(fixed)
+        {}
+
+        typedef double DataType;
+
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+        bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+        bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+        {
+            return fixed_;
+        }
+
+        template<class T>
+        std::size_t size(const T& t)
+        {
+            return fixed_ ? 4 : 1 + t.index() % 4;
+        }
+        template<class B, class T>
+        void gather(B& buffer, const T& t)
+        {
+            for (std::size_t i = 0, n = size(t); i < n; ++i) {
+                buffer.write(values_[4 * t.index() + i]);
+            }
+        }
+        template<class B, class T>
+        void scatter(B& buffer, const T& t, std::size_t s)
+        {
+            for (std::size_t i = 0; i < s; ++i) {
+                buffer.read(values_[4 * t.index() + i]);
+            }
+        }
+        bool contains(int dim, int codim)
+        {
+            return dim == 3 && codim == 0;
+        }
+
+    private:
+        std::vector<double>& values_;
+        bool fixed_;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    std::array<int, 3> dims = {{ 100, 100, 20 }};
+    int repetitions = 100;
+    if (argc >= 4) {
+        dims = {{ std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]) }};
+    }
+    if (argc >= 5) {
+        repetitions = std::atoi(argv[4]);
+    }
+
+    Dune::CpGrid grid;
+    grid.createCartesian(dims, {{ 1.0, 1.0, 1.0 }});
+    grid.loadBalance();
+    const bool root = grid.comm().rank() == 0;
+    if (root) {
+        std::cout << "Grid: " << dims[0] << " x " << dims[1] << " x " << dims[2]
+                  << " on " << grid.comm().size() << " ranks\n";
+    }
+
+    struct Backend
+    {
+        const char* name;
+        std::size_t pack_chunk_size;
+        bool neighbor_collectives;
+    };
+    const Backend backends[] = {
+        { "point-to-point",                 0,    false },
+        { "point-to-point, threaded pack",  1024, false },
+        { "neighborhood collectives",       0,    true },
+        { "neighborhood collectives, threaded pack", 1024, true },
+    };
+
+    std::vector<double> values(4 * grid.numCells(), 1.0);
+    for (const auto& backend : backends) {
+        grid.setThreadedPacking(backend.pack_chunk_size);
+        grid.setNeighborCollectives(backend.neighbor_collectives);
+        for (const bool fixed : { true, false }) {
+            CellDataHandle handle(values, fixed);
+            // Creates the graph communicator, if needed.
+            grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+            grid.comm().barrier();
+            Opm::time::StopWatch clock;
+            clock.start();
+            for (int i = 0; i < repetitions; ++i) {
+                grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+            }
+            const double secs = grid.comm().max(clock.secsSinceStart());
+            if (root) {
+                std::cout << backend.name << (fixed ? ", fixed size: " : ", variable size: ")
+                          << secs << " s\n";
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <dune/common/version.hh>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @file bench_face_communication.cpp
+ * @brief Volume and timing of the exchange of face data.
+ *
+ * Usage: bench_face_communication [nx ny nz [repetitions]]
+ *
+ * Load balances a cartesian grid of 100 x 100 x 20 cells (default) and
+ * exchanges one double per face over the InteriorBorder_All interface,
+ * once with the face interfaces and once by sending all faces of the
+ * interface cells, as FaceViaCellHandleWrapper does. Reports the bytes
+ * sent, summed over all ranks, and the time of 10 (default) exchanges.
+ */
+
+namespace
+{
+    /// Sends one double per face, either attached to the faces or to
+    /// the cells containing them, and counts the doubles sent.
+    class FaceDataCounter
+    {
+    public:
+        FaceDataCounter(const Dune::CpGrid& grid, int codim)
+            : grid_(grid), codim_(codim)
+        {}
+
+        typedef double DataType;
+
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+        bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+        bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+        {
+            return codim_ == 1;
+        }
+
+        template<class T>
+        std::size_t size(const T& t)
+        {
+            return T::codimension == 0 ? grid_.numCellFaces(t.index()) : 1;
+        }
+        template<class B, class T>
+        void gather(B& buffer, const T& t)
+        {
+            const std::size_t n = size(t);
+            for (std::size_t i = 0; i < n; ++i) {
+                buffer.write(1.0);
+            }
+            sent_ += n;
+        }
+        template<class B, class T>
+        void scatter(B& buffer, const T&, std::size_t s)
+        {
+            double val;
+            for (std::size_t i = 0; i < s; ++i) {
+                buffer.read(val);
+            }
+        }
+        bool contains(int dim, int codim)
+        {
+            return dim == 3 && codim == codim_;
+        }
+
+        std::size_t sent() const
+        {
+            return sent_;
+        }
+
+    private:
+        const Dune::CpGrid& grid_;
+        int codim_;
+        std::size_t sent_ = 0;
+    };
+
+    void exchange(const Dune::CpGrid& grid, int codim, int repetitions, const char* name)
+    {
+        FaceDataCounter counter(grid, codim);
+        Opm::time::StopWatch clock;
+        clock.start();
+        for (int i = 0; i < repetitions; ++i) {
+            grid.communicate(counter, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+        }
+        const double secs = grid.comm().max(clock.secsSinceStart());
+        const double bytes = grid.comm().sum(double(counter.sent() * sizeof(double))) / repetitions;
+        if (grid.comm().rank() == 0) {
+            std::cout << name << ": " << bytes << " bytes per exchange, "
+                      << secs << " s\n";
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    std::array<int, 3> dims = {{ 100, 100, 20 }};
+    int repetitions = 10;
+    if (argc >= 4) {
+        dims = {{ std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]) }};
+    }
+    if (argc >= 5) {
+        repetitions = std::atoi(argv[4]);
+    }
+
+    Dune::CpGrid grid;
+    grid.createCartesian(dims, {{ 1.0, 1.0, 1.0 }});
+    grid.loadBalance();
+    if (grid.comm().rank() == 0) {
+        std::cout << "Grid: " << dims[0] << " x " << dims[1] << " x " << dims[2]
+                  << " on " << grid.comm().size() << " ranks\n";
+    }
+
+    exchange(grid, 1, repetitions, "Face interfaces");
+    exchange(grid, 0, repetitions, "Faces via cells");
+
+    return EXIT_SUCCESS;
+}
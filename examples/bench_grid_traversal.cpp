@@ -0,0 +1,466 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+// Warning suppression for Dune includes.
+#include <opm/grid/utility/platform_dependent/disable_warnings.h>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/version.hh>
+#include <opm/grid/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/GridHelpers.hpp>
+#include <opm/grid/cpgrid/GridHelpers.hpp>
+#include <opm/grid/polyhedralgrid.hh>
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/cart_grid.h>
+#include <opm/grid/cornerpoint_grid.h>
+#include <opm/grid/cpgpreprocess/preprocess.h>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file bench_grid_traversal.cpp
+ * @brief Timings of the grid access patterns used by simulators.
+ *
+ * Usage: bench_grid_traversal [nx ny nz [cartesian|faulted [repeats [output.json]]]]
+ *
+ * Based on examples/finitevolume. Times element and intersection
+ * iteration, raw face-cell/cell-face access, geometry queries and grid
+ * construction on CpGrid and PolyhedralGrid, and loadBalance() and
+ * communicate() on CpGrid. The "faulted" grid is a corner-point grid
+ * with a vertical fault throw at i = nx/2 and undulating layers, which
+ * produces non-matching faces. Each workload is run 'repeats' times and
+ * the fastest run is reported, as the maximum over all ranks. Results
+ * are written to the JSON file (default bench_grid_traversal.json) by
+ * rank zero.
+ */
+
+namespace
+{
+    struct Result
+    {
+        std::string grid;
+        std::string view;
+        std::string workload;
+        double seconds;
+        double items;
+    };
+
+    // Corner-point description of the synthetic grids.
+    struct CornerPointInput
+    {
+        std::array<int, 3> dims;
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        std::vector<int> actnum;
+
+        grdecl view() const
+        {
+            grdecl g;
+            g.dims[0] = dims[0];
+            g.dims[1] = dims[1];
+            g.dims[2] = dims[2];
+            g.coord = coord.data();
+            g.zcorn = zcorn.data();
+            g.actnum = actnum.data();
+            return g;
+        }
+    };
+
+    // Unit cells. The throw displaces all cells with i >= nx/2, and a
+    // smooth undulation is added to the layer interfaces.
+    CornerPointInput makeCornerPointInput(const std::array<int, 3>& dims, const double fault_throw)
+    {
+        CornerPointInput in;
+        in.dims = dims;
+        const int nx = dims[0], ny = dims[1], nz = dims[2];
+        const double amplitude = 0.2;
+        const double bot = -amplitude;
+        const double top = nz + fault_throw + amplitude;
+        in.coord.reserve(6*(nx + 1)*(ny + 1));
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                const double pillar[6] = { double(i), double(j), bot, double(i), double(j), top };
+                in.coord.insert(in.coord.end(), pillar, pillar + 6);
+            }
+        }
+        in.zcorn.resize(8*std::size_t(nx)*ny*nz);
+        std::size_t ix = 0;
+        for (int k = 0; k < nz; ++k) {
+            for (int t = 0; t < 2; ++t) {
+                for (int j = 0; j < ny; ++j) {
+                    for (int b = 0; b < 2; ++b) {
+                        for (int i = 0; i < nx; ++i) {
+                            for (int a = 0; a < 2; ++a) {
+                                const double x = i + a;
+                                const double y = j + b;
+                                const double shift = (i >= nx/2) ? fault_throw : 0.0;
+                                in.zcorn[ix++] = (k + t) + shift
+                                    + amplitude*std::sin(0.3*x)*std::cos(0.2*y);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        in.actnum.assign(std::size_t(nx)*ny*nz, 1);
+        return in;
+    }
+
+    template <class Func>
+    double bestOf(const int repeats, Func&& func)
+    {
+        Opm::time::StopWatch clock;
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r < repeats; ++r) {
+            clock.start();
+            func();
+            clock.stop();
+            best = std::min(best, clock.secsSinceStart());
+        }
+        return best;
+    }
+
+    // Prevents the compiler from removing the benchmarked loops.
+    volatile double sink = 0.0;
+
+    class Benchmark
+    {
+    public:
+        Benchmark(const Dune::CpGrid::CollectiveCommunication& comm, const int repeats)
+            : comm_(comm), repeats_(repeats)
+        {}
+
+        // Collective for CpGrid workloads, local otherwise.
+        template <class Func>
+        void run(const std::string& grid, const std::string& view, const std::string& workload,
+                 const double items, const bool collective, Func&& func)
+        {
+            double secs = bestOf(repeats_, func);
+            double total_items = items;
+            if (collective) {
+                secs = comm_.max(secs);
+                total_items = comm_.sum(items);
+            }
+            results_.push_back(Result{ grid, view, workload, secs, total_items });
+            if (comm_.rank() == 0) {
+                std::cout << grid << " (" << view << ") " << workload << ": "
+                          << secs << " s, " << total_items/secs << " items/s\n";
+            }
+        }
+
+        template <class Func>
+        void runOnce(const std::string& grid, const std::string& view, const std::string& workload,
+                     const double items, Func&& func)
+        {
+            Opm::time::StopWatch clock;
+            clock.start();
+            func();
+            clock.stop();
+            const double secs = comm_.max(clock.secsSinceStart());
+            results_.push_back(Result{ grid, view, workload, secs, items });
+            if (comm_.rank() == 0) {
+                std::cout << grid << " (" << view << ") " << workload << ": " << secs << " s\n";
+            }
+        }
+
+        void writeJson(const std::string& fname, const std::array<int, 3>& dims,
+                       const std::string& kind) const
+        {
+            std::ofstream os(fname);
+            os.precision(9);
+            os << "{\n"
+               << "  \"dims\": [" << dims[0] << ", " << dims[1] << ", " << dims[2] << "],\n"
+               << "  \"kind\": \"" << kind << "\",\n"
+               << "  \"ranks\": " << comm_.size() << ",\n"
+               << "  \"repeats\": " << repeats_ << ",\n"
+               << "  \"results\": [\n";
+            for (std::size_t i = 0; i < results_.size(); ++i) {
+                const Result& r = results_[i];
+                os << "    { \"grid\": \"" << r.grid << "\", \"view\": \"" << r.view
+                   << "\", \"workload\": \"" << r.workload << "\", \"seconds\": " << r.seconds
+                   << ", \"items\": " << r.items << ", \"items_per_second\": "
+                   << ((r.seconds > 0.0) ? r.items/r.seconds : 0.0) << " }"
+                   << ((i + 1 < results_.size()) ? ",\n" : "\n");
+            }
+            os << "  ]\n}\n";
+        }
+
+    private:
+        Dune::CpGrid::CollectiveCommunication comm_;
+        int repeats_;
+        std::vector<Result> results_;
+    };
+
+    // Dune interface workloads, shared by both grid types.
+    template <class Grid>
+    void traverse(Benchmark& bench, const Grid& grid, const std::string& name,
+                  const std::string& view, const bool collective)
+    {
+        const auto gv = grid.leafGridView();
+        const auto& index_set = gv.indexSet();
+        const double num_cells = gv.size(0);
+
+        bench.run(name, view, "element_iteration", num_cells, collective, [&]() {
+            double sum = 0.0;
+            for (const auto& element : elements(gv)) {
+                sum += index_set.index(element);
+            }
+            sink = sink + sum;
+        });
+
+        double num_intersections = 0.0;
+        for (const auto& element : elements(gv)) {
+            for (const auto& is : intersections(gv, element)) {
+                static_cast<void>(is);
+                num_intersections += 1.0;
+            }
+        }
+        bench.run(name, view, "intersection_iteration", num_intersections, collective, [&]() {
+            double sum = 0.0;
+            for (const auto& element : elements(gv)) {
+                for (const auto& is : intersections(gv, element)) {
+                    if (is.neighbor()) {
+                        sum += index_set.index(is.outside());
+                    } else {
+                        sum -= 1.0;
+                    }
+                }
+            }
+            sink = sink + sum;
+        });
+
+        bench.run(name, view, "geometry_queries", num_cells, collective, [&]() {
+            double sum = 0.0;
+            for (const auto& element : elements(gv)) {
+                const auto geo = element.geometry();
+                sum += geo.volume() + geo.center()[2];
+                for (const auto& is : intersections(gv, element)) {
+                    const auto normal = is.centerUnitOuterNormal();
+                    sum += is.geometry().volume() * normal[0];
+                }
+            }
+            sink = sink + sum;
+        });
+    }
+
+    // Raw face-cell and cell-face access through the grid helpers.
+    template <class RawGrid>
+    void rawAccess(Benchmark& bench, const RawGrid& grid, const std::string& name,
+                   const std::string& view, const bool collective)
+    {
+        using namespace Opm::UgGridHelpers;
+        const int num_cells = numCells(grid);
+        const int num_faces = numFaces(grid);
+        const auto c2f = cell2Faces(grid);
+        const auto face_cells = faceCells(grid);
+
+        bench.run(name, view, "cell_face_access", numCellFaces(grid), collective, [&]() {
+            double sum = 0.0;
+            for (int c = 0; c < num_cells; ++c) {
+                for (const int f : c2f[c]) {
+                    sum += f;
+                }
+            }
+            sink = sink + sum;
+        });
+
+        bench.run(name, view, "face_cell_access", num_faces, collective, [&]() {
+            double sum = 0.0;
+            for (int f = 0; f < num_faces; ++f) {
+                sum += face_cells(f, 0) - face_cells(f, 1);
+            }
+            sink = sink + sum;
+        });
+
+        bench.run(name, view, "raw_geometry_queries", num_faces, collective, [&]() {
+            double sum = 0.0;
+            for (int f = 0; f < num_faces; ++f) {
+                sum += faceArea(grid, f) * faceNormal(grid, f)[0];
+            }
+            for (int c = 0; c < num_cells; ++c) {
+                sum += cellVolume(grid, c) + cellCentroid(grid, c)[2];
+            }
+            sink = sink + sum;
+        });
+    }
+
+    // One double per cell, sent from owners to copies.
+    class CellDataHandle
+    {
+    public:
+        typedef double DataType;
+
+        CellDataHandle(const Dune::CpGrid& grid, std::vector<double>& data)
+            : grid_(grid), data_(data)
+        {}
+
+        bool contains(int /*dim*/, int codim)
+        {
+            return codim == 0;
+        }
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+        bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+        bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+        {
+            return true;
+        }
+        template <class T>
+        std::size_t size(const T&)
+        {
+            return 1;
+        }
+        template <class B, class T>
+        void gather(B& buffer, const T& e)
+        {
+            buffer.write(data_[grid_.leafIndexSet().index(e)]);
+        }
+        template <class B, class T>
+        void scatter(B& buffer, const T& e, std::size_t /*size*/)
+        {
+            buffer.read(data_[grid_.leafIndexSet().index(e)]);
+        }
+
+    private:
+        const Dune::CpGrid& grid_;
+        std::vector<double>& data_;
+    };
+
+    void benchCpGrid(Benchmark& bench, const CornerPointInput& input, const bool cartesian)
+    {
+        const std::string name = "CpGrid";
+        Dune::CpGrid grid;
+        bench.runOnce(name, "global", "construction", double(input.dims[0])*input.dims[1]*input.dims[2], [&]() {
+            if (cartesian) {
+                grid.createCartesian(input.dims, { 1.0, 1.0, 1.0 });
+            } else {
+                grid.processEclipseFormat(input.view(), false);
+            }
+        });
+
+        // Before load balancing the grid lives on rank zero.
+        traverse(bench, grid, name, "global", true);
+        rawAccess(bench, grid, name, "global", true);
+
+        bench.runOnce(name, "distributed", "load_balance", grid.size(0), [&]() {
+            grid.loadBalance();
+        });
+
+        traverse(bench, grid, name, "distributed", true);
+        rawAccess(bench, grid, name, "distributed", true);
+
+        std::vector<double> data(grid.size(0), 1.0);
+        CellDataHandle handle(grid, data);
+        double num_copies = 0.0;
+        for (const auto& element : elements(grid.leafGridView())) {
+            num_copies += (element.partitionType() != Dune::InteriorEntity);
+        }
+        bench.run(name, "distributed", "communicate", num_copies, true, [&]() {
+            grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+        });
+    }
+
+    void benchPolyhedralGrid(Benchmark& bench, const CornerPointInput& input, const bool cartesian)
+    {
+        typedef Dune::PolyhedralGrid<3, 3> Grid;
+        const std::string name = "PolyhedralGrid";
+        std::unique_ptr<Grid> grid;
+        bench.run(name, "global", "construction", double(input.dims[0])*input.dims[1]*input.dims[2], false, [&]() {
+            const grdecl g = input.view();
+            UnstructuredGrid* ug = cartesian
+                ? create_grid_hexa3d(input.dims[0], input.dims[1], input.dims[2], 1.0, 1.0, 1.0)
+                : create_grid_cornerpoint(&g, 0.0);
+            grid.reset(new Grid(Grid::UnstructuredGridPtr(ug)));
+        });
+
+        traverse(bench, *grid, name, "global", false);
+        rawAccess(bench, static_cast<const UnstructuredGrid&>(*grid), name, "global", false);
+    }
+
+} // anonymous namespace
+
+
+int main(int argc, char** argv)
+try
+{
+    const auto& mpi_helper = Dune::MPIHelper::instance(argc, argv);
+
+    std::array<int, 3> dims = { 50, 50, 50 };
+    std::string kind = "cartesian";
+    int repeats = 3;
+    std::string output = "bench_grid_traversal.json";
+    if (argc >= 4) {
+        dims = { std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]) };
+    }
+    if (argc >= 5) {
+        kind = argv[4];
+    }
+    if (argc >= 6) {
+        repeats = std::max(1, std::atoi(argv[5]));
+    }
+    if (argc >= 7) {
+        output = argv[6];
+    }
+    if (kind != "cartesian" && kind != "faulted") {
+        std::cerr << "Unknown grid kind '" << kind << "', expected 'cartesian' or 'faulted'\n";
+        return EXIT_FAILURE;
+    }
+    const bool cartesian = (kind == "cartesian");
+
+    Dune::CpGrid::CollectiveCommunication comm(Dune::MPIHelper::getCommunicator());
+    if (mpi_helper.rank() == 0) {
+        std::cout << "Grid: " << dims[0] << " x " << dims[1] << " x " << dims[2]
+                  << " (" << kind << "), " << mpi_helper.size() << " rank(s)\n";
+    }
+
+    // The faulted grid is processed on every rank, as required by
+    // processEclipseFormat(). The Cartesian grids only need the sizes.
+    CornerPointInput input;
+    input.dims = dims;
+    if (!cartesian) {
+        input = makeCornerPointInput(dims, 0.5);
+    }
+
+    Benchmark bench(comm, repeats);
+    benchCpGrid(bench, input, cartesian);
+    if (mpi_helper.rank() == 0) {
+        benchPolyhedralGrid(bench, input, cartesian);
+        bench.writeJson(output, dims, kind);
+        std::cout << "Results written to " << output << '\n';
+    }
+    return EXIT_SUCCESS;
+}
+catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}
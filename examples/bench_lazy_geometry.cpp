@@ -0,0 +1,110 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/cpgpreprocess/preprocess.h>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file bench_lazy_geometry.cpp
+ * @brief Timing of grid processing with deferred geometry.
+ *
+ * Usage: bench_lazy_geometry [nx ny nz]
+ *
+ * Processes a box grid of 200 x 200 x 50 cells (default) with undulating
+ * layers, once computing all geometry and once deferring the face and
+ * cell geometry. Reports the full startup time, the topology-only
+ * startup time, the time of the first access to the cell volumes that
+ * completes the geometry, and the largest difference between the cell
+ * volumes of the two grids.
+ */
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    int nx = 200, ny = 200, nz = 50;
+    if (argc >= 4) {
+        nx = std::atoi(argv[1]);
+        ny = std::atoi(argv[2]);
+        nz = std::atoi(argv[3]);
+    }
+    std::cout << "Grid: " << nx << " x " << ny << " x " << nz << "\n";
+
+    std::vector<double> coord;
+    for (int j = 0; j <= ny; ++j) {
+        for (int i = 0; i <= nx; ++i) {
+            const double pillar[6] = { double(i), double(j), 0.0, double(i), double(j), double(nz) };
+            coord.insert(coord.end(), pillar, pillar + 6);
+        }
+    }
+    // Layers undulating in i and j, such that the faces are not planar.
+    std::vector<double> zcorn;
+    for (int k = 0; k < 2*nz; ++k) {
+        const int layer = (k + 1) / 2;
+        for (int j = 0; j < 2*ny; ++j) {
+            for (int i = 0; i < 2*nx; ++i) {
+                const double x = (i + 1) / 2, y = (j + 1) / 2;
+                zcorn.push_back(layer + 0.25*std::sin(0.3*x)*std::cos(0.2*y));
+            }
+        }
+    }
+    std::vector<int> actnum(nx*ny*nz, 1);
+    grdecl g;
+    g.dims[0] = nx;
+    g.dims[1] = ny;
+    g.dims[2] = nz;
+    g.coord = coord.data();
+    g.zcorn = zcorn.data();
+    g.actnum = actnum.data();
+
+    Opm::time::StopWatch clock;
+    Dune::CpGrid eager(Dune::MPIHelper::getLocalCommunicator());
+    clock.start();
+    eager.processEclipseFormat(g, false);
+    const double full = clock.secsSinceStart();
+
+    Dune::CpGrid lazy(Dune::MPIHelper::getLocalCommunicator());
+    lazy.setLazyGeometry(true);
+    clock.start();
+    lazy.processEclipseFormat(g, false);
+    const double topology = clock.secsSinceStart();
+    clock.start();
+    const double first_volume = lazy.cellVolume(0);
+    const double deferred = clock.secsSinceStart();
+
+    double max_diff = std::abs(first_volume - eager.cellVolume(0));
+    for (int cell = 1; cell < eager.numCells(); ++cell) {
+        max_diff = std::max(max_diff, std::abs(lazy.cellVolume(cell) - eager.cellVolume(cell)));
+    }
+
+    std::cout << "Full startup:          " << full << " s\n"
+              << "Topology-only startup: " << topology << " s\n"
+              << "Deferred geometry:     " << deferred << " s\n"
+              << "Max volume difference: " << max_diff << "\n";
+
+    return EXIT_SUCCESS;
+}
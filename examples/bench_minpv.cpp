@@ -0,0 +1,131 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/MinpvProcessor.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @file bench_minpv.cpp
+ * @brief Timing of MINPV processing with pinch connections.
+ *
+ * Usage: bench_minpv [nx ny nz [fraction_below_minpv]]
+ *
+ * The default grid has 200 x 200 x 100 cells, use e.g. 1000 1000 50
+ * for a 50M cell case (about 5 GB of memory). The layers have random
+ * thicknesses and pore volumes, and the given fraction of the cells
+ * (default 0.1) has a pore volume below the MINPV threshold. Reports
+ * the time of MinpvProcessor::process() with given and with computed
+ * cell thicknesses, using one thread and all threads.
+ */
+
+namespace
+{
+    Opm::MinpvProcessor::Result run(const Opm::MinpvProcessor& mp,
+                                    const std::vector<double>& thickness,
+                                    const std::vector<double>& pv,
+                                    const std::vector<double>& minpvv,
+                                    const std::vector<int>& actnum,
+                                    const std::vector<double>& zcorn,
+                                    const char* name)
+    {
+        auto z = zcorn;
+        Opm::time::StopWatch clock;
+        clock.start();
+        auto result = mp.process(thickness, 0.01, pv, minpvv, actnum, false, z.data());
+        const double secs = clock.secsSinceStart();
+        std::cout << name << ": " << secs << " s, " << result.removed_cells.size()
+                  << " removed cells, " << result.nnc.size() << " pinch connections\n";
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int nx = 200, ny = 200, nz = 100;
+    double fraction = 0.1;
+    if (argc >= 4) {
+        nx = std::atoi(argv[1]);
+        ny = std::atoi(argv[2]);
+        nz = std::atoi(argv[3]);
+    }
+    if (argc >= 5) {
+        fraction = std::atof(argv[4]);
+    }
+    const std::size_t num_cells = std::size_t(nx) * ny * nz;
+    std::cout << "Grid: " << nx << " x " << ny << " x " << nz << " (" << num_cells << " cells)\n";
+
+    // Random layer thicknesses, constant within a layer of a column.
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> zcorn(8 * num_cells);
+    std::vector<double> thickness(num_cells);
+    std::vector<double> pv(num_cells);
+    std::vector<int> actnum(num_cells);
+    std::vector<double> top(4 * std::size_t(nx) * ny, 0.0);
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                const std::size_t c = i + nx * (j + std::size_t(ny) * k);
+                const double dz = unit(gen) < 0.05 ? 0.0 : 0.1 + unit(gen);
+                thickness[c] = dz;
+                pv[c] = unit(gen) < fraction ? 0.0 : 1.0 + dz;
+                actnum[c] = unit(gen) < 0.02 ? 0 : 1;
+                for (int dj = 0; dj < 2; ++dj) {
+                    for (int di = 0; di < 2; ++di) {
+                        const std::size_t col = 2 * i + di + 2 * nx * (2 * j + dj);
+                        const std::size_t layer = 4 * std::size_t(nx) * ny;
+                        zcorn[col + layer * 2 * k] = top[col];
+                        top[col] += dz;
+                        zcorn[col + layer * (2 * k + 1)] = top[col];
+                    }
+                }
+            }
+        }
+    }
+    const std::vector<double> minpvv(num_cells, 0.5);
+    const Opm::MinpvProcessor mp(nx, ny, nz);
+
+#ifdef _OPENMP
+    const int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    run(mp, thickness, pv, minpvv, actnum, zcorn, "Given thickness, 1 thread");
+    run(mp, {}, pv, minpvv, actnum, zcorn, "Computed thickness, 1 thread");
+    omp_set_num_threads(num_threads);
+    std::cout << "Threads: " << num_threads << '\n';
+#endif
+    const auto given = run(mp, thickness, pv, minpvv, actnum, zcorn, "Given thickness");
+    const auto computed = run(mp, {}, pv, minpvv, actnum, zcorn, "Computed thickness");
+    if (given.nnc != computed.nnc || given.removed_cells != computed.removed_cells) {
+        std::cerr << "Results differ between given and computed thickness\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
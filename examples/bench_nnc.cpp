@@ -0,0 +1,121 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/cpgrid/CpGridData.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bench_nnc.cpp
+ * @brief Timing of grid processing with many explicit NNCs.
+ *
+ * Usage: bench_nnc [nx ny nz [num_nnc]]
+ *
+ * Processes a box grid of 100 x 100 x 50 cells (default) with the given
+ * number of random explicit NNCs (default 5M), one in ten of them
+ * duplicated and one in ten coinciding with a geometric face. Reports
+ * the time of processEclipseFormat() with and without the NNCs, the
+ * difference being the cost of the NNC handling.
+ */
+
+namespace
+{
+    double process(const grdecl& g, std::array<std::vector<std::pair<int, int>>, 2> nnc,
+                   const char* name)
+    {
+        Dune::cpgrid::CpGridData data;
+        Opm::time::StopWatch clock;
+        clock.start();
+        data.processEclipseFormat(g, nullptr, nnc, false, false, false);
+        const double secs = clock.secsSinceStart();
+        std::cout << name << ": " << secs << " s, " << data.size(1) << " faces\n";
+        return secs;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    int nx = 100, ny = 100, nz = 50;
+    int num_nnc = 5000000;
+    if (argc >= 4) {
+        nx = std::atoi(argv[1]);
+        ny = std::atoi(argv[2]);
+        nz = std::atoi(argv[3]);
+    }
+    if (argc >= 5) {
+        num_nnc = std::atoi(argv[4]);
+    }
+    const int num_cells = nx * ny * nz;
+    std::cout << "Grid: " << nx << " x " << ny << " x " << nz << ", "
+              << num_nnc << " explicit NNCs\n";
+
+    std::vector<double> coord;
+    for (int j = 0; j <= ny; ++j) {
+        for (int i = 0; i <= nx; ++i) {
+            const double pillar[6] = { double(i), double(j), 0.0, double(i), double(j), double(nz) };
+            coord.insert(coord.end(), pillar, pillar + 6);
+        }
+    }
+    std::vector<double> zcorn;
+    for (int k = 0; k < nz; ++k) {
+        zcorn.insert(zcorn.end(), 4 * nx * ny, double(k));
+        zcorn.insert(zcorn.end(), 4 * nx * ny, double(k + 1));
+    }
+    std::vector<int> actnum(num_cells, 1);
+    grdecl g;
+    g.dims[0] = nx;
+    g.dims[1] = ny;
+    g.dims[2] = nz;
+    g.coord = coord.data();
+    g.zcorn = zcorn.data();
+    g.actnum = actnum.data();
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> cell(0, num_cells - 1);
+    std::array<std::vector<std::pair<int, int>>, 2> nnc;
+    auto& explicit_nnc = nnc[1];
+    explicit_nnc.reserve(num_nnc);
+    while (int(explicit_nnc.size()) < num_nnc) {
+        const int c1 = cell(gen);
+        if (explicit_nnc.size() % 10 == 1) {
+            explicit_nnc.push_back(explicit_nnc.back());
+        } else if (explicit_nnc.size() % 10 == 2 && c1 + 1 < num_cells) {
+            explicit_nnc.emplace_back(c1, c1 + 1);
+        } else {
+            explicit_nnc.emplace_back(c1, cell(gen));
+        }
+    }
+
+    const double without = process(g, {}, "Without NNCs");
+    const double with = process(g, nnc, "With NNCs");
+    std::cout << "NNC handling: " << with - without << " s\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @file bench_remote_indices.cpp
+ * @brief Timing of the setup of the remote indices of the cells.
+ *
+ * Usage: bench_remote_indices [nx ny nz]
+ *
+ * Load balances a cartesian grid of 100 x 100 x 20 cells (default). The
+ * remote indices are set up from the export list of the partitioning.
+ * Reports the time of this setup and the time of rediscovering the remote
+ * indices with RemoteIndices::rebuild, which needs communication between
+ * all processes, and checks that both agree. Reports the maximum times over
+ * the ranks. Also reports the time of setting up the face and point
+ * interfaces from the attributes received over the cell interface. Run
+ * with many, possibly oversubscribed, processes, e.g.
+ * mpirun --oversubscribe -np 256 bench_remote_indices, to see the scaling.
+ */
+
+namespace
+{
+    /// The maximum time over all ranks of the phases whose name ends with name.
+    double phaseTime(const Dune::CpGrid& grid, const std::string& name)
+    {
+        double secs = 0.0;
+        for (const auto& phase : grid.constructionTimings().phases()) {
+            if (phase.name.size() >= name.size()
+                && phase.name.compare(phase.name.size() - name.size(), name.size(), name) == 0) {
+                secs += phase.seconds;
+            }
+        }
+        return grid.comm().max(secs);
+    }
+
+    bool sameRemoteIndices(const Dune::CpGrid::RemoteIndices& r1,
+                           const Dune::CpGrid::RemoteIndices& r2)
+    {
+        if (r1.neighbours() != r2.neighbours()) {
+            return false;
+        }
+        for (auto l1 = r1.begin(), l2 = r2.begin(); l1 != r1.end(); ++l1, ++l2) {
+            if (l1->first != l2->first || l1->second.first->size() != l2->second.first->size()) {
+                return false;
+            }
+            auto i2 = l2->second.first->begin();
+            for (const auto& index : *l1->second.first) {
+                if (index.attribute() != i2->attribute()
+                    || index.localIndexPair().global() != i2->localIndexPair().global()
+                    || index.localIndexPair().local() != i2->localIndexPair().local()) {
+                    return false;
+                }
+                ++i2;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    std::array<int, 3> dims = {{ 100, 100, 20 }};
+    if (argc >= 4) {
+        dims = {{ std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]) }};
+    }
+
+    Dune::CpGrid grid;
+    grid.createCartesian(dims, {{ 1.0, 1.0, 1.0 }});
+    grid.loadBalance();
+    const bool root = grid.comm().rank() == 0;
+    if (root) {
+        std::cout << "Grid: " << dims[0] << " x " << dims[1] << " x " << dims[2]
+                  << " on " << grid.comm().size() << " ranks\n";
+    }
+
+    const double compute_secs = phaseTime(grid, "/computeRemoteCells");
+    const double setup_secs = phaseTime(grid, "/cellRemoteIndices");
+    const double face_secs = phaseTime(grid, "/faceInterfaces");
+    const double point_secs = phaseTime(grid, "/pointInterfaces");
+
+    Dune::CpGrid::RemoteIndices rebuilt(grid.getCellIndexSet(), grid.getCellIndexSet(),
+                                        grid.comm());
+    grid.comm().barrier();
+    Opm::time::StopWatch clock;
+    clock.start();
+    rebuilt.rebuild<false>();
+    const double rebuild_secs = grid.comm().max(clock.secsSinceStart());
+    const int same = grid.comm().min(int(sameRemoteIndices(grid.getCellRemoteIndices(), rebuilt)));
+
+    if (root) {
+        std::cout << "From export list: " << compute_secs << " s scattering, "
+                  << setup_secs << " s setup\n"
+                  << "Rebuild:          " << rebuild_secs << " s\n"
+                  << "Remote indices " << (same ? "agree" : "DIFFER") << "\n"
+                  << "Interfaces:       " << face_secs << " s faces, "
+                  << point_secs << " s points\n";
+    }
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
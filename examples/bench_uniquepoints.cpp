@@ -0,0 +1,149 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/cpgpreprocess/preprocess.h>
+extern "C" {
+#include <opm/grid/cpgpreprocess/uniquepoints.h>
+}
+#include <opm/grid/utility/StopWatch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file bench_uniquepoints.cpp
+ * @brief Timing of unique point extraction for corner-point grids with many layers.
+ *
+ * Usage: bench_uniquepoints [nx ny nz [repeats]]
+ *
+ * The grid has nx x ny columns of nz layers with undulating horizons
+ * and a different vertical throw in each column, such that all four
+ * columns around a pillar contribute distinct points. Reports the best
+ * time of finduniquepoints() and of the complete process_grdecl().
+ */
+
+namespace
+{
+    struct Input
+    {
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        std::vector<int> actnum;
+        grdecl g;
+    };
+
+    // ZCORN in Eclipse (i,j,k) order if natural, else in the (k,i,j)
+    // order expected by finduniquepoints().
+    void makeInput(const int nx, const int ny, const int nz, const bool natural, Input& in)
+    {
+        in.coord.resize(6*(nx + 1)*(ny + 1));
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                double* c = &in.coord[6*(i + (nx + 1)*j)];
+                c[0] = c[3] = i;
+                c[1] = c[4] = j;
+                c[2] = 0.0;
+                c[5] = nz;
+            }
+        }
+        in.zcorn.resize(8*std::size_t(nx)*ny*nz);
+        for (int k = 0; k < 2*nz; ++k) {
+            for (int j = 0; j < 2*ny; ++j) {
+                for (int i = 0; i < 2*nx; ++i) {
+                    const int pi = (i + 1)/2, pj = (j + 1)/2;
+                    const double z = (k + 1)/2 + 0.2*std::sin(0.3*pi + 0.2*pj)
+                        + 0.05*(((i/2)*7 + (j/2)*3) % 5);
+                    const std::size_t ix = natural
+                        ? i + 2*std::size_t(nx)*(j + 2*std::size_t(ny)*k)
+                        : k + 2*std::size_t(nz)*(i + 2*std::size_t(nx)*j);
+                    in.zcorn[ix] = z;
+                }
+            }
+        }
+        in.actnum.assign(std::size_t(nx)*ny*nz, 1);
+        for (std::size_t c = 0; c < in.actnum.size(); c += 13) {
+            in.actnum[c] = 0;
+        }
+        in.g.dims[0] = nx;
+        in.g.dims[1] = ny;
+        in.g.dims[2] = nz;
+        in.g.coord = in.coord.data();
+        in.g.zcorn = in.zcorn.data();
+        in.g.actnum = in.actnum.data();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int nx = 20, ny = 20, nz = 500, repeats = 3;
+    if (argc >= 4) {
+        nx = std::atoi(argv[1]);
+        ny = std::atoi(argv[2]);
+        nz = std::atoi(argv[3]);
+    }
+    if (argc >= 5) {
+        repeats = std::atoi(argv[4]);
+    }
+    std::cout << "Grid: " << nx << " x " << ny << " x " << nz << '\n';
+
+    Opm::time::StopWatch clock;
+    clock.start();
+
+    Input permuted;
+    makeInput(nx, ny, nz, false, permuted);
+    std::vector<int> plist(std::size_t(2*nx)*(2*ny)*(2*nz + 2));
+    double best = 1e100;
+    int num_points = 0;
+    for (int r = 0; r < repeats; ++r) {
+        processed_grid out;
+        out.dimensions[0] = nx;
+        out.dimensions[1] = ny;
+        out.dimensions[2] = nz;
+        out.node_coordinates = nullptr;
+        clock.secsSinceLast();
+        if (!finduniquepoints(&permuted.g, plist.data(), 0.0, &out)) {
+            std::cerr << "finduniquepoints() failed\n";
+            return EXIT_FAILURE;
+        }
+        best = std::min(best, clock.secsSinceLast());
+        num_points = out.number_of_nodes;
+        std::free(out.node_coordinates);
+    }
+    std::cout << "finduniquepoints: " << best << " s, " << num_points << " points\n";
+
+    Input natural;
+    makeInput(nx, ny, nz, true, natural);
+    best = 1e100;
+    for (int r = 0; r < repeats; ++r) {
+        processed_grid out;
+        clock.secsSinceLast();
+        process_grdecl(&natural.g, 0.0, nullptr, &out, false);
+        best = std::min(best, clock.secsSinceLast());
+        num_points = out.number_of_nodes;
+        free_processed_grid(&out);
+    }
+    std::cout << "process_grdecl: " << best << " s, " << num_points << " nodes\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/grid/GridManager.hpp>
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/utility/StopWatch.hpp>
+#include <opm/grid/utility/VelocityInterpolation.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @file bench_velocity_interpolation.cpp
+ * @brief Throughput of ECVI velocity interpolation in points per second.
+ *
+ * Usage: bench_velocity_interpolation [nx ny nz [points_per_cell]]
+ *
+ * Compares pointwise interpolation through the virtual interface with
+ * the batched interpolation of points in one cell and of (cell, point)
+ * pairs, and reports the construction time of the interpolator.
+ */
+
+namespace
+{
+    void report(const char* name, const double secs, const int num_points)
+    {
+        std::cout << name << ": " << secs << " s, "
+                  << num_points/secs << " points/s\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int nx = 50, ny = 50, nz = 50, points_per_cell = 8;
+    if (argc >= 4) {
+        nx = std::atoi(argv[1]);
+        ny = std::atoi(argv[2]);
+        nz = std::atoi(argv[3]);
+    }
+    if (argc >= 5) {
+        points_per_cell = std::atoi(argv[4]);
+    }
+
+    Opm::GridManager gm(nx, ny, nz);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    const int dim = grid.dimensions;
+    const int num_cells = grid.number_of_cells;
+
+    // Flux of a smoothly varying velocity field.
+    std::vector<double> flux(grid.number_of_faces);
+    for (int face = 0; face < grid.number_of_faces; ++face) {
+        const double* fc = grid.face_centroids + dim*face;
+        const double* fn = grid.face_normals + dim*face;
+        flux[face] = (1.0 + 0.1*fc[2])*fn[0] + (0.5 - 0.2*fc[0])*fn[1] + 0.3*fn[2];
+    }
+
+    Opm::time::StopWatch clock;
+    clock.start();
+    Opm::VelocityInterpolationECVI ecvi(grid);
+    const double construct_secs = clock.secsSinceLast();
+    ecvi.setupFluxes(flux.data());
+    const double setup_secs = clock.secsSinceLast();
+    std::cout << "Grid: " << nx << " x " << ny << " x " << nz << " (" << num_cells << " cells)\n"
+              << "Construction: " << construct_secs << " s\n"
+              << "Flux setup: " << setup_secs << " s\n";
+
+    // Random points around the cell centroids, grouped by cell.
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> offset(-0.4, 0.4);
+    const int num_points = num_cells*points_per_cell;
+    std::vector<int> cells(num_points);
+    std::vector<double> x(dim*num_points);
+    for (int p = 0; p < num_points; ++p) {
+        cells[p] = p / points_per_cell;
+        for (int dd = 0; dd < dim; ++dd) {
+            x[dim*p + dd] = grid.cell_centroids[dim*cells[p] + dd] + offset(gen);
+        }
+    }
+    std::vector<double> v(dim*num_points);
+
+    const Opm::VelocityInterpolationInterface& vi = ecvi;
+    clock.secsSinceLast();
+    for (int p = 0; p < num_points; ++p) {
+        vi.interpolate(cells[p], &x[dim*p], &v[dim*p]);
+    }
+    report("Pointwise (virtual)", clock.secsSinceLast(), num_points);
+
+    for (int cell = 0; cell < num_cells; ++cell) {
+        const int first = cell*points_per_cell;
+        ecvi.interpolateBatch(cell, points_per_cell, &x[dim*first], &v[dim*first]);
+    }
+    report("Batched, per cell", clock.secsSinceLast(), num_points);
+
+    ecvi.interpolateBatch(num_points, cells.data(), x.data(), v.data());
+    report("Batched, (cell, point) pairs", clock.secsSinceLast(), num_points);
+
+    return EXIT_SUCCESS;
+}
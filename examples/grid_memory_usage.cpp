@@ -0,0 +1,143 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <opm/grid/CpGrid.hpp>
+
+#include <opm/grid/utility/OpmParserIncludes.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file grid_memory_usage.cpp
+ * @brief Prints the memory held by a CpGrid for a deck.
+ *
+ * Usage: grid_memory_usage deck [num_ranks]
+ *
+ * Builds the global grid of the deck and prints the bytes held per
+ * component. When run on several processes, the grid is load balanced
+ * and the maximum and sum over the ranks of the distributed view are
+ * printed as well. Finally, the totals for num_ranks processes (default
+ * the number of processes used) are projected by scaling the global
+ * view with the share of cells of a rank, including one layer of
+ * overlap around a cube-shaped partition.
+ */
+
+namespace
+{
+    double megabytes(double bytes)
+    {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    void printRow(const std::string& name, double a, double b)
+    {
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(12) << a << std::setw(12) << b << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+try
+{
+    const auto& helper = Dune::MPIHelper::instance(argc, argv);
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: grid_memory_usage deck [num_ranks]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int num_procs = helper.size();
+    const int num_ranks = argc == 3 ? std::atoi(argv[2]) : num_procs;
+    const bool root = helper.rank() == 0;
+
+    Dune::CpGrid grid;
+    {
+        Opm::Parser parser;
+        const auto deck = parser.parseFile(argv[1]);
+        const Opm::EclipseGrid ecl_grid(deck);
+        grid.processEclipseFormat(root ? &ecl_grid : nullptr, nullptr, false, false, false);
+    }
+    const int num_cells = grid.comm().max(grid.numCells());
+    const auto global_usage = grid.memoryUsage();
+
+    if (root) {
+        std::cout << "Global grid of " << num_cells << " cells\n";
+        std::cout << std::left << std::setw(40) << "component" << std::right
+                  << std::setw(12) << "MiB" << std::setw(12) << "B/cell" << "\n";
+        for (const auto& component : global_usage.components) {
+            printRow(component.first, megabytes(component.second),
+                     double(component.second) / std::max(num_cells, 1));
+        }
+        printRow("total", megabytes(global_usage.total()),
+                 double(global_usage.total()) / std::max(num_cells, 1));
+    }
+
+    if (num_procs > 1) {
+        grid.loadBalance();
+        const auto usage = grid.memoryUsage();
+        std::vector<double> max_bytes, sum_bytes;
+        for (const auto& component : usage.components) {
+            max_bytes.push_back(component.second);
+            sum_bytes.push_back(component.second);
+        }
+        grid.comm().max(max_bytes.data(), max_bytes.size());
+        grid.comm().sum(sum_bytes.data(), sum_bytes.size());
+        const double max_total = grid.comm().max(double(usage.total()));
+        const double sum_total = grid.comm().sum(double(usage.total()));
+        if (root) {
+            std::cout << "\nMeasured on " << num_procs << " ranks\n"
+                      << std::left << std::setw(40) << "component" << std::right
+                      << std::setw(12) << "max MiB" << std::setw(12) << "sum MiB" << "\n";
+            for (std::size_t i = 0; i < usage.components.size(); ++i) {
+                printRow(usage.components[i].first, megabytes(max_bytes[i]), megabytes(sum_bytes[i]));
+            }
+            printRow("total", megabytes(max_total), megabytes(sum_total));
+        }
+    }
+
+    if (root && num_ranks > 1) {
+        // Cells of one rank: its share plus one layer of overlap around
+        // a cube of that many cells.
+        const double owned = double(num_cells) / num_ranks;
+        const double side = std::cbrt(owned);
+        const double with_overlap = std::min(double(num_cells), std::pow(side + 2.0, 3));
+        const double per_rank = global_usage.total() * with_overlap / std::max(num_cells, 1);
+        std::cout << "\nProjected for " << num_ranks << " ranks (estimate)\n";
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  cells per rank incl. overlap: " << with_overlap << "\n"
+                  << "  per rank:                     " << megabytes(per_rank) << " MiB\n"
+                  << "  rank 0 incl. global grid:     " << megabytes(per_rank + global_usage.total()) << " MiB\n"
+                  << "  all ranks:                    " << megabytes(num_ranks * per_rank + global_usage.total()) << " MiB\n";
+    }
+    return EXIT_SUCCESS;
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
@@ -14,6 +14,7 @@ set (opm-grid_CONFIG_VAR
   HAVE_ZOLTAN
   HAVE_OPM_COMMON
   HAVE_ECL_INPUT
+  OPM_GRID_64BIT_INDICES
   )
 
 # dependencies
@@ -63,7 +63,10 @@
 
 #include <opm/grid/utility/platform_dependent/reenable_warnings.h>
 
+#include "cpgrid/CommunicationStatistics.hpp"
+#include "cpgrid/ConstructionTimings.hpp"
 #include "cpgrid/Intersection.hpp"
+#include "cpgrid/MemoryUsage.hpp"
 #include "cpgrid/Entity.hpp"
 #include "cpgrid/Geometry.hpp"
 #include "cpgrid/Iterators.hpp"
@@ -294,6 +297,19 @@ namespace Dune
         /// \param remove_ij_boundary if true, will remove (i, j) boundaries. Used internally.
         void processEclipseFormat(const grdecl& input_data, bool remove_ij_boundary, bool turn_normals = false);
 
+        /// Set whether processEclipseFormat() defers the face and cell geometry.
+        ///
+        /// With deferred geometry only the topology and the points are
+        /// computed during processing. The face geometry and normals, and
+        /// the cell geometry, are computed in parallel on first access,
+        /// e.g. by Entity::geometry(), cellVolume(), faceArea() or
+        /// loadBalance(). Results are the same as without deferring.
+        /// \param lazy if true, defer the geometry. Default is false.
+        void setLazyGeometry(bool lazy)
+        {
+            data_->setLazyGeometry(lazy);
+        }
+
         //@}
 
         /// \name Cartesian grid extensions.
@@ -308,6 +324,15 @@ namespace Dune
         void createCartesian(const std::array<int, 3>& dims,
                              const std::array<double, 3>& cellsize);
 
+        /// Create a tensor-product cartesian grid.
+        ///
+        /// Topology and geometry are set up directly, without going
+        /// through the corner-point processing used for general grids.
+        /// \param coordinates the strictly increasing node coordinates
+        ///        along each cartesian direction, i.e. n + 1 values for
+        ///        a direction with n cells.
+        void createCartesian(const std::array<std::vector<double>, 3>& coordinates);
+
         /// The logical cartesian size of the global grid.
         /// This function is not part of the Dune grid interface,
         /// and should be used with caution.
@@ -356,6 +381,33 @@ namespace Dune
             current_view_data_->setUniqueBoundaryIds(uids);
         }
 
+        /// \brief The timings of the grid construction phases run on this rank.
+        ///
+        /// Covers the processing of the input, the partitioning and the
+        /// distribution of the grid.
+        const cpgrid::ConstructionTimings& constructionTimings() const;
+
+        /// \brief Gather the grid construction phases of all ranks on rank 0.
+        ///
+        /// Has to be called on all ranks.
+        /// \return On rank 0 the phases of rank 0, then those of rank 1, ...
+        ///         An empty vector on the other ranks.
+        std::vector<cpgrid::ConstructionPhase> gatherConstructionTimings() const;
+
+        /// \brief The grid construction phases of all ranks as JSON.
+        ///
+        /// Has to be called on all ranks.
+        /// \return The JSON document on rank 0, an empty string on the
+        ///         other ranks.
+        std::string constructionTimingsJson() const;
+
+        /// \brief The bytes held by the grid on this rank, per component.
+        ///
+        /// The components of the global view are prefixed by "global/",
+        /// those of the distributed view, if any, by "distributed/". On
+        /// ranks other than 0 the global view is empty.
+        cpgrid::MemoryUsage memoryUsage() const;
+
         // --- Dune interface below ---
 
         /// \name The DUNE grid interface implementation
@@ -623,6 +675,30 @@ namespace Dune
 
         // loadbalance is not part of the grid interface therefore we skip it.
 
+        /// \brief Set whether load balancing numbers the cells of each rank interior first.
+        ///
+        /// If set before loadBalance(), the owned cells without a face neighbor
+        /// in the overlap are numbered first, then the owned cells with such a
+        /// neighbor, and then the overlap cells. Within each range the cells are
+        /// sorted by global index. This implies ownersFirst. The index sets, the
+        /// partition types and the communication interfaces follow this
+        /// numbering, and interiorFirstCellRanges() returns the ranges.
+        /// \param interior_first if true, number interior first. Default is false.
+        void setInteriorFirstOrdering(bool interior_first)
+        {
+            interior_first_ordering_ = interior_first;
+        }
+
+        /// \brief The ends of the ranges of the cells numbered interior first.
+        ///
+        /// Cells [0, r[0]) are owned cells without face neighbors in the overlap,
+        /// cells [r[0], r[1]) owned cells with such neighbors, and cells
+        /// [r[1], r[2]) overlap cells, where r[2] is size(0). Without load
+        /// balancing, all cells are of the first kind.
+        /// \throw std::logic_error if the grid was load balanced without
+        ///        setInteriorFirstOrdering(true).
+        std::array<int, 3> interiorFirstCellRanges() const;
+
         /// \brief Distributes this grid over the available nodes in a distributed machine
         /// \param overlapLayers The number of layers of cells of the overlap region (default: 1).
         /// \param useZoltan Whether to use Zoltan for partitioning or our simple approach based on
@@ -913,9 +989,90 @@ namespace Dune
         template<class DataHandle>
         void communicate (DataHandle& data, InterfaceType iftype, CommunicationDirection dir) const
         {
-            current_view_data_->communicate(data, iftype, dir);
+            current_view_data_->communicate(data, iftype, dir, communication_options_);
         }
 
+        /// \brief Communicate a block of doubles per cell stored in a vector.
+        ///
+        /// Unlike communicate() with a data handle, no message buffers are
+        /// packed: MPI reads and writes the vector directly through indexed
+        /// datatypes, which are cached per interface and block size.
+        /// \param values The values of cell i are at [i*block_size, (i+1)*block_size).
+        /// \param block_size The number of values per cell.
+        /// \param iftype The interface to use for the communication.
+        /// \param dir The direction of the communication along the interface (forward or backward).
+        void communicate (std::vector<double>& values, int block_size, InterfaceType iftype,
+                          CommunicationDirection dir) const
+        {
+            assert(values.size() == std::size_t(block_size) * current_view_data_->size(0));
+            current_view_data_->communicateCellValues(values.data(), block_size, iftype, dir,
+                                                      communication_options_.statistics);
+        }
+
+        /// \brief Pack and unpack the messages of communicate() with threads.
+        ///
+        /// The interface lists of each neighbor are split into chunks that
+        /// are gathered into, or scattered from, contiguous message buffers
+        /// in parallel. The size, gather, and scatter methods of the data
+        /// handles passed to communicate() must then be thread-safe.
+        /// \param chunk_size The number of entities per chunk. Zero (the
+        ///        default) packs serially with VariableSizeCommunicator.
+        void setThreadedPacking(std::size_t chunk_size)
+        {
+            communication_options_.pack_chunk_size = chunk_size;
+        }
+
+        /// \brief Exchange the messages of communicate() with neighborhood collectives.
+        ///
+        /// On first use, a distributed graph communicator of the neighboring
+        /// ranks of the cells is created. Each exchange is then one
+        /// MPI_Neighbor_alltoallv of the packed messages, preceded by one
+        /// of the sizes if the data handle has variable size. Otherwise
+        /// (the default), the messages are sent point-to-point.
+        void setNeighborCollectives(bool use)
+        {
+            communication_options_.neighbor_collectives = use;
+        }
+
+        /// \brief Count the messages, bytes, neighbors and time of communicate(),
+        ///        scatterData() and gatherData().
+        ///
+        /// The counters are kept per method, interface type and data handle
+        /// type, and summed over the calls until disabled. The times are split
+        /// into waiting for messages and gathering (packing) and scattering
+        /// (unpacking) the data. When disabled (the default) each call only
+        /// checks a pointer.
+        ///
+        /// With DUNE 2.7 or newer, communicate() uses Dune's
+        /// VariableSizeCommunicator for the pairwise messages. That one cannot
+        /// be counted, hence while enabled Opm::VariableSizeCommunicator is
+        /// used instead. It is a copy of an older version of Dune's and sends
+        /// the same messages, but the times are of that copy.
+        void setCommunicationStatistics(bool enable)
+        {
+            communication_options_.statistics = enable ? communication_statistics_.get() : nullptr;
+        }
+
+        /// \brief The communication counters of this rank.
+        const cpgrid::CommunicationStatistics& communicationStatistics() const
+        {
+            return *communication_statistics_;
+        }
+
+        /// \brief Forget the communication counters.
+        void clearCommunicationStatistics()
+        {
+            communication_statistics_->clear();
+        }
+
+        /// \brief Reduce the communication counters over all ranks.
+        ///
+        /// Has to be called on all ranks.
+        /// \return For each method, interface type and data handle type used
+        ///         on any rank the counters of this rank and the minimum,
+        ///         maximum and average over the ranks. The same on all ranks.
+        std::vector<cpgrid::CommunicationReport> communicationReport() const;
+
         /// \brief Get the collective communication object.
         const CollectiveCommunication& comm () const
         {
@@ -1166,6 +1323,15 @@ namespace Dune
         {
             return current_view_data_->geomVector<3>()[cpgrid::EntityRep<3>(vertex, true)].center();
         }
+        /// \brief Get the eight corner vertices of a cell.
+        ///
+        /// The corners are ordered with i running fastest, then j, then k,
+        /// as in the corner-point format.
+        /// \param cell The index identifying the cell.
+        const std::array<int, 8>& cellToPoint(int cell) const
+        {
+            return current_view_data_->cell_to_point_[cell];
+        }
         /// \brief Get the area of a face.
         /// \param cell The index identifying the face.
         double faceArea(int face) const
@@ -1183,7 +1349,7 @@ namespace Dune
         /// \see faceCell
         const Vector& faceNormal(int face) const
         {
-            return current_view_data_->face_normals_.get(face);
+            return current_view_data_->faceNormals().get(face);
         }
         /// \brief Get the volume of the cell.
         /// \param cell The index identifying the cell.
@@ -1393,7 +1559,7 @@ namespace Dune
             if(!distributed_data_)
                 OPM_THROW(std::runtime_error, "Moving Data only allowed with a load balanced grid!");
             distributed_data_->scatterData(handle, data_.get(), distributed_data_.get(), cellScatterGatherInterface(),
-                                           pointScatterGatherInterface());
+                                           pointScatterGatherInterface(), communication_options_.statistics);
 #else
             // Suppress warnings for unused argument.
             (void) handle;
@@ -1412,12 +1578,85 @@ namespace Dune
 #if HAVE_MPI
             if(!distributed_data_)
                 OPM_THROW(std::runtime_error, "Moving Data only allowed with a load balance grid!");
-            distributed_data_->gatherData(handle, data_.get(), distributed_data_.get());
+            distributed_data_->gatherData(handle, data_.get(), distributed_data_.get(),
+                                          communication_options_.statistics);
+#else
+            // Suppress warnings for unused argument.
+            (void) handle;
+#endif
+        }
+
+        ///
+        /// \brief Moves data from the distributed view to the global view of one rank.
+        ///
+        /// Unlike gatherData(handle), which makes the data available in the global
+        /// view of every rank, only rank root receives data and calls the scatter
+        /// method of the data handle. Has to be called on all ranks.
+        /// Only rank 0 holds the global grid, hence it has to be the root.
+        /// \tparam DataHandle The type of the data handle describing the data and responsible for
+        ///         gathering and scattering the data.
+        /// \param handle The data handle describing the data and responsible for
+        ///         gathering and scattering the data.
+        /// \param root The rank receiving the data. Must be 0, otherwise
+        ///        std::logic_error is thrown on all ranks.
+        /// \param max_chunk_size If positive, the ranks stream their data to root in
+        ///        messages of at most this many data items (but at least one entity),
+        ///        which bounds the receive buffers on root. Otherwise all data is
+        ///        received at once.
+        template<class DataHandle>
+        void gatherData(DataHandle& handle, int root, std::size_t max_chunk_size = 0) const
+        {
+#if HAVE_MPI
+            if(!distributed_data_)
+                OPM_THROW(std::runtime_error, "Moving Data only allowed with a load balance grid!");
+            if(root != 0)
+                OPM_THROW(std::logic_error, "Gathering data on rank " << root
+                          << " is not possible, only rank 0 holds the global grid.");
+            distributed_data_->gatherDataOnRoot(handle, data_.get(), distributed_data_.get(),
+                                                root, max_chunk_size, communication_options_.statistics);
 #else
             // Suppress warnings for unused argument.
             (void) handle;
+            (void) root;
+            (void) max_chunk_size;
 #endif
         }
+
+        ///
+        /// \brief Scatters a block of values per cell of the logical Cartesian
+        ///        grid, which one rank reads in chunks, to the cells of all ranks.
+        ///
+        /// Unlike scatterData(), the values need not be assembled in the global
+        /// view first: each chunk read is sent directly to the ranks having cells
+        /// in it, such that the reading rank holds about one chunk of values only.
+        /// Cartesian cells that are inactive, or not present on any rank, are
+        /// read and skipped. Has to be called on all ranks.
+        ///
+        /// Reading a field of doubles from a binary stream might look like
+        /// \code
+        /// std::vector<double> poro;
+        /// grid.scatterCartesianData([&](std::size_t begin, std::size_t end, double* chunk)
+        ///                           { in.read(reinterpret_cast<char*>(chunk),
+        ///                                     (end - begin) * sizeof(double)); },
+        ///                           poro);
+        /// \endcode
+        /// \param read Called on root only, in increasing order, as
+        ///        read(begin, end, chunk) to store the values of the Cartesian
+        ///        cells [begin, end) at chunk[0, (end-begin)*block_size).
+        /// \param values Resized to hold the values of cell i at [i*block_size, (i+1)*block_size).
+        /// \param block_size The number of values per cell.
+        /// \param root The rank reading the values.
+        /// \param max_chunk_size The maximum number of values read at once, but at
+        ///        least one cell. Zero reads all values at once.
+        template<class T, class Reader>
+        void scatterCartesianData(Reader&& read, std::vector<T>& values, int block_size = 1,
+                                  int root = 0, std::size_t max_chunk_size = 1 << 20) const
+        {
+            values.resize(std::size_t(block_size) * current_view_data_->size(0));
+            current_view_data_->scatterCartesianCellValues(read, values.data(), block_size, root,
+                                                           max_chunk_size,
+                                                           communication_options_.statistics);
+        }
 #if HAVE_MPI
 #if DUNE_VERSION_NEWER(DUNE_GRID, 2, 7)
         /// \brief The type of the map describing communication interfaces.
@@ -1581,6 +1820,19 @@ namespace Dune
          * @brief The global id set (also used as local one).
          */
         cpgrid::GlobalIdSet global_id_set_;
+        /**
+         * @brief How communicate() exchanges the data.
+         */
+        cpgrid::CommunicationOptions communication_options_;
+        /**
+         * @brief The counters of communicate(), scatterData() and gatherData().
+         */
+        std::shared_ptr<cpgrid::CommunicationStatistics> communication_statistics_ =
+            std::make_shared<cpgrid::CommunicationStatistics>();
+        /**
+         * @brief Whether scatterGrid() numbers the cells interior first.
+         */
+        bool interior_first_ordering_ = false;
     }; // end Class CpGrid
 
 
@@ -149,16 +149,12 @@ namespace Opm
         if (!poreVolumes.empty() && (inputGrid.getMinpvMode() != MinpvMode::ModeEnum::Inactive)) {
             MinpvProcessor mp(g.dims[0], g.dims[1], g.dims[2]);
             const std::vector<double>& minpvv  = inputGrid.getMinpvVector();
-            const size_t cartGridSize = g.dims[0] * g.dims[1] * g.dims[2];
-            std::vector<double> thickness(cartGridSize);
-            for (size_t i = 0; i < cartGridSize; ++i) {
-                thickness[i] = inputGrid.getCellThickness(i);
-            }
 
             // The legacy code only supports the opmfil option
             bool opmfil = true; //inputGrid.getMinpvMode() == MinpvMode::OpmFIL;
             const double z_tolerance = inputGrid.isPinchActive() ? inputGrid.getPinchThresholdThickness() : 0.0;
-            mp.process(thickness, z_tolerance, poreVolumes, minpvv, actnum, opmfil, zcorn.data());
+            // The cell thickness is computed from ZCORN by the processor.
+            mp.process({}, z_tolerance, poreVolumes, minpvv, actnum, opmfil, zcorn.data());
         }
 
         const double z_tolerance = inputGrid.isPinchActive() ? inputGrid.getPinchThresholdThickness() : 0.0;
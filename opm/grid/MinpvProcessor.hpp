@@ -24,7 +24,16 @@
 #include <opm/grid/utility/ErrorMacros.hpp>
 #include <opm/grid/utility/OpmParserIncludes.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Opm
 {
@@ -35,6 +44,7 @@ namespace Opm
     public:
 
         struct Result {
+            /// Removed cells, in increasing order.
             std::vector<std::size_t> removed_cells;
             std::map<int,int> nnc;
 
@@ -54,7 +64,10 @@ namespace Opm
         /// \param[in]   nz   logical cartesian number of cells in K-direction
         MinpvProcessor(const int nx, const int ny, const int nz);
         /// Change zcorn so that it respects the minpv property.
-        /// \param[in]       thickness thickness of the cell
+        /// The columns of the grid are processed in parallel if OpenMP is enabled.
+        /// \param[in]       thickness thickness of the cell. If empty, the thickness
+        ///                            is computed from zcorn before processing as the
+        ///                            distance between the mean bottom and mean top depth.
         /// \param[in]       z_tolerance cells with thickness below z_tolerance will be bypassed in the minpv process.
         /// \param[in]       pv       pore volumes of all logical cartesian cells
         /// \param[in]       minpvv   minimum pore volume to accept a cell
@@ -74,7 +87,20 @@ namespace Opm
                        const bool mergeMinPVCells,
                        double* zcorn,
                        bool pinchNOGAP = false) const;
+        /// Thickness of a cell, the distance between the mean depths
+        /// of its four bottom and four top corners.
+        double cellThickness(const int i, const int j, const int k, const double* zcorn) const;
     private:
+        void processColumn(const int ii, const int jj,
+                           const double* thickness,
+                           const double z_tolerance,
+                           const std::vector<double>& pv,
+                           const std::vector<double>& minpvv,
+                           const std::vector<int>& actnum,
+                           const bool mergeMinPVCells,
+                           double* zcorn,
+                           const bool pinchNOGAP,
+                           Result& result) const;
         std::array<int,8> cornerIndices(const int i, const int j, const int k) const;
         std::array<double, 8> getCellZcorn(const int i, const int j, const int k, const double* z) const;
         void setCellZcorn(const int i, const int j, const int k, const std::array<double, 8>& cellz, double* z) const;
@@ -121,8 +147,6 @@ namespace Opm
         //    if their thickness is below z_tolerance and nncs will be created in this case.
 
 
-        Result result;
-
         // Check for sane input sizes.
         const size_t log_size = dims_[0] * dims_[1] * dims_[2];
         if (pv.size() != log_size) {
@@ -131,112 +155,184 @@ namespace Opm
         if (!actnum.empty() && actnum.size() != log_size) {
             OPM_THROW(std::runtime_error, "Wrong size of ACTNUM input, must have one element per logical cartesian cell.");
         }
+        if (!thickness.empty() && thickness.size() != log_size) {
+            OPM_THROW(std::runtime_error, "Wrong size of thickness input, must be empty or have one element per logical cartesian cell.");
+        }
 
-        // Main loop.
-        for (int kk = 0; kk < dims_[2]; ++kk) {
-            for (int jj = 0; jj < dims_[1]; ++jj) {
-                for (int ii = 0; ii < dims_[0]; ++ii) {
-                    const int c = ii + dims_[0] * (jj + dims_[1] * kk);
-                    if (pv[c] < minpvv[c] && (actnum.empty() || actnum[c])) {
-                        // Move deeper (higher k) coordinates to lower k coordinates.
-                        // i.e remove the cell
-                        std::array<double, 8> cz = getCellZcorn(ii, jj, kk, zcorn);
-                        for (int count = 0; count < 4; ++count) {
-                            cz[count + 4] = cz[count];
-                        }
-                        setCellZcorn(ii, jj, kk, cz, zcorn);
-
-                        // Find the next cell
-                        int kk_iter = kk + 1;
-                        if (kk_iter == dims_[2]) // we are at the end of the pillar.
-                            continue;
-
-                        int c_below = ii + dims_[0] * (jj + dims_[1] * (kk_iter));
-                        // bypass inactive cells with thickness less then the tolerance
-                        while ( ((actnum.empty() || !actnum[c_below]) && (thickness[c_below] <= z_tolerance))  ){
-                            // move these cell to the posistion of the first cell to make the
-                            // coordinates strictly sorted
-                            setCellZcorn(ii, jj, kk_iter, cz, zcorn);
-                            kk_iter ++;
-                            if (kk_iter == dims_[2])
-                                break;
+        // Each column only modifies its own zcorn values, so the
+        // columns are processed independently, with the results of
+        // each thread collected separately and merged afterwards.
+        const int num_columns = dims_[0] * dims_[1];
+#ifdef _OPENMP
+        std::vector<Result> thread_results(omp_get_max_threads());
+#pragma omp parallel
+#else
+        std::vector<Result> thread_results(1);
+#endif
+        {
+#ifdef _OPENMP
+            Result& local = thread_results[omp_get_thread_num()];
+#else
+            Result& local = thread_results[0];
+#endif
+            std::vector<double> column_thickness(dims_[2]);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+            for (int column = 0; column < num_columns; ++column) {
+                const int ii = column % dims_[0];
+                const int jj = column / dims_[0];
+                for (int kk = 0; kk < dims_[2]; ++kk) {
+                    column_thickness[kk] = thickness.empty()
+                        ? cellThickness(ii, jj, kk, zcorn)
+                        : thickness[ii + dims_[0] * (jj + dims_[1] * kk)];
+                }
+                processColumn(ii, jj, column_thickness.data(), z_tolerance, pv, minpvv, actnum,
+                              mergeMinPVCells, zcorn, pinchNOGAP, local);
+            }
+        }
 
-                            c_below = ii + dims_[0] * (jj + dims_[1] * (kk_iter));
-                        }
+        Result result;
+        std::size_t num_removed = 0;
+        for (const auto& local : thread_results) {
+            num_removed += local.removed_cells.size();
+        }
+        result.removed_cells.reserve(num_removed);
+        for (const auto& local : thread_results) {
+            result.removed_cells.insert(result.removed_cells.end(), local.removed_cells.begin(), local.removed_cells.end());
+            // Both cells of a connection are in the same column, hence the
+            // keys of different threads differ and the merge keeps the
+            // connection the serial order would have kept.
+            result.nnc.insert(local.nnc.begin(), local.nnc.end());
+        }
+        std::sort(result.removed_cells.begin(), result.removed_cells.end());
+        return result;
+    }
 
-                        if (kk_iter == dims_[2]) // we have come to the end of the pillar.
-                            continue;
-
-                        // create nnc if false or merge the cells if true
-                        if (!mergeMinPVCells) {
-
-                            // We are at the top, so no nnc is created.
-                            if (kk == 0)
-                                continue;
-
-                            int c_above = ii + dims_[0] * (jj + dims_[1] * (kk - 1));
-
-                            // Bypass inactive cells with thickness below tolerance and active cells with volume below minpv
-                            auto above_active = actnum.empty() || actnum[c_above];
-                            auto above_inactive = actnum.empty() || !actnum[c_above]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_above]
-                            auto above_thin = thickness[c_above] < z_tolerance;
-                            auto above_small_pv = pv[c_above] < minpvv[c_above];
-                            if ((above_inactive && above_thin) || (above_active && above_small_pv
-                                                                   && (!pinchNOGAP || above_thin) ) ) {
-                                for (int topk = kk - 2; topk > 0; --topk) {
-                                    c_above = ii + dims_[0] * (jj + dims_[1] * (topk));
-                                    above_active = actnum.empty() || actnum[c_above];
-                                    above_inactive = actnum.empty() || !actnum[c_above];
-                                    auto above_significant_pv = pv[c_above] > minpvv[c_above];
-                                    auto above_broad = thickness[c_above] > z_tolerance;
-                                    // \todo if condition seems wrong and should be the negation of above?
-                                    if ( (above_active && (above_significant_pv || (pinchNOGAP && above_broad) ) ) || (above_inactive && above_broad)) {
-                                        break;
-                                    }
-                                }
-                            }
 
-                            // Bypass inactive cells with thickness below tolerance and active cells with volume below minpv
-                            auto below_active = actnum.empty() || actnum[c_below];
-                            auto below_inactive = actnum.empty() || !actnum[c_below]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_below]
-                            auto below_thin = thickness[c_below] < z_tolerance;
-                            auto below_small_pv = pv[c_below] < minpvv[c];
-                            if ((below_inactive && below_thin) || (below_active && below_small_pv
-                                                                   && (!pinchNOGAP || below_thin ) ) ) {
-                                for (int botk = kk_iter + 1; botk <  dims_[2]; ++botk) {
-                                    c_below = ii + dims_[0] * (jj + dims_[1] * (botk));
-                                    below_active = actnum.empty() || actnum[c_below];
-                                    below_inactive = actnum.empty() || !actnum[c_below]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_below]
-                                    auto below_significant_pv = pv[c_below] > minpvv[c_below];
-                                    auto below_broad = thickness[c_above] > z_tolerance;
-                                    // \todo if condition seems wrong and should be the negation of above?
-                                    if ( (below_active && (below_significant_pv || (pinchNOGAP && below_broad) ) ) || (below_inactive && below_broad)) {
-                                        break;
-                                    }
-                                }
-                            }
 
-                            // Add a connection if the cell above and below is active and has porv > minpv
-                            if ((actnum.empty() || (actnum[c_above] && actnum[c_below])) && pv[c_above] > minpvv[c_above] && pv[c_below] > minpvv[c_below]) {
-                                result.add_nnc(c_above, c_below);
+    inline void MinpvProcessor::processColumn(const int ii, const int jj,
+                                              const double* thickness,
+                                              const double z_tolerance,
+                                              const std::vector<double>& pv,
+                                              const std::vector<double>& minpvv,
+                                              const std::vector<int>& actnum,
+                                              const bool mergeMinPVCells,
+                                              double* zcorn,
+                                              const bool pinchNOGAP,
+                                              Result& result) const
+    {
+        // The thickness is given per layer of the column.
+        for (int kk = 0; kk < dims_[2]; ++kk) {
+            const int c = ii + dims_[0] * (jj + dims_[1] * kk);
+            if (pv[c] < minpvv[c] && (actnum.empty() || actnum[c])) {
+                // Move deeper (higher k) coordinates to lower k coordinates.
+                // i.e remove the cell
+                std::array<double, 8> cz = getCellZcorn(ii, jj, kk, zcorn);
+                for (int count = 0; count < 4; ++count) {
+                    cz[count + 4] = cz[count];
+                }
+                setCellZcorn(ii, jj, kk, cz, zcorn);
+
+                // Find the next cell
+                int kk_iter = kk + 1;
+                if (kk_iter == dims_[2]) // we are at the end of the pillar.
+                    continue;
+
+                int c_below = ii + dims_[0] * (jj + dims_[1] * (kk_iter));
+                // bypass inactive cells with thickness less then the tolerance
+                while ( ((actnum.empty() || !actnum[c_below]) && (thickness[kk_iter] <= z_tolerance))  ){
+                    // move these cell to the posistion of the first cell to make the
+                    // coordinates strictly sorted
+                    setCellZcorn(ii, jj, kk_iter, cz, zcorn);
+                    kk_iter ++;
+                    if (kk_iter == dims_[2])
+                        break;
+
+                    c_below = ii + dims_[0] * (jj + dims_[1] * (kk_iter));
+                }
+
+                if (kk_iter == dims_[2]) // we have come to the end of the pillar.
+                    continue;
+
+                // create nnc if false or merge the cells if true
+                if (!mergeMinPVCells) {
+
+                    // We are at the top, so no nnc is created.
+                    if (kk == 0)
+                        continue;
+
+                    int k_above = kk - 1;
+                    int c_above = ii + dims_[0] * (jj + dims_[1] * k_above);
+
+                    // Bypass inactive cells with thickness below tolerance and active cells with volume below minpv
+                    auto above_active = actnum.empty() || actnum[c_above];
+                    auto above_inactive = actnum.empty() || !actnum[c_above]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_above]
+                    auto above_thin = thickness[k_above] < z_tolerance;
+                    auto above_small_pv = pv[c_above] < minpvv[c_above];
+                    if ((above_inactive && above_thin) || (above_active && above_small_pv
+                                                           && (!pinchNOGAP || above_thin) ) ) {
+                        for (int topk = kk - 2; topk > 0; --topk) {
+                            k_above = topk;
+                            c_above = ii + dims_[0] * (jj + dims_[1] * (topk));
+                            above_active = actnum.empty() || actnum[c_above];
+                            above_inactive = actnum.empty() || !actnum[c_above];
+                            auto above_significant_pv = pv[c_above] > minpvv[c_above];
+                            auto above_broad = thickness[k_above] > z_tolerance;
+                            // \todo if condition seems wrong and should be the negation of above?
+                            if ( (above_active && (above_significant_pv || (pinchNOGAP && above_broad) ) ) || (above_inactive && above_broad)) {
+                                break;
                             }
-                        } else {
+                        }
+                    }
 
-                            // Set lower k coordinates of cell below to upper cells's coordinates.
-                            // i.e fill the void using the cell below
-                            std::array<double, 8> cz_below = getCellZcorn(ii, jj, kk_iter, zcorn);
-                            for (int count = 0; count < 4; ++count) {
-                                cz_below[count] = cz[count];
+                    // Bypass inactive cells with thickness below tolerance and active cells with volume below minpv
+                    auto below_active = actnum.empty() || actnum[c_below];
+                    auto below_inactive = actnum.empty() || !actnum[c_below]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_below]
+                    auto below_thin = thickness[kk_iter] < z_tolerance;
+                    auto below_small_pv = pv[c_below] < minpvv[c];
+                    if ((below_inactive && below_thin) || (below_active && below_small_pv
+                                                           && (!pinchNOGAP || below_thin ) ) ) {
+                        for (int botk = kk_iter + 1; botk <  dims_[2]; ++botk) {
+                            c_below = ii + dims_[0] * (jj + dims_[1] * (botk));
+                            below_active = actnum.empty() || actnum[c_below];
+                            below_inactive = actnum.empty() || !actnum[c_below]; // \todo Kept original, but should be !actnum.empty() && !actnum[c_below]
+                            auto below_significant_pv = pv[c_below] > minpvv[c_below];
+                            auto below_broad = thickness[k_above] > z_tolerance;
+                            // \todo if condition seems wrong and should be the negation of above?
+                            if ( (below_active && (below_significant_pv || (pinchNOGAP && below_broad) ) ) || (below_inactive && below_broad)) {
+                                break;
                             }
-                            setCellZcorn(ii, jj, kk_iter, cz_below, zcorn);
                         }
-                        result.removed_cells.push_back(c);
                     }
-                }
 
+                    // Add a connection if the cell above and below is active and has porv > minpv
+                    if ((actnum.empty() || (actnum[c_above] && actnum[c_below])) && pv[c_above] > minpvv[c_above] && pv[c_below] > minpvv[c_below]) {
+                        result.add_nnc(c_above, c_below);
+                    }
+                } else {
+
+                    // Set lower k coordinates of cell below to upper cells's coordinates.
+                    // i.e fill the void using the cell below
+                    std::array<double, 8> cz_below = getCellZcorn(ii, jj, kk_iter, zcorn);
+                    for (int count = 0; count < 4; ++count) {
+                        cz_below[count] = cz[count];
+                    }
+                    setCellZcorn(ii, jj, kk_iter, cz_below, zcorn);
+                }
+                result.removed_cells.push_back(c);
             }
         }
-        return result;
+    }
+
+
+
+    inline double MinpvProcessor::cellThickness(const int i, const int j, const int k, const double* zcorn) const
+    {
+        const std::array<double, 8> cz = getCellZcorn(i, j, k, zcorn);
+        const double top = (cz[0] + cz[1] + cz[2] + cz[3]) / 4.0;
+        const double bottom = (cz[4] + cz[5] + cz[6] + cz[7]) / 4.0;
+        return bottom - top;
     }
 
 
@@ -22,6 +22,8 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -523,7 +525,7 @@ read_grid_cells(FILE *fp, int has_tag, int has_indexmap,
 
 
 struct UnstructuredGrid *
-read_grid(const char *fname)
+read_grid_text_sequential(const char *fname)
 {
     struct UnstructuredGrid *G;
     FILE                    *fp;
@@ -560,3 +562,323 @@ read_grid(const char *fname)
 }
 
 
+/* ---------------------------------------------------------------------- */
+/* Binary grid format.                                                    */
+/*                                                                        */
+/* Layout: GRID_BINARY_MAGIC, then int64 header fields (GRID_BIN_*), then */
+/* the raw arrays in the same order as in the text format:                */
+/*   node_coordinates, face_nodepos, face_nodes, face_cells, face_areas,  */
+/*   face_centroids, face_normals, cell_facepos, cell_faces,              */
+/*   [cell_facetag], [global_cell], cell_volumes, cell_centroids.         */
+/* Integers are stored as int, floating point values as double, both in   */
+/* the byte order of the writing machine (checked through GRID_BIN_BOM).  */
+/* ---------------------------------------------------------------------- */
+
+#define GRID_BINARY_MAGIC      "OPMUGRD1"
+#define GRID_BINARY_MAGIC_SIZE 8
+
+#define GRID_BIN_NHEADER       13
+#define GRID_BIN_BOM           0
+#define GRID_BIN_INTSIZE       1
+#define GRID_BIN_NDIMS         2
+#define GRID_BIN_NCELLS        3
+#define GRID_BIN_NFACES        4
+#define GRID_BIN_NNODES        5
+#define GRID_BIN_NFACENODES    6
+#define GRID_BIN_NCELLFACES    7
+#define GRID_BIN_HAS_TAG       8
+#define GRID_BIN_HAS_INDEXMAP  9
+#define GRID_BIN_CARTDIMS      10 /* Three entries */
+
+#define GRID_BIN_BOM_VALUE     0x0102030405060708LL
+
+
+static int
+write_array(FILE *fp, const void *p, size_t size, size_t n)
+{
+    return (n == 0) || (fwrite(p, size, n, fp) == n);
+}
+
+
+static int
+read_array(FILE *fp, void *p, size_t size, size_t n, const char * const what)
+{
+    int ok = (n == 0) || (fread(p, size, n, fp) == n);
+
+    if (! ok) {
+        input_error(fp, what);
+    }
+
+    return ok;
+}
+
+
+int
+write_grid(const struct UnstructuredGrid *G, const char *fname)
+{
+    FILE      *fp;
+    long long  header[GRID_BIN_NHEADER];
+    size_t     nd, nc, nf, nn, nfn, ncf;
+    int        save_errno, ok;
+
+    save_errno = errno;
+
+    nd  = G->dimensions;
+    nc  = G->number_of_cells;
+    nf  = G->number_of_faces;
+    nn  = G->number_of_nodes;
+    nfn = G->face_nodepos[ nf ];
+    ncf = G->cell_facepos[ nc ];
+
+    header[GRID_BIN_BOM         ] = GRID_BIN_BOM_VALUE;
+    header[GRID_BIN_INTSIZE     ] = sizeof(int);
+    header[GRID_BIN_NDIMS       ] = nd;
+    header[GRID_BIN_NCELLS      ] = nc;
+    header[GRID_BIN_NFACES      ] = nf;
+    header[GRID_BIN_NNODES      ] = nn;
+    header[GRID_BIN_NFACENODES  ] = nfn;
+    header[GRID_BIN_NCELLFACES  ] = ncf;
+    header[GRID_BIN_HAS_TAG     ] = G->cell_facetag != NULL;
+    header[GRID_BIN_HAS_INDEXMAP] = G->global_cell  != NULL;
+    header[GRID_BIN_CARTDIMS + 0] = G->cartdims[0];
+    header[GRID_BIN_CARTDIMS + 1] = G->cartdims[1];
+    header[GRID_BIN_CARTDIMS + 2] = G->cartdims[2];
+
+    fp = fopen(fname, "wb");
+    ok = fp != NULL;
+
+    if (ok) {
+        ok = write_array(fp, GRID_BINARY_MAGIC, 1, GRID_BINARY_MAGIC_SIZE)
+            && write_array(fp, header, sizeof header[0], GRID_BIN_NHEADER)
+            && write_array(fp, G->node_coordinates, sizeof(double), nd * nn)
+            && write_array(fp, G->face_nodepos, sizeof(int), nf + 1)
+            && write_array(fp, G->face_nodes, sizeof(int), nfn)
+            && write_array(fp, G->face_cells, sizeof(int), 2 * nf)
+            && write_array(fp, G->face_areas, sizeof(double), nf)
+            && write_array(fp, G->face_centroids, sizeof(double), nd * nf)
+            && write_array(fp, G->face_normals, sizeof(double), nd * nf)
+            && write_array(fp, G->cell_facepos, sizeof(int), nc + 1)
+            && write_array(fp, G->cell_faces, sizeof(int), ncf);
+
+        if (ok && (G->cell_facetag != NULL)) {
+            ok = write_array(fp, G->cell_facetag, sizeof(int), ncf);
+        }
+        if (ok && (G->global_cell != NULL)) {
+            ok = write_array(fp, G->global_cell, sizeof(int), nc);
+        }
+
+        ok = ok
+            && write_array(fp, G->cell_volumes, sizeof(double), nc)
+            && write_array(fp, G->cell_centroids, sizeof(double), nd * nc);
+
+        ok = (fclose(fp) == 0) && ok;
+    }
+
+    errno = save_errno;
+
+    return ok;
+}
+
+
+static int
+has_binary_magic(FILE *fp)
+{
+    char magic[GRID_BINARY_MAGIC_SIZE];
+
+    return (fread(magic, 1, GRID_BINARY_MAGIC_SIZE, fp) == GRID_BINARY_MAGIC_SIZE)
+        && (memcmp(magic, GRID_BINARY_MAGIC, GRID_BINARY_MAGIC_SIZE) == 0);
+}
+
+
+/* Whether the sizes in a binary grid header are usable: one to three  */
+/* dimensions, entity counts that fit the int indices of the grid, and */
+/* array sizes whose byte counts do not overflow size_t.               */
+static int
+valid_binary_header(const long long *header)
+{
+    static const int counts[] = { GRID_BIN_NCELLS, GRID_BIN_NFACES,
+                                  GRID_BIN_NNODES, GRID_BIN_NFACENODES,
+                                  GRID_BIN_NCELLFACES };
+    long long max_count;
+    size_t    i;
+
+    if ((header[GRID_BIN_NDIMS] < 1) || (header[GRID_BIN_NDIMS] > 3)) {
+        return 0;
+    }
+
+    max_count = 0;
+    for (i = 0; i < sizeof counts / sizeof counts[0]; i++) {
+        /* Position arrays hold count + 1 entries, the last being count. */
+        if ((header[counts[i]] < 0) || (header[counts[i]] >= INT_MAX)) {
+            return 0;
+        }
+        if (header[counts[i]] > max_count) {
+            max_count = header[counts[i]];
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        if ((header[GRID_BIN_CARTDIMS + i] < 0) ||
+            (header[GRID_BIN_CARTDIMS + i] > INT_MAX)) {
+            return 0;
+        }
+    }
+
+    /* The largest arrays hold ndims (at most 3) doubles per entity. */
+    return (unsigned long long) max_count <= (SIZE_MAX / sizeof(double)) / 3;
+}
+
+
+struct UnstructuredGrid *
+read_grid_binary(const char *fname)
+{
+    struct UnstructuredGrid *G;
+    FILE                    *fp;
+
+    long long header[GRID_BIN_NHEADER];
+    size_t    nd, nc, nf, nn, nfn, ncf, i;
+    int       save_errno, ok;
+
+    save_errno = errno;
+
+    G  = NULL;
+    fp = fopen(fname, "rb");
+    if (fp == NULL) {
+        errno = save_errno;
+        return NULL;
+    }
+
+    ok = has_binary_magic(fp)
+        && read_array(fp, header, sizeof header[0], GRID_BIN_NHEADER,
+                      "Unable to read binary grid header");
+
+    if (ok) {
+        ok = (header[GRID_BIN_BOM] == GRID_BIN_BOM_VALUE) &&
+             (header[GRID_BIN_INTSIZE] == (long long) sizeof(int));
+
+        if (! ok) {
+            fprintf(stderr, "Binary grid file '%s' was written "
+                    "on an incompatible platform\n", fname);
+        }
+    }
+
+    if (ok) {
+        ok = valid_binary_header(header);
+
+        if (! ok) {
+            fprintf(stderr, "Binary grid file '%s' has invalid "
+                    "grid sizes\n", fname);
+        }
+    }
+
+    if (ok) {
+        nd  = header[GRID_BIN_NDIMS];
+        nc  = header[GRID_BIN_NCELLS];
+        nf  = header[GRID_BIN_NFACES];
+        nn  = header[GRID_BIN_NNODES];
+        nfn = header[GRID_BIN_NFACENODES];
+        ncf = header[GRID_BIN_NCELLFACES];
+
+        G  = allocate_grid(nd, nc, nf, nfn, ncf, nn);
+        ok = G != NULL;
+
+        if (ok) {
+            if (! header[GRID_BIN_HAS_TAG]) {
+                free(G->cell_facetag);
+                G->cell_facetag = NULL;
+            }
+
+            if (header[GRID_BIN_HAS_INDEXMAP]) {
+                G->global_cell = malloc(nc * sizeof *G->global_cell);
+                ok = G->global_cell != NULL;
+            }
+
+            for (i = 0; i < 3; i++) {
+                G->cartdims[ i ] = (int) header[GRID_BIN_CARTDIMS + i];
+            }
+        }
+
+        ok = ok
+            && read_array(fp, G->node_coordinates, sizeof(double), nd * nn,
+                          "Unable to read node coordinates")
+            && read_array(fp, G->face_nodepos, sizeof(int), nf + 1,
+                          "Unable to read node indirection array")
+            && read_array(fp, G->face_nodes, sizeof(int), nfn,
+                          "Unable to read face-nodes")
+            && read_array(fp, G->face_cells, sizeof(int), 2 * nf,
+                          "Unable to read neighbourship")
+            && read_array(fp, G->face_areas, sizeof(double), nf,
+                          "Unable to read face areas")
+            && read_array(fp, G->face_centroids, sizeof(double), nd * nf,
+                          "Unable to read face centroids")
+            && read_array(fp, G->face_normals, sizeof(double), nd * nf,
+                          "Unable to read face normals")
+            && read_array(fp, G->cell_facepos, sizeof(int), nc + 1,
+                          "Unable to read face indirection array")
+            && read_array(fp, G->cell_faces, sizeof(int), ncf,
+                          "Unable to read cell-faces");
+
+        if (ok && (G->cell_facetag != NULL)) {
+            ok = read_array(fp, G->cell_facetag, sizeof(int), ncf,
+                            "Unable to read cell-face tags");
+        }
+        if (ok && (G->global_cell != NULL)) {
+            ok = read_array(fp, G->global_cell, sizeof(int), nc,
+                            "Unable to read global cellmap");
+        }
+
+        ok = ok
+            && read_array(fp, G->cell_volumes, sizeof(double), nc,
+                          "Unable to read cell volumes")
+            && read_array(fp, G->cell_centroids, sizeof(double), nd * nc,
+                          "Unable to read cell centroids");
+    }
+
+    if (! ok) {
+        destroy_grid(G);
+        G = NULL;
+    }
+
+    fclose(fp);
+
+    errno = save_errno;
+
+    return G;
+}
+
+
+struct UnstructuredGrid *
+read_grid(const char *fname)
+{
+    struct UnstructuredGrid *G;
+    FILE                    *fp;
+
+    int save_errno, is_binary;
+
+    save_errno = errno;
+
+    fp = fopen(fname, "rb");
+    if (fp == NULL) {
+        errno = save_errno;
+        return NULL;
+    }
+    is_binary = has_binary_magic(fp);
+    fclose(fp);
+
+    if (is_binary) {
+        G = read_grid_binary(fname);
+    }
+    else {
+        /* The parallel reader does not diagnose input errors. Re-read
+         * with the sequential reader if it fails, to report them. */
+        G = read_grid_text_parallel(fname);
+
+        if (G == NULL) {
+            G = read_grid_text_sequential(fname);
+        }
+    }
+
+    errno = save_errno;
+
+    return G;
+}
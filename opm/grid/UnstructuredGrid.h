@@ -75,6 +75,9 @@ allocate_grid(size_t ndims     ,
 struct UnstructuredGrid *
 read_grid(const char *fname);
 
+int
+write_grid(const struct UnstructuredGrid *G, const char *fname);
+
  ---- end of synopsis of grid.h ----
 */
 
@@ -310,7 +313,11 @@ attach_zcorn_copy(struct UnstructuredGrid* G ,
 
 
 /**
- * Import a grid from a character representation stored in file.
+ * Import a grid from file.  Binary files written by write_grid() are
+ * recognised by their leading signature and read by read_grid_binary(),
+ * all other files are read as the character representation by
+ * read_grid_text_parallel(), falling back to read_grid_text_sequential()
+ * to report input errors.
  *
  * @param[in] fname File name.
  * @return Fully formed UnstructuredGrid with all fields allocated and filled.
@@ -319,6 +326,54 @@ attach_zcorn_copy(struct UnstructuredGrid* G ,
 struct UnstructuredGrid *
 read_grid(const char *fname);
 
+/**
+ * Import a grid from a character representation stored in file,
+ * reading one value at a time.  Reference implementation of the text
+ * format, prints a diagnostic on input errors.
+ *
+ * @param[in] fname File name.
+ * @return Fully formed UnstructuredGrid with all fields allocated and filled.
+ * Returns @c NULL in case of allocation failure or input error.
+ */
+struct UnstructuredGrid *
+read_grid_text_sequential(const char *fname);
+
+/**
+ * Import a grid from a character representation stored in file.  The
+ * file is read in one operation and tokenized in parallel chunks.  The
+ * result is identical to that of read_grid_text_sequential(), but no
+ * diagnostics are printed.
+ *
+ * @param[in] fname File name.
+ * @return Fully formed UnstructuredGrid with all fields allocated and filled.
+ * Returns @c NULL in case of allocation failure or input error.
+ */
+struct UnstructuredGrid *
+read_grid_text_parallel(const char *fname);
+
+/**
+ * Import a grid from a binary file written by write_grid().  Every
+ * array is read by a single bulk read.
+ *
+ * @param[in] fname File name.
+ * @return Fully formed UnstructuredGrid with all fields allocated and filled.
+ * Returns @c NULL in case of allocation failure, input error, or if the
+ * file was written on a platform with different byte order or int size.
+ */
+struct UnstructuredGrid *
+read_grid_binary(const char *fname);
+
+/**
+ * Export a grid to a binary file readable by read_grid() and
+ * read_grid_binary().  The zcorn cache is not written.
+ *
+ * @param[in] G     Grid.
+ * @param[in] fname File name.
+ * @return Non-zero if successful, zero otherwise.
+ */
+int
+write_grid(const struct UnstructuredGrid *G, const char *fname);
+
 
 
 
@@ -43,6 +43,8 @@
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/cpgrid/CpGridData.hpp>
 #include <opm/grid/common/ZoltanPartition.hpp>
+#include <algorithm>
+#include <numeric>
 #include <stack>
 
 #ifdef HAVE_MPI
@@ -583,6 +585,163 @@ void addOverlapLayer(const CpGrid& grid, int index, const CpGrid::Codim<0>::Enti
 #endif
     }
 
+    std::vector<std::tuple<int,int,char>>
+    computeRemoteCells(const std::vector<std::tuple<int,int,char>>& exportList,
+                       const CollectiveCommunication<Dune::MPIHelper::MPICommunicator>& cc,
+                       int root)
+    {
+        std::vector<std::tuple<int,int,char>> remoteCells;
+#ifdef HAVE_MPI
+        // Triples of global index, other rank, and attribute there.
+        std::vector<int> sendBuffer;
+        std::vector<int> sendCounts(cc.size(), 0);
+        std::vector<int> displacements(cc.size() + 1, 0);
+
+        if (cc.rank() == root)
+        {
+            auto sorted = exportList;
+            std::sort(sorted.begin(), sorted.end());
+
+            // Each cell present on k processes yields k-1 entries on each of them.
+            auto countOrPack = [&sorted](const auto& func)
+            {
+                for (auto begin = sorted.begin(); begin != sorted.end();)
+                {
+                    auto end = begin;
+                    while (end != sorted.end() && std::get<0>(*end) == std::get<0>(*begin))
+                    {
+                        ++end;
+                    }
+                    for (auto entry = begin; entry != end; ++entry)
+                    {
+                        for (auto other = begin; other != end; ++other)
+                        {
+                            if (std::get<1>(*other) != std::get<1>(*entry))
+                            {
+                                func(*entry, *other);
+                            }
+                        }
+                    }
+                    begin = end;
+                }
+            };
+            countOrPack([&sendCounts](const auto& entry, const auto&)
+                        { sendCounts[std::get<1>(entry)] += 3; });
+            std::partial_sum(sendCounts.begin(), sendCounts.end(), displacements.begin() + 1);
+            sendBuffer.resize(displacements.back());
+            auto positions = displacements;
+            countOrPack([&sendBuffer, &positions](const auto& entry, const auto& other)
+                        {
+                            auto& pos = positions[std::get<1>(entry)];
+                            sendBuffer[pos++] = std::get<0>(entry);
+                            sendBuffer[pos++] = std::get<1>(other);
+                            sendBuffer[pos++] = std::get<2>(other);
+                        });
+        }
+
+        int recvCount = 0;
+        MPI_Scatter(sendCounts.data(), 1, MPI_INT, &recvCount, 1, MPI_INT, root, cc);
+        std::vector<int> recvBuffer(recvCount);
+        MPI_Scatterv(sendBuffer.data(), sendCounts.data(), displacements.data(), MPI_INT,
+                     recvBuffer.data(), recvCount, MPI_INT, root, cc);
+
+        remoteCells.reserve(recvCount / 3);
+        for (int i = 0; i < recvCount; i += 3)
+        {
+            remoteCells.emplace_back(recvBuffer[i], recvBuffer[i+1], recvBuffer[i+2]);
+        }
+        // The entries are sorted by global index, hence a stable sort by rank suffices.
+        std::stable_sort(remoteCells.begin(), remoteCells.end(),
+                         [](const std::tuple<int,int,char>& t1, const std::tuple<int,int,char>& t2)
+                         { return std::get<1>(t1) < std::get<1>(t2); });
+#else
+        (void) exportList;
+        (void) cc;
+        (void) root;
+        DUNE_THROW(InvalidStateException, "MPI is missing from the system");
+#endif
+        return remoteCells;
+    }
+
+    std::vector<int>
+    findCellsWithOverlapNeighbors(const CpGrid& grid, const std::vector<int>& cell_part,
+                                  const std::vector<std::tuple<int,int,char>>& exportList,
+                                  const CollectiveCommunication<Dune::MPIHelper::MPICommunicator>& cc,
+                                  int root)
+    {
+        std::vector<int> cells;
+#ifdef HAVE_MPI
+        using AttributeSet = Dune::cpgrid::CpGridData::AttributeSet;
+        std::vector<int> sendBuffer;
+        std::vector<int> sendCounts(cc.size(), 0);
+        std::vector<int> displacements(cc.size() + 1, 0);
+
+        if (cc.rank() == root)
+        {
+            // The pairs of global index and process having the cell in its overlap.
+            std::vector<std::pair<int,int>> overlap;
+            for (const auto& entry: exportList)
+            {
+                if (std::get<2>(entry) != AttributeSet::owner)
+                {
+                    overlap.emplace_back(std::get<0>(entry), std::get<1>(entry));
+                }
+            }
+            std::sort(overlap.begin(), overlap.end());
+
+            // The owner of each cell, if it has a neighbor in the overlap of
+            // the owner, otherwise -1.
+            const CpGrid::LeafIndexSet& ix = grid.leafIndexSet();
+            std::vector<int> found(cell_part.size(), -1);
+            for (CpGrid::Codim<0>::LeafIterator it = grid.leafbegin<0>();
+                 it != grid.leafend<0>(); ++it)
+            {
+                const int index = ix.index(*it);
+                const int owner = cell_part[index];
+                for (CpGrid::LeafIntersectionIterator iit = it->ileafbegin(); iit != it->ileafend(); ++iit)
+                {
+                    if ( iit->neighbor() )
+                    {
+                        const int nb_index = ix.index(*(iit->outside()));
+                        if ( cell_part[nb_index] != owner
+                             && std::binary_search(overlap.begin(), overlap.end(),
+                                                   std::make_pair(nb_index, owner)) )
+                        {
+                            found[index] = owner;
+                            ++sendCounts[owner];
+                            break;
+                        }
+                    }
+                }
+            }
+            std::partial_sum(sendCounts.begin(), sendCounts.end(), displacements.begin() + 1);
+            sendBuffer.resize(displacements.back());
+            auto positions = displacements;
+            for (std::size_t index = 0; index < found.size(); ++index)
+            {
+                if (found[index] >= 0)
+                {
+                    sendBuffer[positions[found[index]]++] = index;
+                }
+            }
+        }
+
+        int recvCount = 0;
+        MPI_Scatter(sendCounts.data(), 1, MPI_INT, &recvCount, 1, MPI_INT, root, cc);
+        cells.resize(recvCount);
+        MPI_Scatterv(sendBuffer.data(), sendCounts.data(), displacements.data(), MPI_INT,
+                     cells.data(), recvCount, MPI_INT, root, cc);
+#else
+        (void) grid;
+        (void) cell_part;
+        (void) exportList;
+        (void) cc;
+        (void) root;
+        DUNE_THROW(InvalidStateException, "MPI is missing from the system");
+#endif
+        return cells;
+    }
+
 namespace cpgrid
 {
 #if HAVE_MPI
@@ -105,6 +105,47 @@ namespace Dune
                         const CollectiveCommunication<Dune::MPIHelper::MPICommunicator>& cc,
                         bool addCornerCells, const double* trans, int layers = 1);
 
+    /// \brief Computes the remote cells of each process from the export list.
+    ///
+    /// The export list on the root process names every process that gets a
+    /// cell, together with the attribute there. Thus the root knows for each
+    /// process which other processes share its cells and sends it that
+    /// information, which saves the processes from rediscovering their
+    /// neighbors when setting up the remote indices.
+    /// \param[in] exportList The export list after adding the overlap layer. Each
+    /// entry is a tuple of global index, process rank (to export to), attribute on
+    /// remote. Only used on the root process.
+    /// \param[in] cc The communication object
+    /// \param[in] root The rank of the process that holds the export list.
+    /// \return The cells of this process that are also present on other processes.
+    /// Each entry is a tuple of global index, rank of the other process, attribute
+    /// there. The entries are sorted by rank and then by global index.
+    std::vector<std::tuple<int,int,char>>
+    computeRemoteCells(const std::vector<std::tuple<int,int,char>>& exportList,
+                       const CollectiveCommunication<Dune::MPIHelper::MPICommunicator>& cc,
+                       int root = 0);
+
+    /// \brief Finds the owned cells of each process that have a face neighbor
+    ///        in the overlap of that process.
+    ///
+    /// The root process, which holds the global grid and the export list,
+    /// checks the face neighbors of each cell and sends each process the
+    /// cells it found.
+    /// \param[in] grid The grid. Only used on the root process.
+    /// \param[in] cell_part The process owning each cell. Only used on the root process.
+    /// \param[in] exportList The export list after adding the overlap layer. Each
+    /// entry is a tuple of global index, process rank (to export to), attribute on
+    /// remote. Only used on the root process.
+    /// \param[in] cc The communication object
+    /// \param[in] root The rank of the process that holds the export list.
+    /// \return The global indices of the owned cells of this process that have a
+    /// face neighbor in its overlap, sorted.
+    std::vector<int>
+    findCellsWithOverlapNeighbors(const CpGrid& grid, const std::vector<int>& cell_part,
+                                  const std::vector<std::tuple<int,int,char>>& exportList,
+                                  const CollectiveCommunication<Dune::MPIHelper::MPICommunicator>& cc,
+                                  int root = 0);
+
 namespace cpgrid
 {
 #if HAVE_MPI
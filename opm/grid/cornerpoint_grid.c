@@ -13,6 +13,7 @@
 
 #include "config.h"
 #include <assert.h>
+#include <limits.h>
 #include <stdlib.h>
 
 #include <opm/grid/cornerpoint_grid.h>
@@ -160,6 +161,111 @@ void compute_geometry(struct UnstructuredGrid *g)
 }
 
 
+void compute_geometry_incremental(struct UnstructuredGrid *g,
+                                  int nmoved, const int *moved_nodes)
+{
+    char  *node_moved, *cell_dirty;
+    int   *faces, *cells;
+    int    i, f, c, k, nf, nc;
+
+    assert (g != NULL);
+
+    node_moved = calloc(g->number_of_nodes, sizeof *node_moved);
+    cell_dirty = calloc(g->number_of_cells, sizeof *cell_dirty);
+    faces      = malloc(g->number_of_faces * sizeof *faces);
+    cells      = malloc(g->number_of_cells * sizeof *cells);
+
+    if ((node_moved == NULL) || (cell_dirty == NULL) ||
+        (faces      == NULL) || (cells      == NULL)) {
+        /* Out of memory for bookkeeping: recompute everything. */
+        compute_geometry(g);
+    }
+    else {
+        for (i = 0; i < nmoved; i++) {
+            assert ((moved_nodes[i] >= 0) &&
+                    (moved_nodes[i] < g->number_of_nodes));
+            node_moved[moved_nodes[i]] = 1;
+        }
+
+        /* Faces with at least one moved node, and their cells. */
+        nf = 0;
+        for (f = 0; f < g->number_of_faces; f++) {
+            for (k = g->face_nodepos[f]; k < g->face_nodepos[f + 1]; k++) {
+                if (node_moved[g->face_nodes[k]]) {
+                    faces[nf++] = f;
+
+                    c = g->face_cells[2*f + 0];
+                    if (c >= 0) { cell_dirty[c] = 1; }
+
+                    c = g->face_cells[2*f + 1];
+                    if (c >= 0) { cell_dirty[c] = 1; }
+
+                    break;
+                }
+            }
+        }
+
+        nc = 0;
+        for (c = 0; c < g->number_of_cells; c++) {
+            if (cell_dirty[c]) { cells[nc++] = c; }
+        }
+
+        compute_face_geometry_subset(g->dimensions, g->node_coordinates,
+                                     nf, faces, g->face_nodepos,
+                                     g->face_nodes, g->face_normals,
+                                     g->face_centroids, g->face_areas);
+
+        compute_cell_geometry_subset(g->dimensions, g->node_coordinates,
+                                     g->face_nodepos, g->face_nodes,
+                                     g->face_cells, g->face_normals,
+                                     g->face_centroids, nc, cells,
+                                     g->cell_facepos, g->cell_faces,
+                                     g->cell_centroids, g->cell_volumes);
+    }
+
+    free(cells);
+    free(faces);
+    free(cell_dirty);
+    free(node_moved);
+}
+
+
+/*
+ * Hand over the face-to-node offsets of 'pg' to an int array as used
+ * by struct UnstructuredGrid.  With 64-bit offsets in the processed
+ * grid this requires a (checked) copy, otherwise the array is merely
+ * passed on.  Returns NULL if the offsets do not fit.
+ */
+static int *
+convey_face_ptr(struct processed_grid *pg)
+{
+#if OPM_GRID_64BIT_INDICES
+    int f, nf, *pos;
+
+    nf = pg->number_of_faces;
+
+    if (pg->face_ptr[nf] > INT_MAX) {
+        return NULL;
+    }
+
+    pos = malloc((nf + 1) * sizeof *pos);
+    if (pos != NULL) {
+        for (f = 0; f <= nf; f++) {
+            pos[f] = (int) pg->face_ptr[f];
+        }
+    }
+
+    return pos;
+#else
+    int *pos = pg->face_ptr;
+
+    pg->face_ptr = NULL;
+
+    return pos;
+#endif
+}
+
+
 struct UnstructuredGrid *
 create_grid_cornerpoint(const struct grdecl *in, double tol)
 {
@@ -191,7 +297,7 @@ create_grid_cornerpoint(const struct grdecl *in, double tol)
    g->node_coordinates = pg.node_coordinates;
 
    g->face_nodes       = pg.face_nodes;
-   g->face_nodepos     = pg.face_ptr;
+   g->face_nodepos     = convey_face_ptr(&pg);
    g->face_cells       = pg.face_neighbors;
 
    /* Explicitly relinquish resource references conveyed to 'g'.  This
@@ -199,12 +305,12 @@ create_grid_cornerpoint(const struct grdecl *in, double tol)
     * free_processed_grid() call. */
    pg.node_coordinates = NULL;
    pg.face_nodes       = NULL;
-   pg.face_ptr         = NULL;
    pg.face_neighbors   = NULL;
 
    /* allocate and fill g->cell_faces/g->cell_facepos and
     * g->cell_facetag as well as the geometry-related fields. */
-   ok =       fill_cell_topology(&pg, g);
+   ok =       g->face_nodepos != NULL;
+   ok = ok && fill_cell_topology(&pg, g);
    ok = ok && allocate_geometry(g);
 
    if (!ok)
@@ -92,10 +92,31 @@ extern "C" {
      *
      * These fields must be allocated prior to calling compute_geometry().
      *
+     * Faces and cells are processed in parallel if OpenMP is enabled, with
+     * unrolled code paths for quadrilateral faces and hexahedral cells.
+     *
      * @param[in,out] g Grid structure.
      */
     void compute_geometry(struct UnstructuredGrid *g);
 
+
+    /**
+     * Update derived geometric primitives after some nodes have moved.
+     *
+     * Recomputes the quantities listed for compute_geometry(), but only
+     * for faces having at least one moved node and for cells adjacent to
+     * those faces.  The result is identical to that of calling
+     * compute_geometry() on the deformed grid, provided the geometry was
+     * up to date before the nodes moved.
+     *
+     * @param[in,out] g           Grid structure with updated
+     *                            <CODE>g->node_coordinates</CODE>.
+     * @param[in]     nmoved      Number of moved nodes.
+     * @param[in]     moved_nodes Indices of the moved nodes.
+     */
+    void compute_geometry_incremental(struct UnstructuredGrid *g,
+                                      int nmoved, const int *moved_nodes);
+
 #ifdef __cplusplus
 }
 #endif
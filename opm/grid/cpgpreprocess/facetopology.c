@@ -218,7 +218,7 @@ void findconnections(int n, int *pts[4],
     int *itop    = work;
     int *ibottom = work + n;
     int *f       = out->face_nodes + out->face_ptr[out->number_of_faces];
-    int *c       = out->face_neighbors + 2*out->number_of_faces;
+    int *c       = out->face_neighbors + 2*(size_t)out->number_of_faces;
 
     int k1  = 0;
     int k2  = 0;
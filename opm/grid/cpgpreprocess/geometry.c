@@ -28,94 +28,96 @@ norm(const double w[3])
 
 
 /* ------------------------------------------------------------------ */
-static void
-compute_face_geometry_3d(double *coords, int nfaces,
-                         int *nodepos, int *facenodes, double *fnormals,
-                         double *fcentroids, double *fareas)
+static inline void
+face_geometry_3d(const double *coords, const int *fnodes,
+                 const int num_face_nodes, double *fnormal,
+                 double *fcentroid, double *farea)
 /* ------------------------------------------------------------------ */
 {
-
-   /* Assume 3D for now */
+   /* Geometry of a single face with nodes fnodes[0 .. num_face_nodes-1].
+    * Inlined with a constant num_face_nodes for the quadrilateral fast
+    * path, giving a fully unrolled version of the same computation. */
    const int ndims = 3;
-   int f;
-   double x[3];
+   double x[3] = {0};
    double u[3];
    double v[3];
    double w[3];
-
-   int i,k;
-   int node;
-
-   double cface[3]  = {0};
-   double n[3]  = {0};
+   double cface[3] = {0};
+   double n[3] = {0};
    double twothirds = 0.666666666666666666666666666667;
-   double a;
-   int    num_face_nodes;
-   double area;
-   /*#pragma omp parallel for  */
-
-   /*#pragma omp parallel for shared(fnormals,fcentroids,fareas)*/
-#pragma omp parallel for 			   \
-    private(f,x,u,v,w,i,k,node,cface,n,a,num_face_nodes,area)		\
-    shared(fnormals,fcentroids,fareas  \
-	   ,coords, nfaces, nodepos, facenodes, twothirds)
-   for (f=0; f<nfaces; ++f)
+   double a, area;
+   int i, k, node;
+
+   /* average node */
+   for(k=0; k<num_face_nodes; ++k)
    {
-      for(i=0; i<ndims; ++i) x[i] = 0.0;
-      for(i=0; i<ndims; ++i) n[i] = 0.0;
-      for(i=0; i<ndims; ++i) cface[i] = 0.0;
+      node = fnodes[k];
+      for (i=0; i<ndims; ++i) x[i] += coords[3*node+i];
+   }
+   for(i=0; i<ndims; ++i) x[i] /= num_face_nodes;
 
-      /* average node */
-      for(k=nodepos[f]; k<nodepos[f+1]; ++k)
-      {
-         node = facenodes[k];
-         for (i=0; i<ndims; ++i) x[i] += coords[3*node+i];
-      }
-      num_face_nodes = nodepos[f+1] - nodepos[f];
-      for(i=0; i<ndims; ++i) x[i] /= num_face_nodes;
+   /* compute first vector u (to the last node in the face) */
+   node = fnodes[num_face_nodes-1];
+   for(i=0; i<ndims; ++i) u[i] = coords[3*node+i] - x[i];
 
+   area=0.0;
+   /* Compute triangular contrib. to face normal and face centroid*/
+   for(k=0; k<num_face_nodes; ++k)
+   {
+      node = fnodes[k];
+      for (i=0; i<ndims; ++i) v[i] = coords[3*node+i] - x[i];
 
+      cross(u,v,w);
+      a = 0.5*norm(w);
+      area += a;
 
-      /* compute first vector u (to the last node in the face) */
-      node = facenodes[nodepos[f+1]-1];
-      for(i=0; i<ndims; ++i) u[i] = coords[3*node+i] - x[i];
+      /* face normal */
+      for (i=0; i<ndims; ++i) n[i] += w[i];
 
-      area=0.0;
-      /* Compute triangular contrib. to face normal and face centroid*/
-      for(k=nodepos[f]; k<nodepos[f+1]; ++k)
-      {
+      /* face centroid */
+      for (i=0; i<ndims; ++i)
+         cface[i] += a*(x[i]+twothirds*0.5*(u[i]+v[i]));
 
+      /* Store v in u for next iteration */
+      for (i=0; i<ndims; ++i) u[i] = v[i];
+   }
 
-         node = facenodes[k];
-         for (i=0; i<ndims; ++i) v[i] = coords[3*node+i] - x[i];
+   /* Store face normal and face centroid */
+   for (i=0; i<ndims; ++i)
+   {
+      /* normal is scaled with face area */
+      fnormal  [i] = 0.5*n[i];
+      fcentroid[i] = cface[i]/area;
+   }
+   *farea = area;
+}
 
-         cross(u,v,w);
-         a = 0.5*norm(w);
-         area += a;
-	 /*         if(!(a>0))
-         {
-            fprintf(stderr, "Internal error in compute_face_geometry.");
-         }
-	 */
-         /* face normal */
-         for (i=0; i<ndims; ++i) n[i] += w[i];
+/* ------------------------------------------------------------------ */
+static void
+compute_face_geometry_3d(double *coords, int nfaces, const int *faces,
+                         int *nodepos, int *facenodes, double *fnormals,
+                         double *fcentroids, double *fareas)
+/* ------------------------------------------------------------------ */
+{
+   int j, f, num_face_nodes;
 
-         /* face centroid */
-         for (i=0; i<ndims; ++i)
-            cface[i] += a*(x[i]+twothirds*0.5*(u[i]+v[i]));
+#pragma omp parallel for private(j, f, num_face_nodes) schedule(static)
+   for (j=0; j<nfaces; ++j)
+   {
+      f = (faces != NULL) ? faces[j] : j;
+      num_face_nodes = nodepos[f+1] - nodepos[f];
 
-         /* Store v in u for next iteration */
-         for (i=0; i<ndims; ++i) u[i] = v[i];
+      if (num_face_nodes == 4)
+      {
+         /* Quadrilateral fast path */
+         face_geometry_3d(coords, facenodes + nodepos[f], 4,
+                          fnormals + 3*f, fcentroids + 3*f, fareas + f);
       }
-
-      /* Store face normal and face centroid */
-      for (i=0; i<ndims; ++i)
+      else
       {
-         /* normal is scaled with face area */
-         fnormals  [3*f+i] = 0.5*n[i];
-         fcentroids[3*f+i] = cface[i]/area;
+         face_geometry_3d(coords, facenodes + nodepos[f], num_face_nodes,
+                          fnormals + 3*f, fcentroids + 3*f, fareas + f);
       }
-      fareas[f] = area;
    }
 }
 
@@ -124,6 +126,7 @@ static void
 compute_edge_geometry_2d(
       /* in  */ double *node_coords,
       /* in  */ int     num_edges,
+      /* in  */ const int *edges,
       /* in  */ int    *edge_node_pos,
       /* in  */ int    *edge_nodes,
       /* out */ double *edge_normals,
@@ -140,6 +143,7 @@ compute_edge_geometry_2d(
    const int x_ofs = 0;
    const int y_ofs = 1;
 
+   int edge_ndx;                 /* index in edges   */
    int edge;                     /* edge index       */
    int a_nod, b_nod;             /* node indices     */
    double a_x, a_y, b_x, b_y;    /* node coordinates */
@@ -149,8 +153,11 @@ compute_edge_geometry_2d(
     * compute properties for that face. hopefully the host has enough
     * cache pages to keep both input and output at the same time, and
     * registers for all the local variables */
-   for (edge = 0; edge < num_edges; ++edge)
+#pragma omp parallel for private(edge_ndx, edge, a_nod, b_nod, a_x, a_y, b_x, b_y, v_x, v_y)
+   for (edge_ndx = 0; edge_ndx < num_edges; ++edge_ndx)
    {
+      edge = (edges != NULL) ? edges[edge_ndx] : edge_ndx;
+
       /* an edge in 2D can only have starting and ending point
        * check that there are exactly two nodes till the next edge */
       assert (edge_node_pos[edge + 1] - edge_node_pos[edge] == num_dims);
@@ -187,20 +194,21 @@ compute_edge_geometry_2d(
 
 /* ------------------------------------------------------------------ */
 void
-compute_face_geometry(int ndims, double *coords, int nfaces,
-                      int *nodepos, int *facenodes, double *fnormals,
-                      double *fcentroids, double *fareas)
+compute_face_geometry_subset(int ndims, double *coords,
+                             int nsubset, const int *faces,
+                             int *nodepos, int *facenodes, double *fnormals,
+                             double *fcentroids, double *fareas)
 /* ------------------------------------------------------------------ */
 {
    if (ndims == 3)
    {
-      compute_face_geometry_3d(coords, nfaces, nodepos, facenodes,
+      compute_face_geometry_3d(coords, nsubset, faces, nodepos, facenodes,
                                fnormals, fcentroids, fareas);
    }
    else if (ndims == 2)
    {
       /* two-dimensional interfaces are called 'edges' */
-      compute_edge_geometry_2d(coords, nfaces, nodepos, facenodes,
+      compute_edge_geometry_2d(coords, nsubset, faces, nodepos, facenodes,
                                fnormals, fcentroids, fareas);
    }
    else
@@ -209,132 +217,176 @@ compute_face_geometry(int ndims, double *coords, int nfaces,
    }
 }
 
+/* ------------------------------------------------------------------ */
+void
+compute_face_geometry(int ndims, double *coords, int nfaces,
+                      int *nodepos, int *facenodes, double *fnormals,
+                      double *fcentroids, double *fareas)
+/* ------------------------------------------------------------------ */
+{
+   compute_face_geometry_subset(ndims, coords, nfaces, NULL,
+                                nodepos, facenodes, fnormals,
+                                fcentroids, fareas);
+}
+
 
 /* ------------------------------------------------------------------ */
-static void
-compute_cell_geometry_3d(double *coords,
-                         int *nodepos, int *facenodes, int *neighbors,
-                         double *fnormals,
-                         double *fcentroids,
-                         int ncells, int *facepos, int *cellfaces,
-                         double *ccentroids, double *cvolumes)
+static inline void
+cell_geometry_3d(const double *coords, const int c,
+                 const int *nodepos, const int *facenodes,
+                 const int *neighbors, const double *fnormals,
+                 const double *fcentroids,
+                 const int *cfaces, const int num_faces,
+                 const int fixed_face_nodes,
+                 double *ccentroid, double *cvolume)
 /* ------------------------------------------------------------------ */
 {
+   /* Geometry of a single cell with faces cfaces[0 .. num_faces-1].  If
+    * fixed_face_nodes is non-zero, all faces have that many nodes.
+    * Inlined with constant arguments for the hexahedral fast path. */
    const int ndims = 3;
-   int i,k, f,c;
-   int face,node;
+   int i,k,f;
+   int face,node,num_face_nodes;
+   const int *fnodes;
    double x[3];
    double u[3];
    double v[3];
    double w[3];
-   double xcell[3];
-   double ccell[3];
-   double cface[3]  = {0};
-   int num_faces;
+   double xcell[3] = {0};
+   double ccell[3] = {0};
+   double cface[3];
    double volume;
    double tet_volume, subnormal_sign;
    double twothirds = 0.666666666666666666666666666667;
-#pragma omp parallel for     \
-    private(i,k,f,c,face,node,x,u,v,w,xcell				\
-	    ,ccell ,cface,num_faces,volume, tet_volume, subnormal_sign) \
-   shared(coords,nodepos,facenodes,neighbors,twothirds,		\
-	  fnormals,fcentroids,facepos,cellfaces,ccentroids,cvolumes) \
-    firstprivate(ncells)
-   for (c=0; c<ncells; ++c)
-   {
 
+   /*
+    * Approximate cell center as average of face centroids
+    */
+   for(f=0; f<num_faces; ++f)
+   {
+      face = cfaces[f];
+      for (i=0; i<ndims; ++i) xcell[i] += fcentroids[3*face+i];
+   }
+   for(i=0; i<ndims; ++i) xcell[i] /= num_faces;
+
+   /*
+    * For all faces, add tetrahedron's volume and centroid to
+    * 'cvolume' and 'ccentroid'.
+    */
+   volume=0.0;
+   for(f=0; f<num_faces; ++f)
+   {
+      for(i=0; i<ndims; ++i) x[i] = 0.0;
 
-      for(i=0; i<ndims; ++i) xcell[i] = 0.0;
-      for(i=0; i<ndims; ++i) ccell[i] = 0.0;
-
+      face = cfaces[f];
+      fnodes = facenodes + nodepos[face];
+      num_face_nodes = fixed_face_nodes ? fixed_face_nodes
+                                        : nodepos[face+1] - nodepos[face];
 
-      /*
-       * Approximate cell center as average of face centroids
-       */
-      for(f=facepos[c]; f<facepos[c+1]; ++f)
+      /* average face node x */
+      for(k=0; k<num_face_nodes; ++k)
       {
-         face = cellfaces[f];
-         for (i=0; i<ndims; ++i) xcell[i] += fcentroids[3*face+i];
+         node = fnodes[k];
+         for (i=0; i<ndims; ++i) x[i] += coords[3*node+i];
       }
-      num_faces = facepos[c+1] - facepos[c];
-
-      for(i=0; i<ndims; ++i) xcell[i] /= num_faces;
-
+      for(i=0; i<ndims; ++i) x[i] /= num_face_nodes;
 
+      /* compute first vector u (to the last node in the face) */
+      node = fnodes[num_face_nodes-1];
+      for(i=0; i<ndims; ++i) u[i] = coords[3*node+i] - x[i];
 
-      /*
-       * For all faces, add tetrahedron's volume and centroid to
-       * 'cvolume' and 'ccentroid'.
-       */
-      volume=0.0;
-      for(f=facepos[c]; f<facepos[c+1]; ++f)
+      /* Compute triangular contributions to face normal and face centroid */
+      for(k=0; k<num_face_nodes; ++k)
       {
-         int num_face_nodes;
-
-         for(i=0; i<ndims; ++i) x[i] = 0.0;
-         for(i=0; i<ndims; ++i) cface[i] = 0.0;
+         node = fnodes[k];
+         for (i=0; i<ndims; ++i) v[i] = coords[3*node+i] - x[i];
 
-         face = cellfaces[f];
+         cross(u,v,w);
 
-         /* average face node x */
-         for(k=nodepos[face]; k<nodepos[face+1]; ++k)
-         {
-            node = facenodes[k];
-            for (i=0; i<ndims; ++i) x[i] += coords[3*node+i];
+         tet_volume = 0.0;
+         for(i=0; i<ndims; ++i){
+            tet_volume += w[i]*(x[i]-xcell[i]);
          }
-         num_face_nodes = nodepos[face+1] - nodepos[face];
-         for(i=0; i<ndims; ++i) x[i] /= num_face_nodes;
-
+         tet_volume *= 0.5 / 3;
 
+         subnormal_sign=0.0;
+         for(i=0; i<ndims; ++i){
+            subnormal_sign += w[i]*fnormals[3*face+i];
+         }
 
-         /* compute first vector u (to the last node in the face) */
-         node = facenodes[nodepos[face+1]-1];
-         for(i=0; i<ndims; ++i) u[i] = coords[3*node+i] - x[i];
-
-
-         /* Compute triangular contributions to face normal and face centroid */
-         for(k=nodepos[face]; k<nodepos[face+1]; ++k)
-         {
-
-            node = facenodes[k];
-            for (i=0; i<ndims; ++i) v[i] = coords[3*node+i] - x[i];
+         if(subnormal_sign < 0.0){
+            tet_volume = -tet_volume;
+         }
+         if(!(neighbors[2*face+0]==c)){
+            tet_volume = -tet_volume;
+         }
+         volume += tet_volume;
+         /* face centroid of triangle  */
+         for (i=0; i<ndims; ++i) cface[i] = (x[i]+(twothirds)*0.5*(u[i]+v[i]));
 
-            cross(u,v,w);
+         /* Cell centroid */
+         for (i=0; i<ndims; ++i) ccell[i] += tet_volume * 3./4.0*(cface[i] - xcell[i]);
 
+         /* Store v in u for next iteration */
+         for (i=0; i<ndims; ++i) u[i] = v[i];
+      }
+   }
+   for (i=0; i<ndims; ++i) ccentroid[i] = xcell[i] + ccell[i]/volume;
+   *cvolume = volume;
+}
 
+/* ------------------------------------------------------------------ */
+static int
+is_hexahedron(const int *nodepos, const int *cfaces, const int num_faces)
+/* ------------------------------------------------------------------ */
+{
+   int f, face;
 
-            tet_volume = 0.0;
-            for(i=0; i<ndims; ++i){
-		tet_volume += w[i]*(x[i]-xcell[i]);
-	    }
-            tet_volume *= 0.5 / 3;
+   if (num_faces != 6) { return 0; }
 
-	    subnormal_sign=0.0;
-	    for(i=0; i<ndims; ++i){
-		subnormal_sign += w[i]*fnormals[3*face+i];
-	    }
+   for (f = 0; f < num_faces; ++f)
+   {
+      face = cfaces[f];
+      if (nodepos[face+1] - nodepos[face] != 4) { return 0; }
+   }
 
-	    if(subnormal_sign < 0.0){
-		tet_volume = -tet_volume;
-	    }
-	    if(!(neighbors[2*face+0]==c)){
-		tet_volume = -tet_volume;
-	    }
-	    volume += tet_volume;
-            /* face centroid of triangle  */
-            for (i=0; i<ndims; ++i) cface[i] = (x[i]+(twothirds)*0.5*(u[i]+v[i]));
+   return 1;
+}
 
-            /* Cell centroid */
-            //printf("tet_vol %f, cface %f, xcel %f \n", tet_volume, cface[i], xcell[i]);
-            for (i=0; i<ndims; ++i) ccell[i] += tet_volume * 3./4.0*(cface[i] - xcell[i]);
+/* ------------------------------------------------------------------ */
+static void
+compute_cell_geometry_3d(double *coords,
+                         int *nodepos, int *facenodes, int *neighbors,
+                         double *fnormals,
+                         double *fcentroids,
+                         int ncells, const int *cells,
+                         int *facepos, int *cellfaces,
+                         double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   int j, c, num_faces;
+   const int *cfaces;
 
+#pragma omp parallel for private(j, c, num_faces, cfaces) schedule(static)
+   for (j=0; j<ncells; ++j)
+   {
+      c = (cells != NULL) ? cells[j] : j;
+      cfaces = cellfaces + facepos[c];
+      num_faces = facepos[c+1] - facepos[c];
 
-            /* Store v in u for next iteration */
-            for (i=0; i<ndims; ++i) u[i] = v[i];
-         }
+      if (is_hexahedron(nodepos, cfaces, num_faces))
+      {
+         /* Hexahedral fast path */
+         cell_geometry_3d(coords, c, nodepos, facenodes, neighbors,
+                          fnormals, fcentroids, cfaces, 6, 4,
+                          ccentroids + 3*c, cvolumes + c);
+      }
+      else
+      {
+         cell_geometry_3d(coords, c, nodepos, facenodes, neighbors,
+                          fnormals, fcentroids, cfaces, num_faces, 0,
+                          ccentroids + 3*c, cvolumes + c);
       }
-      for (i=0; i<ndims; ++i) ccentroids[3*c+i] = xcell[i] + ccell[i]/volume;
-      cvolumes[c] = volume;
    }
 }
 
@@ -346,6 +398,7 @@ compute_cell_geometry_2d(
       /* in  */ int    *edge_nodes,
       /* in  */ double *edge_midpoints,
       /* in  */ int     num_cells,
+      /* in  */ const int *cells,
       /* in  */ int    *cell_edge_pos,
       /* in  */ int    *cell_edges,
       /* out */ double *cell_centers,
@@ -361,6 +414,7 @@ compute_cell_geometry_2d(
    const int x_ofs = 0;
    const int y_ofs = 1;
 
+   int cell_ndx;        /* index in cells */
    int cell;            /* cell index */
    int num_nodes;       /* number of vertices in current cell */
    int edge_ndx;        /* relative edge index within cell */
@@ -372,8 +426,13 @@ compute_cell_geometry_2d(
    double a_x, a_y,
           b_x, b_y;     /* vectors from center to edge points */
 
-   for (cell = 0; cell < num_cells; ++cell)
+#pragma omp parallel for private(cell_ndx, cell, num_nodes, edge_ndx, edge, \
+                                 center_x, center_y, area, a_nod, b_nod,  \
+                                 a_x, a_y, b_x, b_y)
+   for (cell_ndx = 0; cell_ndx < num_cells; ++cell_ndx)
    {
+      cell = (cells != NULL) ? cells[cell_ndx] : cell_ndx;
+
       /* since the cell is a closed polygon, each point serves as the starting
        * point of one edge and the ending point of another; thus there is as
        * many vertices as there are edges */
@@ -434,28 +493,46 @@ compute_cell_geometry_2d(
 
 /* ------------------------------------------------------------------ */
 void
-compute_cell_geometry(int ndims, double *coords,
-                      int *nodepos, int *facenodes, int *neighbors,
-                      double *fnormals,
-                      double *fcentroids,
-                      int ncells, int *facepos, int *cellfaces,
-                      double *ccentroids, double *cvolumes)
+compute_cell_geometry_subset(int ndims, double *coords,
+                             int *nodepos, int *facenodes, int *neighbors,
+                             double *fnormals,
+                             double *fcentroids,
+                             int nsubset, const int *cells,
+                             int *facepos, int *cellfaces,
+                             double *ccentroids, double *cvolumes)
 /* ------------------------------------------------------------------ */
 {
    if (ndims == 3)
    {
       compute_cell_geometry_3d(coords, nodepos, facenodes,
-                               neighbors, fnormals, fcentroids, ncells,
+                               neighbors, fnormals, fcentroids,
+                               nsubset, cells,
                                facepos, cellfaces, ccentroids, cvolumes);
    }
    else if (ndims == 2)
    {
       compute_cell_geometry_2d(coords, nodepos, facenodes, fcentroids,
-                               ncells, facepos, cellfaces, ccentroids,
-                               cvolumes);
+                               nsubset, cells, facepos, cellfaces,
+                               ccentroids, cvolumes);
    }
    else
    {
       assert(0);
    }
 }
+
+/* ------------------------------------------------------------------ */
+void
+compute_cell_geometry(int ndims, double *coords,
+                      int *nodepos, int *facenodes, int *neighbors,
+                      double *fnormals,
+                      double *fcentroids,
+                      int ncells, int *facepos, int *cellfaces,
+                      double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   compute_cell_geometry_subset(ndims, coords, nodepos, facenodes,
+                                neighbors, fnormals, fcentroids,
+                                ncells, NULL, facepos, cellfaces,
+                                ccentroids, cvolumes);
+}
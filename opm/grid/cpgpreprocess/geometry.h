@@ -16,4 +16,20 @@ void compute_cell_geometry(int ndims, double *coords,
                            int *facepos, int *cellfaces,
                            double *ccentroids, double *cvolumes);
 
+/* As above, but only for the faces (cells) listed in faces (cells), or
+ * for all nsubset first faces (cells) if the list is NULL.  Cells must
+ * be listed only after the geometry of all their faces is up to date. */
+void compute_face_geometry_subset(int ndims, double *coords,
+                                  int nsubset, const int *faces,
+                                  int *nodepos, int *facenodes,
+                                  double *fnormals, double *fcentroids,
+                                  double *fareas);
+void compute_cell_geometry_subset(int ndims, double *coords,
+                                  int *nodepos, int *facenodes, int *neighbours,
+                                  double *fnormals,
+                                  double *fcentroids,
+                                  int nsubset, const int *cells,
+                                  int *facepos, int *cellfaces,
+                                  double *ccentroids, double *cvolumes);
+
 #endif /* MRST_GEOMETRY_H_INCLUDED */
@@ -102,10 +102,10 @@ vertical_cart_neighbors(const int dims[3], int c1, int c2){
 static void
 igetvectors(int dims[3], int i, int j, int *field, int *v[])
 {
-    int im = MAX(1,       i  ) - 1;
-    int ip = MIN(dims[0], i+1) - 1;
-    int jm = MAX(1,       j  ) - 1;
-    int jp = MIN(dims[1], j+1) - 1;
+    size_t im = MAX(1,       i  ) - 1;
+    size_t ip = MIN(dims[0], i+1) - 1;
+    size_t jm = MAX(1,       j  ) - 1;
+    size_t jp = MIN(dims[1], j+1) - 1;
 
     v[0] = field + dims[2]*(im + dims[0]* jm);
     v[1] = field + dims[2]*(im + dims[0]* jp);
@@ -153,13 +153,14 @@ compute_cell_index(const int dims[3], int i, int j,
 static int
 checkmemory(int nz, struct processed_grid *out, int **intersections)
 {
-    int r, m, n, ok;
+    cpg_offset_t r, m, n;
+    int ok;
 
     /* Ensure there is enough space to manage the (pathological) case
      * of every single cell on one side of a fault connecting to all
      * cells on the other side of the fault (i.e., an all-to-all cell
      * connectivity pairing). */
-    r = (2*nz + 2) * (2*nz + 2);
+    r = (cpg_offset_t) (2*nz + 2) * (2*nz + 2);
     m = out->m;
     n = out->n;
 
@@ -174,10 +175,10 @@ checkmemory(int nz, struct processed_grid *out, int **intersections)
     if (! ok) {
         void *p1, *p2, *p3, *p4;
 
-        p1 = realloc(*intersections     , 4*m   * sizeof **intersections);
-        p2 = realloc(out->face_neighbors, 2*m   * sizeof *out->face_neighbors);
-        p3 = realloc(out->face_ptr      , (m+1) * sizeof *out->face_ptr);
-        p4 = realloc(out->face_tag      , 1*m   * sizeof *out->face_tag);
+        p1 = realloc(*intersections     , 4*(size_t)m   * sizeof **intersections);
+        p2 = realloc(out->face_neighbors, 2*(size_t)m   * sizeof *out->face_neighbors);
+        p3 = realloc(out->face_ptr      , ((size_t)m+1) * sizeof *out->face_ptr);
+        p4 = realloc(out->face_tag      , 1*(size_t)m   * sizeof *out->face_tag);
 
         if (p1 != NULL) { *intersections      = p1; }
         if (p2 != NULL) { out->face_neighbors = p2; }
@@ -192,7 +193,7 @@ checkmemory(int nz, struct processed_grid *out, int **intersections)
     if (ok && (n != out->n)) {
         void *p1;
 
-        p1 = realloc(out->face_nodes, n * sizeof *out->face_nodes);
+        p1 = realloc(out->face_nodes, (size_t)n * sizeof *out->face_nodes);
 
         ok = p1 != NULL;
 
@@ -274,15 +275,15 @@ process_vertical_faces(int direction,
 
             /* Establish new connections (faces) along pillar pair. */
             findconnections(2*nz + 2, cornerpts,
-                            *intersections + 4*num_intersections,
+                            *intersections + 4*(size_t)num_intersections,
                             work, out);
 
             /* Start of ->face_neighbors[] for this set of connections. */
-            ptr = out->face_neighbors + 2*startface;
+            ptr = out->face_neighbors + 2*(size_t)startface;
 
             /* Total number of cells (both sides) connected by this
              * set of connections (faces). */
-            len = 2*out->number_of_faces - 2*startface;
+            len = 2*(out->number_of_faces - startface);
 
             /* Derive inter-cell connectivity (i.e. ->face_neighbors)
              * of global (uncompressed) cells for this set of
@@ -350,7 +351,7 @@ process_horizontal_faces(int **intersections,
 
 
             f = out->face_nodes     + out->face_ptr[out->number_of_faces];
-            n = out->face_neighbors + 2*out->number_of_faces;
+            n = out->face_neighbors + 2*(size_t)out->number_of_faces;
 
 
             /* Vectors of point numbers */
@@ -417,18 +418,28 @@ process_horizontal_faces(int **intersections,
 
 /*-----------------------------------------------------------------
   On input,
-  L points to 4 ints that indirectly refers to points in c.
+  L points to 4 ints that indirectly refers to points in c.  L[0] and
+  L[2] lie on the first pillar, L[1] and L[3] on the second.
   c points to array of coordinates [x0,y0,z0,x1,y1,z1,...,xn,yn,zn].
   pt points to array of 3 doubles.
 
   On output,
   pt holds coordinates to intersection between lines given by point
   numbers L[0]-L[1] and L[2]-L[3].
+
+  The intersection is found on the horizontal line between the two
+  pillars at the height where the lines cross.  If the lines are
+  (nearly) parallel, or cross (nearly) on a pillar, finding the
+  pillar points at that height amplifies rounding errors without
+  bound and may place the node far away.  The midpoint between the
+  two lines at the crossing is used instead, and the return value is
+  1.  Otherwise, the return value is 0.
 */
-static void approximate_intersection_pt(int *L, double *c, double *pt)
+static int approximate_intersection_pt(const int *L, const double *c, double *pt)
 {
     double a;
     double z0, z1, z2, z3;
+    double d0, d1, tol;
     double b1, b2;
     double x1, y1;
     double x2, y2;
@@ -438,10 +449,34 @@ static void approximate_intersection_pt(int *L, double *c, double *pt)
     assert (L[0] != L[2]);
     assert (L[1] != L[3]);
 
-    z0 = c[3*L[0] + 2];
-    z1 = c[3*L[1] + 2];
-    z2 = c[3*L[2] + 2];
-    z3 = c[3*L[3] + 2];
+    z0 = c[3*(size_t)L[0] + 2];
+    z1 = c[3*(size_t)L[1] + 2];
+    z2 = c[3*(size_t)L[2] + 2];
+    z3 = c[3*(size_t)L[3] + 2];
+
+    /* Vertical distance between the lines on each pillar, relative
+     * to the vertical extent of the lines. */
+    d0  = z2 - z0;
+    d1  = z3 - z1;
+    tol = sqrt(DBL_EPSILON) * (fabs(z1 - z0) + fabs(z3 - z2) + fabs(d0) + fabs(d1));
+
+    if ((fabs(d0) <= tol) || (fabs(d1) <= tol)) {
+        /* Crossing lines have d0 and d1 of opposite signs, such that
+         * |d0 - d1| = |d0| + |d1| is computed without cancellation
+         * and a is in [0,1]. */
+        if ((d0*d1 <= 0.0) && (fabs(d0 - d1) > 0.0)) {
+            a = d0 / (d0 - d1);
+        } else {
+            a = 0.5;
+        }
+
+        for (int d = 0; d < 3; ++d) {
+            pt[d] = 0.5*(c[3*(size_t)L[0] + d]*(1.0 - a) + c[3*(size_t)L[1] + d]*a
+                       + c[3*(size_t)L[2] + d]*(1.0 - a) + c[3*(size_t)L[3] + d]*a);
+        }
+
+        return 1;
+    }
 
     /* find parameter a where lines L0L1 and L2L3 have same
      * z-coordinate */
@@ -462,14 +497,14 @@ static void approximate_intersection_pt(int *L, double *c, double *pt)
     /* find point (x1, y1, z) on pillar 1 */
     b1 = (z2 - z) / (z2 - z0);
     b2 = (z - z0) / (z2 - z0);
-    x1 = c[3*L[0] + 0]*b1 + c[3*L[2] + 0]*b2;
-    y1 = c[3*L[0] + 1]*b1 + c[3*L[2] + 1]*b2;
+    x1 = c[3*(size_t)L[0] + 0]*b1 + c[3*(size_t)L[2] + 0]*b2;
+    y1 = c[3*(size_t)L[0] + 1]*b1 + c[3*(size_t)L[2] + 1]*b2;
 
     /* find point (x2, y2, z) on pillar 2 */
     b1 = (z - z3) / (z1 - z3);
     b2 = (z1 - z) / (z1 - z3);
-    x2 = c[3*L[1] + 0]*b1 + c[3*L[3] + 0]*b2;
-    y2 = c[3*L[1] + 1]*b1 + c[3*L[3] + 1]*b2;
+    x2 = c[3*(size_t)L[1] + 0]*b1 + c[3*(size_t)L[3] + 0]*b2;
+    y2 = c[3*(size_t)L[1] + 1]*b1 + c[3*(size_t)L[3] + 1]*b2;
 
     /* horizontal lines are by definition ON the bilinear surface
        spanned by L0, L1, L2 and L3.  find point (x, y, z) on
@@ -477,40 +512,48 @@ static void approximate_intersection_pt(int *L, double *c, double *pt)
     pt[0] = x1*(1.0 - a) + x2*a;
     pt[1] = y1*(1.0 - a) + y2*a;
     pt[2] = z;
+
+    return 0;
 }
 
 /*-----------------------------------------------------------------
   Compute x,y and z coordinates for points on each pillar.  Then,
-  append x,y and z coordinates for extra points on faults.  */
-static void
-compute_intersection_coordinates(int                   *intersections,
+  append x,y and z coordinates for extra points on faults.  The
+  intersections are independent and computed in parallel. Returns 0
+  if the node coordinates could not be reallocated, 1 otherwise.  */
+static int
+compute_intersection_coordinates(const int             *intersections,
                                  struct processed_grid *out)
 {
-    int n  = out->number_of_nodes;
-    int np = out->number_of_nodes_on_pillars;
+    const int n  = out->number_of_nodes;
+    const int np = out->number_of_nodes_on_pillars;
     int    k;
-    double *pt;
-    int    *itsct = intersections;
+    int    degenerate = 0;
+    double *coords;
+
     /* Make sure the space allocated for nodes match the number of
      * node. */
-    void *p = realloc (out->node_coordinates, 3*n*sizeof(double));
+    void *p = realloc (out->node_coordinates, 3*(size_t)n*sizeof(double));
     if (p) {
         out->node_coordinates = p;
     }
     else {
         fprintf(stderr, "Could not allocate extra space for intersections\n");
+        return 0;
     }
 
 
-    /* Append intersections */
-    pt    = out->node_coordinates + 3*np;
+    /* Append intersections.  The lines only refer to pillar points. */
+    coords = out->node_coordinates;
+#pragma omp parallel for reduction(+:degenerate) schedule(static)
+    for (k = np; k < n; ++k) {
+        degenerate += approximate_intersection_pt(intersections + 4*(size_t)(k - np),
+                                                  coords, coords + 3*(size_t)k);
+    }
 
-    for (k=np; k<n; ++k){
-        approximate_intersection_pt(itsct, out->node_coordinates, pt);
-        pt    += 3;
-        itsct += 4;
+    out->number_of_degenerate_intersections = degenerate;
 
-    }
+    return 1;
 }
 
 
@@ -519,7 +562,7 @@ static int*
 copy_and_permute_actnum(int nx, int ny, int nz, const int *in, int *out)
 /* ------------------------------------------------------------------ */
 {
-    int i,j,k;
+    size_t i,j,k;
     int *ptr = out;
 
     /* Permute actnum such that values of each vertical stack of cells
@@ -530,9 +573,9 @@ copy_and_permute_actnum(int nx, int ny, int nz, const int *in, int *out)
      * in MATLAB pseudo-code.
      */
     if (in != NULL) {
-        for (j = 0; j < ny; ++j) {
-            for (i = 0; i < nx; ++i) {
-                for (k = 0; k < nz; ++k) {
+        for (j = 0; j < (size_t)ny; ++j) {
+            for (i = 0; i < (size_t)nx; ++i) {
+                for (k = 0; k < (size_t)nz; ++k) {
                     *ptr++ = in[i + nx*(j + ny*k)];
                 }
             }
@@ -540,7 +583,7 @@ copy_and_permute_actnum(int nx, int ny, int nz, const int *in, int *out)
     }
     else {
         /* No explicit ACTNUM.  Assume all cells active. */
-        for (i = 0; i < nx * ny * nz; i++) {
+        for (i = 0; i < ((size_t)nx) * ny * nz; i++) {
             out[ i ] = 1;
         }
     }
@@ -554,7 +597,7 @@ copy_and_permute_zcorn(int nx, int ny, int nz, const double *in,
                        double sign, double *out)
 /* ------------------------------------------------------------------ */
 {
-    int i,j,k;
+    size_t i,j,k;
     double *ptr = out;
     /* Permute zcorn such that values of each vertical stack of cells
      * are adjacent in memory, i.e.,
@@ -563,9 +606,9 @@ copy_and_permute_zcorn(int nx, int ny, int nz, const double *in,
 
      in Matlab pseudo-code.
     */
-    for (j=0; j<2*ny; ++j){
-        for (i=0; i<2*nx; ++i){
-            for (k=0; k<2*nz; ++k){
+    for (j=0; j<2*(size_t)ny; ++j){
+        for (i=0; i<2*(size_t)nx; ++i){
+            for (k=0; k<2*(size_t)nz; ++k){
                 *ptr++ = sign * in[i+2*nx*(j+2*ny*k)];
             }
         }
@@ -590,25 +633,25 @@ get_zcorn_sign(int nx, int ny, int nz, const int *actnum,
 
     */
     int    sign;
-    int    i, j, k;
-    int    c1, c2;
+    size_t i, j, k;
+    size_t c1, c2;
     double z1, z2;
 
     for (sign = 1; sign>-2; sign = sign - 2)
     {
         *error = 0;
 
-        for (j=0; j<2*ny; ++j){
-            for (i=0; i<2*nx; ++i){
-                for (k=0; k<2*nz-1; ++k){
+        for (j=0; j<2*(size_t)ny; ++j){
+            for (i=0; i<2*(size_t)nx; ++i){
+                for (k=0; k+1<2*(size_t)nz; ++k){
                     z1 = sign*zcorn[i+2*nx*(j+2*ny*(k))];
                     z2 = sign*zcorn[i+2*nx*(j+2*ny*(k+1))];
 
                     c1 = i/2 + nx*(j/2 + ny*(k/2));
                     c2 = i/2 + nx*(j/2 + ny*((k+1)/2));
 
-                    assert (c1 < (nx * ny * nz));
-                    assert (c2 < (nx * ny * nz));
+                    assert (c1 < ((size_t)nx * ny * nz));
+                    assert (c2 < ((size_t)nx * ny * nz));
 
                     if (((actnum == NULL) ||
                          (actnum[c1] && actnum[c2]))
@@ -811,8 +854,8 @@ void process_grdecl(const struct grdecl   *in,
           increased)
        2) set Cartesian imensions
     */
-    out->m                = (int) (BIGNUM / 3);
-    out->n                = (int) BIGNUM;
+    out->m                = (cpg_offset_t) (BIGNUM / 3);
+    out->n                = (cpg_offset_t) BIGNUM;
 
     out->face_neighbors   = malloc( BIGNUM      * sizeof *out->face_neighbors);
     out->face_nodes       = malloc( out->n      * sizeof *out->face_nodes);
@@ -826,6 +869,7 @@ void process_grdecl(const struct grdecl   *in,
     out->number_of_faces  = 0;
     out->number_of_nodes  = 0;
     out->number_of_cells  = 0;
+    out->number_of_degenerate_intersections = 0;
 
     out->node_coordinates = NULL;
     out->local_cell_index = malloc(nc * sizeof *out->local_cell_index);
@@ -861,7 +905,10 @@ void process_grdecl(const struct grdecl   *in,
      * padding */
     plist = malloc(8 * (nc + ((size_t)nx)*((size_t)ny)) * sizeof *plist);
 
-    finduniquepoints(&g, plist, tolerance, out);
+    if (! finduniquepoints(&g, plist, tolerance, out)) {
+        fprintf(stderr, "Could not determine unique points in process_grdecl()\n");
+        exit(1);
+    }
 
     free (zcorn);
     free (actnum);
@@ -898,7 +945,10 @@ void process_grdecl(const struct grdecl   *in,
     /* -----------------------------------------------------------------*/
     /* (re)allocate space for and compute coordinates of nodes that
      * arise from intersecting cells (faults) */
-    compute_intersection_coordinates(intersections, out);
+    if (! compute_intersection_coordinates(intersections, out)) {
+        fprintf(stderr, "Could not compute intersections in process_grdecl()\n");
+        exit(1);
+    }
 
     free (intersections);
 
@@ -50,6 +50,21 @@
 extern "C" {
 #endif
 
+    /**
+     * Integer type of positions in, and sizes of, the face-to-node
+     * table of a processed_grid.
+     *
+     * A 64-bit type in builds configured with OPM_GRID_64BIT_INDICES,
+     * which is needed for models with more than INT_MAX face nodes
+     * (roughly 500 million faces). Cell, face and node numbers remain
+     * of type int in either case.
+     */
+#if OPM_GRID_64BIT_INDICES
+    typedef long long cpg_offset_t;
+#else
+    typedef int cpg_offset_t;
+#endif
+
     /**
      * Raw corner-point specification of a particular geological model.
      */
@@ -76,10 +91,12 @@ extern "C" {
      * a geological model in corner-point format.
      */
     struct processed_grid {
-        int m; /**< Upper bound on "number_of_faces".  For internal use in
-                    function process_grid()'s memory management. */
-        int n; /**< Upper bound on "number_of_nodes".  For internal use in
-                    function process_grid()'s memory management. */
+        cpg_offset_t m; /**< Upper bound on "number_of_faces".  For internal
+                             use in function process_grid()'s memory
+                             management. */
+        cpg_offset_t n; /**< Upper bound on the size of "face_nodes".  For
+                             internal use in function process_grid()'s
+                             memory management. */
 
         int    dimensions[3];     /**< Cartesian box dimensions. */
 
@@ -87,7 +104,7 @@ extern "C" {
                                        (i.e., connections). */
         int    *face_nodes;       /**< Node (vertex) numbers of each face,
                                        stored sequentially. */
-        int    *face_ptr;         /**< Start position for each face's
+        cpg_offset_t *face_ptr;   /**< Start position for each face's
                                        `face_nodes'. */
         int    *face_neighbors;   /**< Global cell numbers.  Two elements per
                                        face, stored sequentially. */
@@ -100,6 +117,12 @@ extern "C" {
         double *node_coordinates; /**< Vertex coordinates.  Three doubles
                                        (\f$x\f$, \f$y\f$, \f$z\f$) per vertex,
                                        stored sequentially. */
+        int    number_of_degenerate_intersections; /**< Number of fault
+                                                        intersection vertices
+                                                        between (nearly)
+                                                        parallel lines, placed
+                                                        at a fallback
+                                                        position. */
 
         int    number_of_cells;   /**< Number of active grid cells. */
         int    *local_cell_index; /**< Deceptively named local-to-global cell
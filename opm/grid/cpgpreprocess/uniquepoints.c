@@ -62,21 +62,70 @@ static int compare(const void *a, const void *b)
 }
 
 /*-----------------------------------------------------------------
-  Creat sorted list of z-values in zcorn with actnum==1x */
+  Sort <n> doubles in <run>.  The z-values of a single column are
+  usually sorted already, so only check for that case.  */
+static void sortRun(double *run, int n)
+{
+    int i;
+
+    for (i=1; i<n; ++i){
+        if (run[i] < run[i-1]) {
+            qsort(run, n, sizeof(double), compare);
+            return;
+        }
+    }
+}
+
+/*-----------------------------------------------------------------
+  Merge sorted sequences <a> and <b> into <out>.  Return length of
+  <out>. */
+static int mergeRuns(const double *a, int na,
+                     const double *b, int nb, double *out)
+{
+    int i = 0, j = 0, k = 0;
+
+    while ((i < na) && (j < nb)){
+        out[k++] = (b[j] < a[i]) ? b[j++] : a[i++];
+    }
+    while (i < na) { out[k++] = a[i++]; }
+    while (j < nb) { out[k++] = b[j++]; }
+
+    return k;
+}
+
+/*-----------------------------------------------------------------
+  Creat sorted list of z-values in zcorn with actnum==1x.  The active
+  z-values of each of the <m> columns are sorted separately and merged
+  into <list>.  <work> must hold 3*m*n doubles. */
 static int createSortedList(double *list, int n, int m,
-                            const double *z[], const int *a[])
+                            const double *z[], const int *a[],
+                            double *work)
 {
-    int i,j;
-    double *ptr = list;
-    for (i=0; i<n; ++i){
-        for (j=0; j<m; ++j){
-            if (a[j][i/2])  *ptr++ = z[j][i];
+    int i,j,len,nrun;
+    double *run  = work;
+    double *acc  = work + (size_t)m*n;
+    double *next = work + 2*(size_t)m*n;
+    double *tmp;
+
+    len = 0;
+    for (j=0; j<m; ++j){
+        nrun = 0;
+        for (i=0; i<n; ++i){
+            if (a[j][i/2])  run[nrun++] = z[j][i];
             /* else        fprintf(stderr, "skipping point in inactive cell\n"); */
         }
+        sortRun(run, nrun);
+
+        if (j == m-1) {
+            /* Last run is merged directly into the output. */
+            return mergeRuns(acc, len, run, nrun, list);
+        }
+
+        len = mergeRuns(acc, len, run, nrun, next);
+        tmp = acc;  acc = next;  next = tmp;
     }
 
-    qsort(list, ptr-list, sizeof(double), compare);
-    return ptr-list;
+    return 0;
 }
 
 
@@ -274,19 +323,20 @@ int finduniquepoints(const struct grdecl *g,
 
 {
 
-    const int nx = out->dimensions[0];
-    const int ny = out->dimensions[1];
-    const int nz = out->dimensions[2];
-    const int nc = g->dims[0]*g->dims[1]*g->dims[2];
+    const size_t nx = out->dimensions[0];
+    const size_t ny = out->dimensions[1];
+    const size_t nz = out->dimensions[2];
+    const size_t nc = nx*ny*nz;
 
 
     /* zlist may need extra space temporarily due to simple boundary
      * treatement  */
-    int            npillarpoints = 8*(nx+1)*(ny+1)*nz;
-    int            npillars      = (nx+1)*(ny+1);
+    size_t         npillarpoints = 8*(nx+1)*(ny+1)*nz;
+    size_t         npillars      = (nx+1)*(ny+1);
 
     double *zlist = malloc(npillarpoints*sizeof *zlist);
     int     *zptr = malloc((npillars+1)*sizeof *zptr);
+    double  *work = malloc(3*4*2*nz*sizeof *work);
 
 
 
@@ -301,8 +351,8 @@ int finduniquepoints(const struct grdecl *g,
     const double *z[4];
     const int *a[4];
     int *p;
-    int pix, cix;
-    int zix;
+    int pix;
+    size_t cix, zix;
 
     const double *coord = g->coord;
 
@@ -312,6 +362,15 @@ int finduniquepoints(const struct grdecl *g,
 
     out->node_coordinates = malloc (3*8*nc*sizeof(*out->node_coordinates));
 
+    if ((zlist == NULL) || (zptr == NULL) || (work == NULL) ||
+        (out->node_coordinates == NULL)) {
+        fprintf(stderr, "Could not allocate memory in finduniquepoints()\n");
+        free(work);
+        free(zptr);
+        free(zlist);
+        return 0;
+    }
+
     zptr[pos++] = zout - zlist;
 
     pt    = out->node_coordinates;
@@ -324,7 +383,7 @@ int finduniquepoints(const struct grdecl *g,
             igetvectors(g->dims,   i,   j, g->actnum, a);
             dgetvectors(d1,      2*i, 2*j, g->zcorn,  z);
 
-            len = createSortedList(     zout, d1[2], 4, z, a);
+            len = createSortedList(     zout, d1[2], 4, z, a, work);
             len = uniquify        (len, zout, tolerance);
 
             /* Assign unique points */
@@ -335,13 +394,23 @@ int finduniquepoints(const struct grdecl *g,
             }
 
             /* Increment pointer to sparse table of unique zcorn
-             * values */
+             * values.  Point numbers are of type int. */
             zout        = zout + len;
-            zptr[pos++] = zout - zlist;
+            if (zout - zlist > INT_MAX) {
+                fprintf(stderr, "Number of unique points exceeds INT_MAX "
+                        "in finduniquepoints()\n");
+                free(work);
+                free(zptr);
+                free(zlist);
+                return 0;
+            }
+            zptr[pos++] = (int) (zout - zlist);
 
             coord += 6;
         }
     }
+    free(work);
+
     out->number_of_nodes_on_pillars = zptr[pos-1];
     out->number_of_nodes            = zptr[pos-1];
 
@@ -355,10 +424,10 @@ int finduniquepoints(const struct grdecl *g,
             pix = (i+1)/2 + (g->dims[0]+1)*((j+1)/2);
 
             /* cell column position */
-            cix = g->dims[2]*((i/2) + (j/2)*g->dims[0]);
+            cix = nz*((i/2) + (j/2)*nx);
 
             /* zcorn column position */
-            zix = 2*g->dims[2]*(i+2*g->dims[0]*j);
+            zix = 2*nz*(i + 2*nx*j);
 
             if (!assignPointNumbers(zptr[pix], zptr[pix+1], zlist,
                                     2*g->dims[2],
@@ -0,0 +1,115 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_CPGRID_COMMUNICATIONSTATISTICS_HEADER
+#define OPM_CPGRID_COMMUNICATIONSTATISTICS_HEADER
+
+#include <opm/grid/utility/CommunicationCounters.hpp>
+
+#include <dune/grid/common/gridenums.hh>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Dune
+{
+namespace cpgrid
+{
+
+/// \brief The communication counters of a grid on one rank, aggregated
+///        per call site, interface and data handle type.
+///
+/// A data handle for several codimensions is counted once per codimension.
+class CommunicationStatistics
+{
+public:
+    /// \brief What the counters are for.
+    struct Key
+    {
+        /// \brief The method communicating, e.g. "communicate".
+        std::string site;
+        /// \brief The name of the interface type, e.g. "InteriorBorder_All".
+        std::string interface;
+        /// \brief The type of the data handle.
+        std::string handle;
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(site, interface, handle) < std::tie(other.site, other.interface, other.handle);
+        }
+    };
+
+    /// \brief The counters for a key, created if not present.
+    Opm::CommunicationCounters& counters(const std::string& site, const std::string& interface,
+                                         const std::string& handle)
+    {
+        return records_[Key{ site, interface, handle }];
+    }
+
+    /// \brief The counters recorded on this rank.
+    const std::map<Key, Opm::CommunicationCounters>& records() const
+    {
+        return records_;
+    }
+
+    /// \brief Forget all counters.
+    void clear()
+    {
+        records_.clear();
+    }
+
+    /// \brief The name of an interface type.
+    static const char* interfaceName(InterfaceType iftype)
+    {
+        switch (iftype) {
+        case InteriorBorder_InteriorBorder_Interface:
+            return "InteriorBorder_InteriorBorder";
+        case InteriorBorder_All_Interface:
+            return "InteriorBorder_All";
+        case Overlap_OverlapFront_Interface:
+            return "Overlap_OverlapFront";
+        case Overlap_All_Interface:
+            return "Overlap_All";
+        case All_All_Interface:
+            return "All_All";
+        }
+        return "unknown";
+    }
+
+private:
+    std::map<Key, Opm::CommunicationCounters> records_;
+};
+
+/// \brief The communication counters of one key over all ranks.
+struct CommunicationReport
+{
+    CommunicationStatistics::Key key;
+    /// \brief The counters of this rank, zero if it did not record the key.
+    Opm::CommunicationCounters local;
+    /// \brief The minimum, maximum and average of each counter over the ranks.
+    Opm::CommunicationCounters min;
+    Opm::CommunicationCounters max;
+    Opm::CommunicationCounters average;
+};
+
+} // end namespace cpgrid
+} // end namespace Dune
+
+#endif // OPM_CPGRID_COMMUNICATIONSTATISTICS_HEADER
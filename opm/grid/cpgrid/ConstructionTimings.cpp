@@ -0,0 +1,126 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <opm/grid/cpgrid/ConstructionTimings.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace Dune
+{
+namespace cpgrid
+{
+
+    ConstructionTimings::Phase::Phase(ConstructionTimings& timings, const std::string& name)
+        : timings_(timings),
+          index_(timings.phases_.size()),
+          start_peak_rss_kb_(peakRssKb())
+    {
+        ConstructionPhase phase;
+        phase.name = timings.open_names_.empty() ? name : timings.open_names_.back() + "/" + name;
+        phase.rank = timings.rank_;
+        timings.open_names_.push_back(phase.name);
+        timings.phases_.push_back(std::move(phase));
+        // Started last, such that the bookkeeping above is not timed.
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    ConstructionTimings::Phase::~Phase()
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        // The phases may have been cleared while this one was running.
+        if (index_ < timings_.phases_.size()) {
+            auto& phase = timings_.phases_[index_];
+            phase.seconds = elapsed.count();
+            phase.peak_rss_delta_kb = peakRssKb() - start_peak_rss_kb_;
+        }
+        timings_.open_names_.pop_back();
+    }
+
+    void ConstructionTimings::Phase::setCounts(int cells, int faces, int points)
+    {
+        if (index_ < timings_.phases_.size()) {
+            auto& phase = timings_.phases_[index_];
+            phase.cells = cells;
+            phase.faces = faces;
+            phase.points = points;
+        }
+    }
+
+    ConstructionTimings::ConstructionTimings(int rank)
+        : rank_(rank)
+    {
+    }
+
+    void ConstructionTimings::clear()
+    {
+        phases_.clear();
+    }
+
+    std::string ConstructionTimings::toJson(const std::vector<ConstructionPhase>& phases)
+    {
+        std::ostringstream json;
+        json << std::setprecision(9);
+        json << "{\"phases\": [";
+        for (std::size_t i = 0; i < phases.size(); ++i) {
+            const auto& phase = phases[i];
+            json << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"";
+            for (const char c : phase.name) {
+                if (c == '"' || c == '\\') {
+                    json << '\\';
+                }
+                json << c;
+            }
+            json << "\", \"rank\": " << phase.rank
+                 << ", \"seconds\": " << phase.seconds
+                 << ", \"peak_rss_delta_kb\": " << phase.peak_rss_delta_kb
+                 << ", \"cells\": " << phase.cells
+                 << ", \"faces\": " << phase.faces
+                 << ", \"points\": " << phase.points << "}";
+        }
+        json << "\n]}\n";
+        return json.str();
+    }
+
+    long ConstructionTimings::peakRssKb()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+            // Reported in bytes.
+            return usage.ru_maxrss / 1024;
+#else
+            return usage.ru_maxrss;
+#endif
+        }
+#endif
+        return 0;
+    }
+
+} // end namespace cpgrid
+} // end namespace Dune
@@ -0,0 +1,114 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_CPGRID_CONSTRUCTIONTIMINGS_HEADER
+#define OPM_CPGRID_CONSTRUCTIONTIMINGS_HEADER
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Dune
+{
+namespace cpgrid
+{
+
+/// \brief Wall time, memory and entity counts of one phase of grid construction.
+struct ConstructionPhase
+{
+    /// \brief Name of the phase. Nested phases are named "parent/child".
+    std::string name;
+    /// \brief The rank that ran the phase.
+    int rank = 0;
+    /// \brief Wall-clock seconds spent in the phase.
+    double seconds = 0.0;
+    /// \brief Increase of the peak resident set size of the process
+    ///        during the phase, in kilobytes.
+    long peak_rss_delta_kb = 0;
+    /// \brief Number of cells, faces and points after the phase, or -1
+    ///        if not applicable.
+    int cells = -1;
+    int faces = -1;
+    int points = -1;
+};
+
+/// \brief Records the phases of grid construction on one rank.
+///
+/// Phases are timed by Phase objects living on the stack. The phases
+/// are stored in the order they were started, such that a parent
+/// phase precedes its children. Recording costs a clock reading and a
+/// getrusage() call at the beginning and end of each phase.
+class ConstructionTimings
+{
+public:
+    /// \brief Times a phase from construction to destruction.
+    class Phase
+    {
+    public:
+        /// \brief Start a phase.
+        /// \param timings Where to record the phase.
+        /// \param name The name of the phase, which is prefixed by the
+        ///        names of the enclosing phases.
+        Phase(ConstructionTimings& timings, const std::string& name);
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+        /// \brief End the phase and record it.
+        ~Phase();
+
+        /// \brief Set the entity counts after the phase.
+        void setCounts(int cells, int faces, int points);
+
+    private:
+        ConstructionTimings& timings_;
+        std::size_t index_;
+        std::chrono::steady_clock::time_point start_;
+        long start_peak_rss_kb_;
+    };
+
+    /// \brief Constructor.
+    /// \param rank The rank recorded with the phases.
+    explicit ConstructionTimings(int rank = 0);
+
+    /// \brief The phases recorded on this rank.
+    const std::vector<ConstructionPhase>& phases() const
+    {
+        return phases_;
+    }
+
+    /// \brief Forget all recorded phases. Not to be called while a
+    ///        phase is running.
+    void clear();
+
+    /// \brief Write phases as a JSON object with a "phases" array.
+    static std::string toJson(const std::vector<ConstructionPhase>& phases);
+
+    /// \brief The peak resident set size of the process in kilobytes,
+    ///        or 0 if not available on this platform.
+    static long peakRssKb();
+
+private:
+    int rank_;
+    std::vector<ConstructionPhase> phases_;
+    std::vector<std::string> open_names_;
+};
+
+} // end namespace cpgrid
+} // end namespace Dune
+
+#endif // OPM_CPGRID_CONSTRUCTIONTIMINGS_HEADER
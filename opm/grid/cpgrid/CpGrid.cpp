@@ -51,10 +51,15 @@
 #include <opm/grid/common/WellConnections.hpp>
 
 #include <opm/grid/common/CommunicationUtils.hpp>
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <set>
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace
 {
@@ -168,6 +173,7 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
 
     if (cc.size() > 1)
     {
+        cpgrid::ConstructionTimings::Phase phase(*data_->timings_, "scatterGrid");
         std::vector<int> computedCellPart;
         std::vector<std::pair<std::string,bool>> wells_on_proc;
         std::vector<std::tuple<int,int,char>> exportList;
@@ -240,27 +246,36 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
 
 
             // Partitioning given externally
+            cpgrid::ConstructionTimings::Phase partition_phase(*data_->timings_, "createZoltanListsFromParts");
             std::tie(computedCellPart, wells_on_proc, exportList, importList) =
                 cpgrid::createZoltanListsFromParts(*this, wells, nullptr, input_cell_part,
                                                    true);
+            partition_phase.setCounts(computedCellPart.size(), -1, -1);
         }
         else
         {
             if (useZoltan)
             {
 #ifdef HAVE_ZOLTAN
+                cpgrid::ConstructionTimings::Phase partition_phase(*data_->timings_,
+                                                                   serialPartitioning
+                                                                   ? "zoltanSerialGraphPartitionGridOnRoot"
+                                                                   : "zoltanGraphPartitionGridOnRoot");
                 std::tie(computedCellPart, wells_on_proc, exportList, importList)
                     = serialPartitioning
                     ? cpgrid::zoltanSerialGraphPartitionGridOnRoot(*this, wells, transmissibilities, cc, method, 0, zoltanImbalanceTol, allowDistributedWells)
                     : cpgrid::zoltanGraphPartitionGridOnRoot(*this, wells, transmissibilities, cc, method, 0, zoltanImbalanceTol, allowDistributedWells);
+                partition_phase.setCounts(computedCellPart.size(), -1, -1);
 #else
                 OPM_THROW(std::runtime_error, "Parallel runs depend on ZOLTAN if useZoltan is true. Please install!");
 #endif // HAVE_ZOLTAN
             }
             else
             {
+                cpgrid::ConstructionTimings::Phase partition_phase(*data_->timings_, "vanillaPartitionGridOnRoot");
                 std::tie(computedCellPart, wells_on_proc, exportList, importList) =
                     cpgrid::vanillaPartitionGridOnRoot(*this, wells, transmissibilities, allowDistributedWells);
+                partition_phase.setCounts(computedCellPart.size(), -1, -1);
             }
         }
         comm().barrier();
@@ -268,8 +283,14 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
         // first create the overlap
         // map from process to global cell indices in overlap
         std::map<int,std::set<int> > overlap;
-        auto noImportedOwner = addOverlapLayer(*this, computedCellPart, exportList, importList, cc, addCornerCells,
-                                               transmissibilities);
+        int noImportedOwner;
+        {
+            cpgrid::ConstructionTimings::Phase overlap_phase(*data_->timings_, "addOverlapLayer");
+            noImportedOwner = addOverlapLayer(*this, computedCellPart, exportList, importList, cc, addCornerCells,
+                                              transmissibilities);
+            // The cells imported to this rank, owned ones and overlap.
+            overlap_phase.setCounts(importList.size(), -1, -1);
+        }
         // importList contains all the indices that will be here.
         auto compareImport = [](const std::tuple<int,int,char,int>& t1,
                                 const std::tuple<int,int,char,int>&t2)
@@ -277,7 +298,32 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
                                  return std::get<0>(t1) < std::get<0>(t2);
                              };
 
-        if ( ! ownersFirst )
+        // Interior first ordering numbers the owned cells with an overlap
+        // neighbor after the other owned cells, and implies owners first.
+        int noInteriorWithoutOverlapNeighbors = noImportedOwner;
+        if ( interior_first_ordering_ )
+        {
+            std::vector<int> cellsWithOverlapNeighbors;
+            {
+                cpgrid::ConstructionTimings::Phase ordering_phase(*data_->timings_,
+                                                                  "findCellsWithOverlapNeighbors");
+                cellsWithOverlapNeighbors = findCellsWithOverlapNeighbors(*this, computedCellPart,
+                                                                          exportList, cc);
+                ordering_phase.setCounts(cellsWithOverlapNeighbors.size(), -1, -1);
+            }
+            auto withoutEnd =
+                std::stable_partition(importList.begin(), importList.begin()+noImportedOwner,
+                                      [&cellsWithOverlapNeighbors](const std::tuple<int,int,char,int>& t)
+                                      {
+                                          return !std::binary_search(cellsWithOverlapNeighbors.begin(),
+                                                                     cellsWithOverlapNeighbors.end(),
+                                                                     std::get<0>(t));
+                                      });
+            noInteriorWithoutOverlapNeighbors = withoutEnd - importList.begin();
+        }
+        const bool ownersFirstOrdering = ownersFirst || interior_first_ordering_;
+
+        if ( ! ownersFirstOrdering )
         {
             // merge owner and overlap sorted by global index
             std::inplace_merge(importList.begin(), importList.begin()+noImportedOwner,
@@ -288,7 +334,13 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
         for(auto&& entry: importList)
             std::get<3>(entry) = localIndex++;
 
-        if ( ownersFirst )
+        if ( interior_first_ordering_ )
+        {
+            // merge the owners without and with overlap neighbors sorted by global index
+            std::inplace_merge(importList.begin(), importList.begin()+noInteriorWithoutOverlapNeighbors,
+                               importList.begin()+noImportedOwner, compareImport);
+        }
+        if ( ownersFirstOrdering )
         {
             // merge owner and overlap sorted by global index
             std::inplace_merge(importList.begin(), importList.begin()+noImportedOwner,
@@ -406,6 +458,12 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
         }
 
         distributed_data_.reset(new cpgrid::CpGridData(cc));
+        distributed_data_->timings_ = data_->timings_;
+        if ( interior_first_ordering_ )
+        {
+            distributed_data_->interior_first_ranges_ = {{ noInteriorWithoutOverlapNeighbors,
+                                                          noImportedOwner }};
+        }
         distributed_data_->setUniqueBoundaryIds(data_->uniqueBoundaryIds());
         // Just to be sure we assume that only master knows
         cc.broadcast(&distributed_data_->use_unique_boundary_ids_, 1, 0);
@@ -423,11 +481,20 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
         setupSendInterface(exportList, *cell_scatter_gather_interfaces_);
         setupRecvInterface(importList, *cell_scatter_gather_interfaces_);
 
-        distributed_data_->distributeGlobalGrid(*this,*this->current_view_data_, computedCellPart);
+        // The export list on the root names all processes sharing a cell.
+        std::vector<std::tuple<int,int,char>> remoteCells;
+        {
+            cpgrid::ConstructionTimings::Phase remote_phase(*data_->timings_, "computeRemoteCells");
+            remoteCells = computeRemoteCells(exportList, cc);
+            remote_phase.setCounts(remoteCells.size(), -1, -1);
+        }
+        distributed_data_->distributeGlobalGrid(*this,*this->current_view_data_, computedCellPart,
+                                                &remoteCells);
         global_id_set_.insertIdSet(*distributed_data_);
 
 
         current_view_data_ = distributed_data_.get();
+        phase.setCounts(numCells(), numFaces(), numVertices());
         return std::make_pair(true, wells_on_proc);
     }
     else
@@ -445,59 +512,187 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
 }
 
 
-    void CpGrid::createCartesian(const std::array<int, 3>& dims,
-                                 const std::array<double, 3>& cellsize)
+    std::array<int, 3> CpGrid::interiorFirstCellRanges() const
     {
-        if ( current_view_data_->ccobj_.rank() != 0 )
+        if (!distributed_data_)
         {
-            // global grid only on rank 0
-            current_view_data_->ccobj_.broadcast(current_view_data_->logical_cartesian_size_.data(),
-                                                 current_view_data_->logical_cartesian_size_.size(),
-                                                 0);
-            return;
+            const int num_cells = size(0);
+            return {{ num_cells, num_cells, num_cells }};
         }
+        const int num_cells = distributed_data_->size(0);
+        const auto& ranges = distributed_data_->interior_first_ranges_;
+        if (ranges[0] < 0)
+        {
+            OPM_THROW(std::logic_error, "The cells were not numbered interior first when load balancing."
+                      " Call setInteriorFirstOrdering(true) before loadBalance().");
+        }
+        return {{ ranges[0], ranges[1], num_cells }};
+    }
+
+    const cpgrid::ConstructionTimings& CpGrid::constructionTimings() const
+    {
+        return *data_->timings_;
+    }
+
+    std::vector<cpgrid::ConstructionPhase> CpGrid::gatherConstructionTimings() const
+    {
+        const auto& phases = data_->timings_->phases();
+#if HAVE_MPI
+        const auto& cc = data_->ccobj_;
+        if (cc.size() > 1) {
+            // Send the names as null-terminated strings and the rest as
+            // a fixed number of doubles per phase.
+            constexpr std::size_t num_values = 6;
+            std::vector<char> names;
+            std::vector<double> values;
+            values.reserve(num_values*phases.size());
+            for (const auto& phase : phases) {
+                names.insert(names.end(), phase.name.begin(), phase.name.end());
+                names.push_back('\0');
+                values.insert(values.end(), { double(phase.rank), phase.seconds,
+                                              double(phase.peak_rss_delta_kb), double(phase.cells),
+                                              double(phase.faces), double(phase.points) });
+            }
+            const auto all_names = Opm::gatherv(names, cc, 0).first;
+            const auto all_values = Opm::gatherv(values, cc, 0).first;
+
+            std::vector<cpgrid::ConstructionPhase> all_phases(all_values.size() / num_values);
+            auto name = all_names.begin();
+            for (std::size_t i = 0; i < all_phases.size(); ++i) {
+                auto& phase = all_phases[i];
+                const auto name_end = std::find(name, all_names.end(), '\0');
+                phase.name.assign(name, name_end);
+                name = name_end + 1;
+                const double* value = &all_values[num_values*i];
+                phase.rank = value[0];
+                phase.seconds = value[1];
+                phase.peak_rss_delta_kb = value[2];
+                phase.cells = value[3];
+                phase.faces = value[4];
+                phase.points = value[5];
+            }
+            return all_phases;
+        }
+#endif
+        return phases;
+    }
 
-        // Make the grdecl format arrays.
-        // Pillar coords.
-        std::vector<double> coord;
-        coord.reserve(6*(dims[0] + 1)*(dims[1] + 1));
-        double bot = 0.0;
-        double top = dims[2]*cellsize[2];
-        // i runs fastest for the pillars.
-        for (int j = 0; j < dims[1] + 1; ++j) {
-            double y = j*cellsize[1];
-            for (int i = 0; i < dims[0] + 1; ++i) {
-                double x = i*cellsize[0];
-                double pillar[6] = { x, y, bot, x, y, top };
-                coord.insert(coord.end(), pillar, pillar + 6);
+    std::vector<cpgrid::CommunicationReport> CpGrid::communicationReport() const
+    {
+        const auto& cc = data_->ccobj_;
+        const auto& records = communication_statistics_->records();
+
+        // The keys used on any rank, sent as null-terminated strings.
+        std::set<cpgrid::CommunicationStatistics::Key> keys;
+        std::vector<char> names;
+        for (const auto& record : records) {
+            keys.insert(record.first);
+            for (const auto* name : { &record.first.site, &record.first.interface, &record.first.handle }) {
+                names.insert(names.end(), name->begin(), name->end());
+                names.push_back('\0');
             }
         }
-        std::vector<double> zcorn(8*dims[0]*dims[1]*dims[2]);
-        const int num_per_layer = 4*dims[0]*dims[1];
-        double* offset = &zcorn[0];
-        for (int k = 0; k < dims[2]; ++k) {
-            double zlow = k*cellsize[2];
-            std::fill(offset, offset + num_per_layer, zlow);
-            offset += num_per_layer;
-            double zhigh = (k+1)*cellsize[2];
-            std::fill(offset, offset + num_per_layer, zhigh);
-            offset += num_per_layer;
+        if (cc.size() > 1) {
+            const auto all_names = Opm::allGatherv(names, cc).first;
+            std::array<std::string, 3> fields;
+            std::size_t field = 0;
+            for (auto name = all_names.begin(); name != all_names.end(); ) {
+                const auto name_end = std::find(name, all_names.end(), '\0');
+                fields[field].assign(name, name_end);
+                name = name_end + 1;
+                if (++field == fields.size()) {
+                    keys.insert({ fields[0], fields[1], fields[2] });
+                    field = 0;
+                }
+            }
+        }
+
+        // Reduce the counters of all keys at once, zero where not recorded.
+        constexpr std::size_t num_values = 7;
+        std::vector<cpgrid::CommunicationReport> reports;
+        std::vector<double> values;
+        for (const auto& key : keys) {
+            cpgrid::CommunicationReport report;
+            report.key = key;
+            const auto record = records.find(key);
+            if (record != records.end()) {
+                report.local = record->second;
+            }
+            const auto& c = report.local;
+            values.insert(values.end(), { c.calls, c.messages, c.bytes, c.neighbors,
+                                          c.wait_seconds, c.pack_seconds, c.unpack_seconds });
+            reports.push_back(report);
+        }
+        auto min = values, max = values, sum = values;
+        cc.min(min.data(), min.size());
+        cc.max(max.data(), max.size());
+        cc.sum(sum.data(), sum.size());
+        auto assign = [](Opm::CommunicationCounters& c, const double* v, double scale) {
+            c.calls = v[0] * scale;
+            c.messages = v[1] * scale;
+            c.bytes = v[2] * scale;
+            c.neighbors = v[3] * scale;
+            c.wait_seconds = v[4] * scale;
+            c.pack_seconds = v[5] * scale;
+            c.unpack_seconds = v[6] * scale;
+        };
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            assign(reports[i].min, &min[num_values*i], 1.0);
+            assign(reports[i].max, &max[num_values*i], 1.0);
+            assign(reports[i].average, &sum[num_values*i], 1.0 / cc.size());
+        }
+        return reports;
+    }
+
+    std::string CpGrid::constructionTimingsJson() const
+    {
+        const auto phases = gatherConstructionTimings();
+        if (data_->ccobj_.rank() != 0) {
+            return std::string();
+        }
+        return cpgrid::ConstructionTimings::toJson(phases);
+    }
+
+
+    cpgrid::MemoryUsage CpGrid::memoryUsage() const
+    {
+        cpgrid::MemoryUsage usage;
+        usage.append("global/", data_->memoryUsage());
+        if (distributed_data_) {
+            usage.append("distributed/", distributed_data_->memoryUsage());
+        }
+#if HAVE_MPI
+        usage.add("scatter_gather_interfaces",
+                  cpgrid::interfaceBytes(*cell_scatter_gather_interfaces_)
+                  + cpgrid::interfaceBytes(*point_scatter_gather_interfaces_));
+#endif
+        return usage;
+    }
+
+
+    void CpGrid::createCartesian(const std::array<int, 3>& dims,
+                                 const std::array<double, 3>& cellsize)
+    {
+        std::array<std::vector<double>, 3> coordinates;
+        for (int dim = 0; dim < 3; ++dim) {
+            coordinates[dim].resize(dims[dim] + 1);
+            for (int n = 0; n <= dims[dim]; ++n) {
+                coordinates[dim][n] = n*cellsize[dim];
+            }
+        }
+        createCartesian(coordinates);
+    }
+
+    void CpGrid::createCartesian(const std::array<std::vector<double>, 3>& coordinates)
+    {
+        // Checked on all ranks, as the others would otherwise wait in the
+        // broadcast below when rank 0 throws.
+        cpgrid::CpGridData::checkCartesianCoordinates(coordinates);
+        if ( current_view_data_->ccobj_.rank() == 0 )
+        {
+            // global grid only on rank 0
+            current_view_data_->createCartesian(coordinates);
         }
-        std::vector<int> actnum(dims[0]*dims[1]*dims[2], 1);
-
-        // Process them.
-        grdecl g;
-        g.dims[0] = dims[0];
-        g.dims[1] = dims[1];
-        g.dims[2] = dims[2];
-        g.coord = &coord[0];
-        g.zcorn = &zcorn[0];
-        g.actnum = &actnum[0];
-        using NNCMap = std::set<std::pair<int, int>>;
-        using NNCMaps = std::array<NNCMap, 2>;
-        NNCMaps nnc;
-        current_view_data_->processEclipseFormat(g, nullptr, nnc, false, false, false);
-        // global grid only on rank 0
         current_view_data_->ccobj_.broadcast(current_view_data_->logical_cartesian_size_.data(),
                                              current_view_data_->logical_cartesian_size_.size(),
                                              0);
@@ -551,9 +746,7 @@ CpGrid::scatterGrid(EdgeWeightMethod method,
     void CpGrid::processEclipseFormat(const grdecl& input_data,
                                       bool remove_ij_boundary, bool turn_normals)
     {
-        using NNCMap = std::set<std::pair<int, int>>;
-        using NNCMaps = std::array<NNCMap, 2>;
-        NNCMaps nnc;
+        std::array<std::vector<std::pair<int, int>>, 2> nnc;
         current_view_data_->processEclipseFormat(input_data, nullptr, nnc,
                                                  remove_ij_boundary, turn_normals, false);
         current_view_data_->ccobj_.broadcast(current_view_data_->logical_cartesian_size_.data(),
@@ -1,6 +1,9 @@
 #include"config.h"
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 #include"CpGridData.hpp"
 #include"DataHandleWrappers.hpp"
@@ -29,7 +32,8 @@ namespace cpgrid
 
 CpGridData::CpGridData(const CpGridData& g)
     : index_set_(new IndexSet(*this)), local_id_set_(new IdSet(*this)),
-      global_id_set_(new LevelGlobalIdSet(local_id_set_, this)), partition_type_indicator_(new PartitionTypeIndicator(*this)), ccobj_(g.ccobj_)
+      global_id_set_(new LevelGlobalIdSet(local_id_set_, this)), partition_type_indicator_(new PartitionTypeIndicator(*this)), ccobj_(g.ccobj_), timings_(g.timings_),
+      lazy_geometry_(false)
 {
 #if HAVE_MPI
     cell_interfaces_=std::make_tuple(Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_));
@@ -39,7 +43,9 @@ CpGridData::CpGridData(const CpGridData& g)
 CpGridData::CpGridData()
     : index_set_(new IndexSet(*this)), local_id_set_(new IdSet(*this)),
       global_id_set_(new LevelGlobalIdSet(local_id_set_, this)), partition_type_indicator_(new PartitionTypeIndicator(*this)),
-      ccobj_(Dune::MPIHelper::getCommunicator()), use_unique_boundary_ids_(false)
+      ccobj_(Dune::MPIHelper::getCommunicator()),
+      timings_(std::make_shared<ConstructionTimings>(ccobj_.rank())), use_unique_boundary_ids_(false),
+    lazy_geometry_(false)
 {
 #if HAVE_MPI
     cell_interfaces_=std::make_tuple(Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_));
@@ -49,7 +55,9 @@ CpGridData::CpGridData()
 CpGridData::CpGridData(MPIHelper::MPICommunicator comm)
     : index_set_(new IndexSet(*this)), local_id_set_(new IdSet(*this)),
       global_id_set_(new LevelGlobalIdSet(local_id_set_, this)), partition_type_indicator_(new PartitionTypeIndicator(*this)),
-      ccobj_(comm), use_unique_boundary_ids_(false)
+      ccobj_(comm),
+      timings_(std::make_shared<ConstructionTimings>(ccobj_.rank())), use_unique_boundary_ids_(false),
+      lazy_geometry_(false)
 {
 #if HAVE_MPI
     cell_interfaces_=std::make_tuple(Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_));
@@ -60,7 +68,9 @@ CpGridData::CpGridData(MPIHelper::MPICommunicator comm)
 CpGridData::CpGridData(CpGrid&)
   : index_set_(new IndexSet(*this)),   local_id_set_(new IdSet(*this)),
     global_id_set_(new LevelGlobalIdSet(local_id_set_, this)),  partition_type_indicator_(new PartitionTypeIndicator(*this)),
-    ccobj_(Dune::MPIHelper::getCommunicator()), use_unique_boundary_ids_(false)
+    ccobj_(Dune::MPIHelper::getCommunicator()),
+      timings_(std::make_shared<ConstructionTimings>(ccobj_.rank())), use_unique_boundary_ids_(false),
+    lazy_geometry_(false)
 {
 #if HAVE_MPI
     cell_interfaces_=std::make_tuple(Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_),Interface(ccobj_));
@@ -89,15 +99,111 @@ void freeInterfaces(std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceM
     freeInterfaces(std::get<3>(interfaces));
     freeInterfaces(std::get<4>(interfaces));
 }
+
+/// \brief A data handle for a block of values per cell in a contiguous array.
+class CellBlockDataHandle
+{
+public:
+    typedef double DataType;
+
+    CellBlockDataHandle(double* values, int block_size)
+        : values_(values), block_size_(block_size)
+    {}
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+    bool fixedSize(int, int)
+#else
+    bool fixedsize(int, int)
+#endif
+    {
+        return true;
+    }
+    template<class T>
+    std::size_t size(const T&)
+    {
+        return block_size_;
+    }
+    template<class B, class T>
+    void gather(B& buffer, const T& t)
+    {
+        const double* block = values_ + std::size_t(t.index())*block_size_;
+        for(int i=0; i<block_size_; ++i)
+            buffer.write(block[i]);
+    }
+    template<class B, class T>
+    void scatter(B& buffer, const T& t, std::size_t)
+    {
+        double* block = values_ + std::size_t(t.index())*block_size_;
+        for(int i=0; i<block_size_; ++i)
+            buffer.read(block[i]);
+    }
+    bool contains(int dim, int codim)
+    {
+        return dim==3 && codim==0;
+    }
+private:
+    double* values_;
+    int block_size_;
+};
+
+/// \brief An indexed datatype selecting the blocks of the cells of a list.
+MPI_Datatype cellBlockDatatype(const InterfaceInformation& list, int block_size)
+{
+    std::vector<int> displacements(list.size());
+    for(std::size_t i=0; i<list.size(); ++i)
+        displacements[i] = list[i]*block_size;
+    MPI_Datatype type;
+    MPI_Type_create_indexed_block(list.size(), block_size, displacements.data(),
+                                  MPI_DOUBLE, &type);
+    MPI_Type_commit(&type);
+    return type;
+}
+
+/// \brief Whether a cell is received twice, or sent and received.
+/// \param forward Whether the first lists are sent and the second received.
+template<class InterfaceMap>
+bool overlappingLists(const InterfaceMap& interface, bool forward, std::size_t num_cells)
+{
+    std::vector<char> used(num_cells, false);
+    for(const auto& neighbor : interface)
+    {
+        const auto& send = forward ? neighbor.second.first : neighbor.second.second;
+        for(std::size_t i=0; i<send.size(); ++i)
+            used[send[i]] = true;
+    }
+    for(const auto& neighbor : interface)
+    {
+        const auto& receive = forward ? neighbor.second.second : neighbor.second.first;
+        for(std::size_t i=0; i<receive.size(); ++i)
+        {
+            if(used[receive[i]])
+                return true;
+            used[receive[i]] = true;
+        }
+    }
+    return false;
+}
 #endif
 
 CpGridData::~CpGridData()
 {
 #if HAVE_MPI
-    // code deactivated, because users cannot access face indices and therefore
-    // communication on faces makes no sense!
-    //freeInterfaces(face_interfaces_);
+    freeInterfaces(face_interfaces_);
     freeInterfaces(point_interfaces_);
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if(!finalized)
+    {
+        for(auto& interface : cell_block_interfaces_)
+            for(auto& neighbor : interface.second.neighbors)
+            {
+                MPI_Type_free(&neighbor.first);
+                MPI_Type_free(&neighbor.second);
+            }
+        if(neighbor_comm_ != MPI_COMM_NULL)
+            MPI_Comm_free(&neighbor_comm_);
+        if(p2p_comm_ != MPI_COMM_NULL)
+            MPI_Comm_free(&p2p_comm_);
+    }
 #endif
     delete index_set_;
     delete local_id_set_;
@@ -105,6 +211,162 @@ CpGridData::~CpGridData()
     delete partition_type_indicator_;
 }
 
+MemoryUsage CpGridData::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.add("cell_to_face", cell_to_face_.allocatedBytes());
+    usage.add("face_to_cell", face_to_cell_.allocatedBytes());
+    usage.add("face_to_point", face_to_point_.allocatedBytes());
+    usage.add("cell_to_point", vectorBytes(cell_to_point_));
+    const auto& cell_geom = geometry_.geomVector<0>();
+    const auto& face_geom = geometry_.geomVector<1>();
+    const auto& point_geom = geometry_.geomVector<3>();
+    usage.add("geometry", cell_geom.capacity()*sizeof(Geometry<3, 3>)
+              + face_geom.capacity()*sizeof(Geometry<2, 3>)
+              + point_geom.capacity()*sizeof(Geometry<0, 3>));
+    usage.add("face_tags", face_tag_.capacity()*sizeof(enum face_tag));
+    usage.add("face_normals", face_normals_.capacity()*sizeof(PointType));
+    usage.add("boundary_ids", unique_boundary_ids_.capacity()*sizeof(int));
+    usage.add("global_cell", vectorBytes(global_cell_));
+    usage.add("zcorn", vectorBytes(zcorn));
+    usage.add("index_and_id_sets", sizeof(IndexSet) + sizeof(IdSet) + sizeof(LevelGlobalIdSet)
+              + vectorBytes(global_id_set_->getMapping<0>())
+              + vectorBytes(global_id_set_->getMapping<1>())
+              + vectorBytes(global_id_set_->getMapping<3>()));
+    usage.add("partition_type_indicator", vectorBytes(partition_type_indicator_->cell_indicator_)
+              + vectorBytes(partition_type_indicator_->point_indicator_));
+#if HAVE_MPI
+    usage.add("parallel_index_set", cell_indexset_.size()*sizeof(ParallelIndexSet::IndexPair));
+    std::size_t remote_bytes = 0;
+    for (const auto& rank_lists : cell_remote_indices_) {
+        // The lists hold one node with a next pointer per remote index.
+        const std::size_t entry_bytes = sizeof(RemoteIndices::RemoteIndex) + sizeof(void*);
+        remote_bytes += rank_lists.second.first->size() * entry_bytes;
+        if (rank_lists.second.second != rank_lists.second.first) {
+            remote_bytes += rank_lists.second.second->size() * entry_bytes;
+        }
+    }
+    usage.add("remote_indices", remote_bytes);
+    usage.add("interfaces",
+              interfaceBytes(std::get<0>(cell_interfaces_).interfaces())
+              + interfaceBytes(std::get<1>(cell_interfaces_).interfaces())
+              + interfaceBytes(std::get<2>(cell_interfaces_).interfaces())
+              + interfaceBytes(std::get<3>(cell_interfaces_).interfaces())
+              + interfaceBytes(std::get<4>(cell_interfaces_).interfaces())
+              + interfaceBytes(std::get<0>(face_interfaces_))
+              + interfaceBytes(std::get<1>(face_interfaces_))
+              + interfaceBytes(std::get<2>(face_interfaces_))
+              + interfaceBytes(std::get<3>(face_interfaces_))
+              + interfaceBytes(std::get<4>(face_interfaces_))
+              + interfaceBytes(std::get<0>(point_interfaces_))
+              + interfaceBytes(std::get<1>(point_interfaces_))
+              + interfaceBytes(std::get<2>(point_interfaces_))
+              + interfaceBytes(std::get<3>(point_interfaces_))
+              + interfaceBytes(std::get<4>(point_interfaces_)));
+#endif
+    return usage;
+}
+
+void CpGridData::communicateCellValues(double* values, int block_size, InterfaceType iftype,
+                                       CommunicationDirection dir, CommunicationStatistics* statistics)
+{
+#if HAVE_MPI
+    const auto& interface = getInterface(iftype, cell_interfaces_).interfaces();
+    const auto key = std::make_pair(int(iftype), block_size);
+    auto cached = cell_block_interfaces_.find(key);
+    if(cached == cell_block_interfaces_.end())
+    {
+        CellBlockInterface block_interface;
+        // The displacements of the indexed datatypes are ints.
+        const bool fits = std::size_t(size(0)) * block_size
+            <= std::size_t(std::numeric_limits<int>::max());
+        std::array<int, 2> use_handle = {{ !fits || overlappingLists(interface, true, size(0)),
+                                           !fits || overlappingLists(interface, false, size(0)) }};
+        // All ranks have to take the same path.
+        ccobj_.max(use_handle.data(), use_handle.size());
+        block_interface.use_handle = {{ use_handle[0] != 0, use_handle[1] != 0 }};
+        if(fits && !(use_handle[0] && use_handle[1]))
+        {
+            for(const auto& neighbor : interface)
+                block_interface.neighbors.push_back({ neighbor.first,
+                                                      cellBlockDatatype(neighbor.second.first, block_size),
+                                                      cellBlockDatatype(neighbor.second.second, block_size) });
+        }
+        pointToPointCommunicator();
+        cached = cell_block_interfaces_.emplace(key, std::move(block_interface)).first;
+    }
+
+    const bool forward = dir == ForwardCommunication;
+    if(cached->second.use_handle[forward ? 0 : 1])
+    {
+        CellBlockDataHandle handle(values, block_size);
+        CommunicationOptions options;
+        options.statistics = statistics;
+        communicate(handle, iftype, dir, options);
+        return;
+    }
+    Opm::CommunicationCounters* counters = nullptr;
+    if(statistics)
+    {
+        counters = &statistics->counters("communicate", CommunicationStatistics::interfaceName(iftype),
+                                         "cell values");
+        counters->calls += 1.0;
+        counters->neighbors = std::max(counters->neighbors, double(interface.size()));
+        for(const auto& neighbor : interface)
+        {
+            const auto& send_list = forward ? neighbor.second.first : neighbor.second.second;
+            if(send_list.size())
+                counters->addMessage<double>(send_list.size() * block_size);
+        }
+    }
+    Opm::CommunicationTimer timer(counters ? &counters->wait_seconds : nullptr);
+    std::vector<MPI_Request> requests(2*cached->second.neighbors.size());
+    auto request = requests.begin();
+    for(const auto& neighbor : cached->second.neighbors)
+    {
+        MPI_Irecv(values, 1, forward ? neighbor.second : neighbor.first, neighbor.rank,
+                  cell_values_tag, p2p_comm_, &*request++);
+    }
+    for(const auto& neighbor : cached->second.neighbors)
+    {
+        MPI_Isend(values, 1, forward ? neighbor.first : neighbor.second, neighbor.rank,
+                  cell_values_tag, p2p_comm_, &*request++);
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#else
+    (void) values;
+    (void) block_size;
+    (void) iftype;
+    (void) dir;
+    (void) statistics;
+#endif
+}
+
+#if HAVE_MPI
+MPI_Comm CpGridData::pointToPointCommunicator()
+{
+    if(p2p_comm_ == MPI_COMM_NULL)
+        MPI_Comm_dup(ccobj_, &p2p_comm_);
+    return p2p_comm_;
+}
+
+MPI_Comm CpGridData::neighborCommunicator()
+{
+    if(neighbor_comm_ == MPI_COMM_NULL)
+    {
+        // All other interfaces, also those of faces and points, only
+        // contain ranks of this one.
+        for(const auto& neighbor : std::get<All_All_Interface>(cell_interfaces_).interfaces())
+            neighbor_ranks_.push_back(neighbor.first);
+        const int degree = neighbor_ranks_.size();
+        MPI_Dist_graph_create_adjacent(ccobj_, degree, neighbor_ranks_.data(), MPI_UNWEIGHTED,
+                                       degree, neighbor_ranks_.data(), MPI_UNWEIGHTED,
+                                       MPI_INFO_NULL, false, &neighbor_comm_);
+    }
+    return neighbor_comm_;
+}
+#endif
+
 void CpGridData::populateGlobalCellIndexSet()
 {
 #if HAVE_MPI
@@ -199,21 +461,6 @@ int setupAndCountGlobalIds(const std::vector<int>& indicator, std::vector<int>&
     return count;
 }
 
-template<class T>
-struct GetRowType
-{};
-
-template<class T>
-struct GetRowType<Opm::SparseTable<T> >
-{
-    typedef typename Opm::SparseTable<T>::row_type type;
-};
-template<class E, class A>
-struct GetRowType<std::vector<E,A> >
-{
-    typedef typename std::vector<E,A>::value_type type;
-};
-
 PartitionType getPartitionType(const PartitionTypeIndicator& p, const EntityRep<1>& f,
                                const CpGridData&)
 {
@@ -949,13 +1196,26 @@ private:
     const IndexSet& global2Local_;
 };
 
+/// \brief The partition type of an entity on this and on another process.
+struct EntityAttribute
+{
+    /// \brief The local index of the entity.
+    int index;
+    /// \brief The rank of the other process.
+    int rank;
+    /// \brief The partition type on this process.
+    char mine;
+    /// \brief The partition type on the other process.
+    char other;
+};
+
 template<class T>
 struct AttributeDataHandle
 {
     typedef std::pair<int,char> DataType;
 
     AttributeDataHandle(int rank, const PartitionTypeIndicator& indicator,
-                        std::vector<std::map<int, char> >& vals,
+                        std::vector<EntityAttribute>& vals,
                         const T& cell_to_entity,
                         const CpGridData& grid)
         : rank_(rank), indicator_(indicator), vals_(vals),
@@ -963,7 +1223,8 @@ struct AttributeDataHandle
     {}
     bool fixedsize()
     {
-        return true;
+        // Cells have eight points, but their number of faces varies.
+        return !std::is_same<T, Opm::SparseTable<EntityRep<1> > >::value;
     }
     std::size_t size(std::size_t i)
     {
@@ -972,8 +1233,8 @@ struct AttributeDataHandle
     template<class B>
     void gather(B& buffer, std::size_t i)
     {
-        typedef typename GetRowType<T>::type::const_iterator RowIter;
-        for(RowIter f=c2e_[i].begin(), fend=c2e_[i].end();
+        const auto& row = c2e_[i];
+        for(auto f=row.begin(), fend=row.end();
             f!=fend; ++f)
         {
             char t=getPartitionType(indicator_, *f, grid_);
@@ -984,77 +1245,24 @@ struct AttributeDataHandle
     template<class B>
     void scatter(B& buffer, std::size_t i, std::size_t s)
     {
-        typedef typename GetRowType<T>::type::const_iterator RowIter;
-        for(RowIter f=c2e_[i].begin(), fend=c2e_[i].end();
+        const auto& row = c2e_[i];
+        for(auto f=row.begin(), fend=row.end();
             f!=fend; ++f, --s)
         {
             std::pair<int,char> rank_attr;
             buffer.read(rank_attr);
-            vals_[getIndex(f)].insert(rank_attr);
+            char t=getPartitionType(indicator_, *f, grid_);
+            vals_.push_back({getIndex(f), rank_attr.first, t, rank_attr.second});
         }
     }
     int rank_;
     const PartitionTypeIndicator& indicator_;
-    std::vector<std::map<int, char> >& vals_;
+    std::vector<EntityAttribute>& vals_;
     const T& c2e_;
     const CpGridData& grid_;
 };
 
 
-template<class T, class Functor, class FromSet, class ToSet>
-struct InterfaceFunctor
-{
-    InterfaceFunctor(std::map<int,std::pair<T,T> >& m)
-        : map_(m)
-    {}
-    void operator()(int rank, std::size_t index, PartitionType mine, PartitionType other)
-    {
-        if(from.contains(mine) && to.contains(other))
-            func(map_[rank].first, index);
-        if(from.contains(other) && to.contains(mine))
-            func(map_[rank].second, index);
-    }
-    std::map<int,std::pair<T,T> >& map_;
-    FromSet from;
-    ToSet   to;
-    Functor func;
-};
-
-struct InterfaceIncrementor
-{
-    template<class T>
-    void operator()(T& t, std::size_t)
-    {
-        ++t;
-    }
-};
-
-struct InterfaceAdder
-{
-    void operator()(InterfaceInformation& info, std::size_t index)
-    {
-        info.add(index);
-    }
-};
-
-template<class Tuple>
-struct InterfaceTupleFunctor
-{
-    InterfaceTupleFunctor(Tuple& t)
-    : t_(t)
-    {}
-
-    void operator()(int rank, std::size_t index, PartitionType mine, PartitionType other)
-    {
-        std::get<0>(t_)(rank, index, mine, other);
-        std::get<1>(t_)(rank, index, mine, other);
-        std::get<2>(t_)(rank, index, mine, other);
-        std::get<3>(t_)(rank, index, mine, other);
-        std::get<4>(t_)(rank, index, mine, other);
-    }
-    Tuple& t_;
-};
-
 struct Converter
 {
     typedef EnumItem<PartitionType, InteriorEntity> Interior;
@@ -1071,168 +1279,112 @@ struct Converter
 };
 
 /**
- * \brief Reserves space for an interface.
- * \tparam i The index of the interface.
- * \param sizes A vector with the sizes of the interface for each neighboring rank.
- * \param interface The communication interfaces.
- */
-template<std::size_t i, class InterfaceMap>
-void reserve(const std::vector<std::map<int,std::pair<std::size_t,std::size_t> > >& sizes,
-             std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>&
-             interfaces)
-{
-    typedef typename std::map<int,std::pair<std::size_t,std::size_t> >::const_iterator Iter;
-    const std::map<int,std::pair<std::size_t,std::size_t> >& sizeMap=sizes[i];
-    InterfaceMap& interfaceMap=std::get<i>(interfaces);
-
-    for(Iter iter=sizeMap.begin(), end =sizeMap.end(); iter!=end; ++iter)
-    {
-        std::pair<InterfaceInformation,InterfaceInformation>& interface=interfaceMap[iter->first];
-        interface.first.reserve(iter->second.first);
-        interface.second.reserve(iter->second.second);
-    }
-}
-
-/**
- * \brief Reserves space for the interfaces.
- * \param sizes A vector with the sizes of the interface for each neighboring rank.
- * \param interface The communication interfaces.
+ * \brief Sorts the attributes by rank and index and removes duplicates.
+ *
+ * Uses a stable counting sort by index followed by one by rank. An entity
+ * is received once per cell containing it, of these copies the first one
+ * is kept.
+ * \param[in,out] attributes The attributes as received.
+ * \param num_entities The number of entities on this process.
  */
-template<class InterfaceMap>
-void reserve(const std::vector<std::map<int,std::pair<std::size_t,std::size_t> > >& sizes,
-             std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>&
-             interfaces)
+void sortAttributes(std::vector<EntityAttribute>& attributes, std::size_t num_entities)
 {
-    reserve<0>(sizes, interfaces);
-    reserve<1>(sizes, interfaces);
-    reserve<2>(sizes, interfaces);
-    reserve<3>(sizes, interfaces);
-    reserve<4>(sizes, interfaces);
+    std::vector<EntityAttribute> by_index(attributes.size());
+    std::vector<std::size_t> offsets(num_entities + 1, 0);
+    for(const auto& a : attributes)
+        ++offsets[a.index + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for(const auto& a : attributes)
+        by_index[offsets[a.index]++] = a;
+
+    // Number the few neighboring ranks consecutively.
+    std::vector<int> ranks;
+    for(const auto& a : by_index)
+    {
+        auto r = std::lower_bound(ranks.begin(), ranks.end(), a.rank);
+        if(r == ranks.end() || *r != a.rank)
+            ranks.insert(r, a.rank);
+    }
+    auto rankNumber = [&ranks](int rank) {
+        return std::lower_bound(ranks.begin(), ranks.end(), rank) - ranks.begin();
+    };
+    offsets.assign(ranks.size() + 1, 0);
+    for(const auto& a : by_index)
+        ++offsets[rankNumber(a.rank) + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for(const auto& a : by_index)
+        attributes[offsets[rankNumber(a.rank)]++] = a;
+
+    auto end = std::unique(attributes.begin(), attributes.end(),
+                           [](const EntityAttribute& a, const EntityAttribute& b) {
+                               return a.rank == b.rank && a.index == b.index;
+                           });
+    attributes.erase(end, attributes.end());
 }
 
 /**
- * \brief A functor that calculates the size of the interface.
- * \tparam i The indentifier of the interface.
- */
-template<std::size_t i>
-struct SizeFunctor :
-    public InterfaceFunctor<std::size_t, InterfaceIncrementor,
-                            typename std::tuple_element<i,typename Converter::SourceTuple>::type,
-                            typename std::tuple_element<i,typename Converter::DestinationTuple>::type>
-{
-    typedef InterfaceFunctor<std::size_t, InterfaceIncrementor,
-                             typename std::tuple_element<i,typename Converter::SourceTuple>::type,
-                             typename std::tuple_element<i,typename Converter::DestinationTuple>::type>
-    Base;
-    SizeFunctor(std::map<int,std::pair<std::size_t,std::size_t> >& m)
-        :Base(m)
-    {}
-};
-
-/**
- * \brief A functor that adds indices to the interface.
- * \tparam i The indentifier of the interface.
- */
-template<std::size_t i>
-struct AddFunctor :
-    public InterfaceFunctor<InterfaceInformation, InterfaceAdder,
-                             typename std::tuple_element<i,typename Converter::SourceTuple>::type,
-                             typename std::tuple_element<i,typename Converter::DestinationTuple>::type>
-{
-    typedef InterfaceFunctor<InterfaceInformation, InterfaceAdder,
-                             typename std::tuple_element<i,typename Converter::SourceTuple>::type,
-                             typename std::tuple_element<i,typename Converter::DestinationTuple>::type>
-    Base;
-    AddFunctor(std::map<int,std::pair<InterfaceInformation,InterfaceInformation> >& m)
-        : Base(m)
-    {}
-};
-
-class FacePartitionTypeIterator
-{
-public:
-    FacePartitionTypeIterator(const PartitionTypeIndicator* part)
-    : indicator_(part), index_()
-    {}
-    void operator++()
-    {
-        ++index_;
-    }
-    PartitionType operator*()
-    {
-        return indicator_->getFacePartitionType(index_);
-    }
-private:
-    const PartitionTypeIndicator* indicator_;
-    int index_;
-};
-
-
-/**
- * \brief Applies a functor the each pair of the interface.
- * \tparam Functor The type of the functor to apply.
- * \param attributes[in] A vector that contains for each index a map from other
- * process ranks to the attribute there.
- * \param my_attributes[in] A vector with the attributes of each index on this process.
- * \param func The functor.
+ * \brief Adds the entities shared with another process to an interface.
+ * \tparam i The index of the interface.
+ * \param rank The rank of the other process.
+ * \param begin, end The attributes of the shared entities, sorted by index.
+ * \param[out] interfaces The communication interfaces.
  */
-template<class Functor, class T>
-void iterate_over_attributes(std::vector<std::map<int,char> >& attributes,
-                             T my_attribute_iter, Functor& func)
+template<std::size_t i, class Iter, class InterfaceMap>
+void addToInterface(int rank, Iter begin, Iter end,
+                    std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>&
+                    interfaces)
 {
-    typedef typename std::vector<std::map<int,char> >::const_iterator Iter;
-    for(Iter begin=attributes.begin(), i=begin, end=attributes.end(); i!=end;
-        ++i, ++my_attribute_iter)
-    {
-        typedef typename std::map<int,char>::const_iterator MIter;
-        for(MIter m=i->begin(), mend=i->end(); m!=mend; ++m)
-        {
-            func(m->first,i-begin,PartitionType(*my_attribute_iter), PartitionType(m->second));
-        }
+    typedef typename std::tuple_element<i,typename Converter::SourceTuple>::type FromSet;
+    typedef typename std::tuple_element<i,typename Converter::DestinationTuple>::type ToSet;
+    std::size_t send_size = 0, receive_size = 0;
+    for(Iter a = begin; a != end; ++a)
+    {
+        const PartitionType mine = PartitionType(a->mine), other = PartitionType(a->other);
+        if(FromSet::contains(mine) && ToSet::contains(other))
+            ++send_size;
+        if(FromSet::contains(other) && ToSet::contains(mine))
+            ++receive_size;
+    }
+    if(send_size == 0 && receive_size == 0)
+        return;
+
+    std::pair<InterfaceInformation,InterfaceInformation>& interface=std::get<i>(interfaces)[rank];
+    interface.first.reserve(send_size);
+    interface.second.reserve(receive_size);
+    for(Iter a = begin; a != end; ++a)
+    {
+        const PartitionType mine = PartitionType(a->mine), other = PartitionType(a->other);
+        if(FromSet::contains(mine) && ToSet::contains(other))
+            interface.first.add(a->index);
+        if(FromSet::contains(other) && ToSet::contains(mine))
+            interface.second.add(a->index);
     }
 }
 
-
 /**
  * \brief Creates the communication interface for either faces or points.
- * \param attributes[in] A vector that contains for each index a map from other
- * process ranks to the attribute there.
- * \param my_attributes[in] A vector with the attributes of each index on this process.
+ * \param[in,out] attributes The attributes of the entities present on other
+ * processes as received. Sorted by rank and index on return.
+ * \param num_entities The number of entities on this process.
  * \param[out] interfaces The tuple with the interface maps for communication.
  */
-template<class InterfaceMap,class T>
-void createInterfaces(std::vector<std::map<int,char> >& attributes,
-                      T partition_type_iterator,
+template<class InterfaceMap>
+void createInterfaces(std::vector<EntityAttribute>& attributes, std::size_t num_entities,
                       std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>&
                       interfaces)
 {
-    // calculate sizes
-    std::vector<std::map<int,std::pair<std::size_t,std::size_t> > > sizes(5);
-    typedef std::tuple<SizeFunctor<0>,SizeFunctor<1>,SizeFunctor<2>,SizeFunctor<3>,
-                       SizeFunctor<4> > SizeTuple;
-
-    SizeTuple
-    size_functor_tuple = std::make_tuple(SizeFunctor<0>(sizes[0]),
-                                         SizeFunctor<1>(sizes[1]),
-                                         SizeFunctor<2>(sizes[2]),
-                                         SizeFunctor<3>(sizes[3]),
-                                         SizeFunctor<4>(sizes[4]));
-    InterfaceTupleFunctor<SizeTuple> size_functor(size_functor_tuple);
-    iterate_over_attributes(attributes, partition_type_iterator, size_functor);
-    // reserve space
-    reserve(sizes, interfaces);
-    // add indices to the interface
-    typedef std::tuple<AddFunctor<0>,AddFunctor<1>,AddFunctor<2>,AddFunctor<3>,
-                       AddFunctor<4> > AddTuple;
-    AddTuple
-        add_functor_tuple(AddFunctor<0>(std::get<0>(interfaces)),
-                          AddFunctor<1>(std::get<1>(interfaces)),
-                          AddFunctor<2>(std::get<2>(interfaces)),
-                          AddFunctor<3>(std::get<3>(interfaces)),
-                          AddFunctor<4>(std::get<4>(interfaces)));
-    InterfaceTupleFunctor<AddTuple> add_functor(add_functor_tuple);
-    iterate_over_attributes(attributes, partition_type_iterator, add_functor);
-
+    sortAttributes(attributes, num_entities);
+    for(auto begin = attributes.cbegin(), end = begin; begin != attributes.cend(); begin = end)
+    {
+        const int rank = begin->rank;
+        end = std::find_if(begin, attributes.cend(),
+                           [rank](const EntityAttribute& a) { return a.rank != rank; });
+        addToInterface<0>(rank, begin, end, interfaces);
+        addToInterface<1>(rank, begin, end, interfaces);
+        addToInterface<2>(rank, begin, end, interfaces);
+        addToInterface<3>(rank, begin, end, interfaces);
+        addToInterface<4>(rank, begin, end, interfaces);
+    }
 }
 
 void CpGridData::computeGeometry(CpGrid& grid,
@@ -1523,12 +1675,37 @@ std::map<int,int> computeCell2Point(CpGrid& grid,
 
 void CpGridData::distributeGlobalGrid(CpGrid& grid,
                                       const CpGridData& view_data,
-                                      const std::vector<int>& /* cell_part */)
+                                      const std::vector<int>& /* cell_part */,
+                                      const std::vector<std::tuple<int,int,char>>* remote_cells)
 {
 #if HAVE_MPI
+    ConstructionTimings::Phase phase(*timings_, "distributeGlobalGrid");
     // setup the remote indices.
-    cell_remote_indices_.setIndexSets(cell_indexset_, cell_indexset_, ccobj_);
-    cell_remote_indices_.template rebuild<false>(); // We could probably also compute this on our own, like before?
+    {
+        ConstructionTimings::Phase remote_phase(*timings_, "cellRemoteIndices");
+        cell_remote_indices_.setIndexSets(cell_indexset_, cell_indexset_, ccobj_);
+        if (remote_cells)
+        {
+            // The remote cells are known from the partitioning. Source and
+            // target index set are the same, hence one list per rank is
+            // used for sending and receiving.
+            for (auto begin = remote_cells->begin(); begin != remote_cells->end();)
+            {
+                const int rank = std::get<1>(*begin);
+                auto modifier = cell_remote_indices_.template getModifier<false, true>(rank);
+                for (; begin != remote_cells->end() && std::get<1>(*begin) == rank; ++begin)
+                {
+                    modifier.insert(RemoteIndices::RemoteIndex(AttributeSet(std::get<2>(*begin)),
+                                                               &cell_indexset_.at(std::get<0>(*begin))));
+                }
+            }
+        }
+        else
+        {
+            cell_remote_indices_.template rebuild<false>();
+        }
+        remote_phase.setCounts(cell_indexset_.size(), -1, -1);
+    }
 
     // We can identify existing cells with the help of the index set.
     // Now we need to compute the existing faces and points. Either exist
@@ -1574,6 +1751,10 @@ void CpGridData::distributeGlobalGrid(CpGrid& grid,
     geometry_.geomVector(std::integral_constant<int,0>()).resize(cell_to_face_.size());
     geometry_.geomVector(std::integral_constant<int,3>()).resize(noExistingPoints);
 
+    // The distributed geometry and normals are copied from the global ones.
+    if (view_data.deferred_geometry_) {
+        view_data.computeDeferredGeometry(0);
+    }
     computeGeometry(grid, view_data.geometry_, view_data.cell_to_face_,
                     geometry_, cell_to_face_, cell_to_point_);
 
@@ -1662,33 +1843,37 @@ void CpGridData::distributeGlobalGrid(CpGrid& grid,
     Communicator comm(all_all_cell_interface.communicator(),
                      all_all_cell_interface.interfaces());
 
-    /*
-      // code deactivated, because users cannot access face indices and therefore
-      // communication on faces makes no sense!
-    std::vector<std::map<int,char> > face_attributes(noExistingFaces);
-    AttributeDataHandle<Opm::SparseTable<EntityRep<1> > >
-        face_handle(ccobj_.rank(), *partition_type_indicator_,
-                    face_attributes, static_cast<Opm::SparseTable<EntityRep<1> >&>(cell_to_face_),
-                    *this);
-    if( std::get<All_All_Interface>(cell_interfaces_).interfaces().size() )
-    {
-        comm.forward(face_handle);
-    }
-    createInterfaces(face_attributes, FacePartitionTypeIterator(partition_type_indicator_),
-                     face_interfaces_);
-    std::vector<std::map<int,char> >().swap(face_attributes);
-    */
-    std::vector<std::map<int,char> > point_attributes(noExistingPoints);
-    AttributeDataHandle<std::vector<std::array<int,8> > >
-        point_handle(ccobj_.rank(), *partition_type_indicator_,
-                     point_attributes, cell_to_point_, *this);
-    if( static_cast<const Dune::Interface&>(std::get<All_All_Interface>(cell_interfaces_))
-        .interfaces().size() )
-    {
-        comm.forward(point_handle);
-    }
-    createInterfaces(point_attributes, partition_type_indicator_->point_indicator_.begin(),
-                     point_interfaces_);
+    // Records of (entity, rank, attributes) instead of a map per entity.
+    std::vector<EntityAttribute> attributes;
+    {
+        ConstructionTimings::Phase face_phase(*timings_, "faceInterfaces");
+        AttributeDataHandle<Opm::SparseTable<EntityRep<1> > >
+            face_handle(ccobj_.rank(), *partition_type_indicator_,
+                        attributes, static_cast<const Opm::SparseTable<EntityRep<1> >&>(cell_to_face_),
+                        *this);
+        if( static_cast<const Dune::Interface&>(std::get<All_All_Interface>(cell_interfaces_))
+            .interfaces().size() )
+        {
+            comm.forward(face_handle);
+        }
+        createInterfaces(attributes, noExistingFaces, face_interfaces_);
+        face_phase.setCounts(-1, noExistingFaces, -1);
+    }
+    attributes.clear();
+    {
+        ConstructionTimings::Phase point_phase(*timings_, "pointInterfaces");
+        AttributeDataHandle<std::vector<std::array<int,8> > >
+            point_handle(ccobj_.rank(), *partition_type_indicator_,
+                         attributes, cell_to_point_, *this);
+        if( static_cast<const Dune::Interface&>(std::get<All_All_Interface>(cell_interfaces_))
+            .interfaces().size() )
+        {
+            comm.forward(point_handle);
+        }
+        createInterfaces(attributes, noExistingPoints, point_interfaces_);
+        point_phase.setCounts(-1, -1, noExistingPoints);
+    }
+    phase.setCounts(size(0), face_to_cell_.size(), size(3));
 #else // #if HAVE_MPI
     static_cast<void>(grid);
     static_cast<void>(view_data);
@@ -66,9 +66,11 @@
 #include <dune/common/parallel/plocalindex.hh>
 #if DUNE_VERSION_NEWER(DUNE_GRID, 2, 7)
 #include <dune/common/parallel/variablesizecommunicator.hh>
-#else
-#include <opm/grid/utility/VariableSizeCommunicator.hpp>
 #endif
+// Also used with newer DUNE versions when counting the communication.
+#include <opm/grid/utility/VariableSizeCommunicator.hpp>
+#include <opm/grid/utility/ThreadedPackCommunicator.hpp>
+#include <dune/common/classname.hh>
 #include <dune/grid/common/gridenums.hh>
 
 #include <opm/grid/utility/platform_dependent/reenable_warnings.h>
@@ -78,10 +80,19 @@
 #endif
 
 #include <array>
+#include <map>
 #include <tuple>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
+#include "CommunicationStatistics.hpp"
+#include "ConstructionTimings.hpp"
+#include "MemoryUsage.hpp"
 #include "OrientedEntityTable.hpp"
 #include "DefaultGeometryPolicy.hpp"
 #include <opm/grid/cpgpreprocess/preprocess.h>
@@ -115,6 +126,20 @@ namespace mover
 template<class T, int i> struct Mover;
 }
 
+/// \brief How CpGridData::communicate() exchanges the data.
+struct CommunicationOptions
+{
+    /// \brief If positive, the messages are packed and unpacked by threads
+    ///        in chunks of this many entities.
+    std::size_t pack_chunk_size = 0;
+    /// \brief Whether to exchange with neighborhood collectives on a graph
+    ///        communicator of the neighboring ranks.
+    bool neighbor_collectives = false;
+    /// \brief If not null, the messages, bytes and times of communicate(),
+    ///        scatterData() and gatherData() are added to these statistics.
+    CommunicationStatistics* statistics = nullptr;
+};
+
 /**
  * @brief Struct that hods all the data needed to represent a
  * Cpgrid.
@@ -181,6 +206,24 @@ public:
     /// found in <grid_prefix>-topo.dat etc.
     void writeSintefLegacyFormat(const std::string& grid_prefix) const;
 
+    /// Create a tensor-product grid with vertical pillars.
+    ///
+    /// Topology and geometry are set up directly in closed form, the
+    /// result is the same as processing the equivalent grdecl data
+    /// (up to rounding in the geometry).
+    /// \param coordinates the strictly increasing node coordinates along
+    ///        each cartesian direction, i.e. dims[d] + 1 values for
+    ///        direction d.
+    void createCartesian(const std::array<std::vector<double>, 3>& coordinates);
+
+    /// Check the node coordinates passed to createCartesian().
+    ///
+    /// Throws std::invalid_argument if a direction has no cell, the
+    /// coordinates are not strictly increasing or the grid would be too
+    /// large for the index types. Does not communicate, so every rank
+    /// can call it before only the root builds the grid.
+    static void checkCartesianCoordinates(const std::array<std::vector<double>, 3>& coordinates);
+
     /// Read the Eclipse grid format ('grdecl').
     /// \param filename the name of the file to read.
     /// \param periodic_extension if true, the grid will be (possibly) refined, so that
@@ -220,12 +263,14 @@ public:
     /// \param ecl_state the object from opm-parser provide information regarding to pore volume, NNC,
     ///        aquifer information when ecl_state is available. NNC and aquifer connection
     ///        information will also be updated during the function call when available and necessary.
-    /// \param nnc is the non-neighboring connections
+    /// \param nnc is the non-neighboring connections as pairs of cartesian
+    ///        cell indices, the pinch connections first and the explicit
+    ///        ones second. The lists are sorted and made unique here.
     /// \param remove_ij_boundary if true, will remove (i, j) boundaries. Used internally.
     /// \param pinchActive If true, we will add faces between vertical cells that have only inactive cells or cells
     ///            with zero volume between them. If false these cells will not be connected.
     void processEclipseFormat(const grdecl& input_data, Opm::EclipseState* ecl_state,
-                              std::array<std::set<std::pair<int, int>>, 2>& nnc,
+                              std::array<std::vector<std::pair<int, int>>, 2>& nnc,
                               bool remove_ij_boundary, bool turn_normals, bool pinchActive);
 
     /// @brief
@@ -264,6 +309,17 @@ public:
         }
     }
 
+    /// \brief Set whether processEclipseFormat() defers the face and
+    ///        cell geometry.
+    ///
+    /// With deferred geometry the construction computes the topology
+    /// and the points only. The face geometry and normals are computed
+    /// on their first access, and the cell geometry on its first access.
+    void setLazyGeometry(bool lazy)
+    {
+        lazy_geometry_ = lazy;
+    }
+
     /// Return the internalized zcorn copy from the grid processing, if
     /// no cells were adjusted during the minpvprocessing this can be
     /// and empty vector.
@@ -286,20 +342,74 @@ public:
         return logical_cartesian_size_;
     }
 
+    /// \brief The bytes held by the components of this grid view.
+    ///
+    /// Covers the topology and geometry, the index and id sets, and
+    /// in a parallel run the parallel index set, the remote indices
+    /// and the communication interfaces.
+    MemoryUsage memoryUsage() const;
+
     /// \brief Redistribute a global grid.
     ///
     /// The whole grid must be available on all processors.
+    /// \param remote_cells The cells of this process that are also present on
+    ///        other processes, as computed by computeRemoteCells. Each entry
+    ///        is a tuple of global index, rank of the other process and attribute
+    ///        there, sorted by rank and global index. Used to set up the remote
+    ///        indices of the cells without communication. If nullptr, then the
+    ///        remote indices are rebuilt.
     void distributeGlobalGrid(CpGrid& grid,
                               const CpGridData& view_data,
-                              const std::vector<int>& cell_part);
+                              const std::vector<int>& cell_part,
+                              const std::vector<std::tuple<int,int,char>>* remote_cells = nullptr);
 
     /// \brief communicate objects for all codims on a given level
     /// \param data The data handle describing the data. Has to adhere to the
     /// Dune::DataHandleIF interface.
     /// \param iftype The interface to use for the communication.
     /// \param dir The direction of the communication along the interface (forward or backward).
+    /// \param options Whether to pack with threads or use neighborhood
+    ///        collectives, see ThreadedPackCommunicator.
     template<class DataHandle>
-    void communicate(DataHandle& data, InterfaceType iftype, CommunicationDirection dir);
+    void communicate(DataHandle& data, InterfaceType iftype, CommunicationDirection dir,
+                     const CommunicationOptions& options = {});
+
+    /// \brief Communicate a block of values per cell stored contiguously.
+    ///
+    /// MPI reads and writes the values directly through indexed datatypes
+    /// over the cell interface, which are created on first use and cached.
+    /// Interfaces where a cell is received more than once, or both sent
+    /// and received, on any rank, and values too many to be addressed by
+    /// int displacements, use the data handle path instead.
+    /// \param values The values of cell i are at [i*block_size, (i+1)*block_size).
+    /// \param block_size The number of values per cell.
+    /// \param iftype The interface to use for the communication.
+    /// \param dir The direction of the communication along the interface.
+    /// \param statistics If not null, the statistics to count the exchange in.
+    void communicateCellValues(double* values, int block_size, InterfaceType iftype,
+                               CommunicationDirection dir,
+                               CommunicationStatistics* statistics = nullptr);
+
+    /// \brief Scatter a block of values per cell of the logical Cartesian
+    ///        grid, read in chunks on one rank, to the cells of all ranks.
+    ///
+    /// The root reads consecutive chunks of Cartesian cells. For each chunk
+    /// the ranks send the Cartesian indices of their cells within it to the
+    /// root, which sends the values of these cells only. Hence the root
+    /// never holds more than about one chunk of values.
+    /// \param read Called on root only, in increasing order, as
+    ///        read(begin, end, chunk) to store the values of the Cartesian
+    ///        cells [begin, end) at chunk[0, (end-begin)*block_size).
+    /// \param values The values of cell i are stored at [i*block_size, (i+1)*block_size).
+    /// \param block_size The number of values per cell.
+    /// \param root The rank reading the values.
+    /// \param max_chunk_size The maximum number of values read at once, but
+    ///        at least one cell. Zero reads all values at once.
+    /// \param statistics If not null, the statistics to count the exchange in.
+    template<class T, class Reader>
+    void scatterCartesianCellValues(Reader& read, T* values, int block_size, int root,
+                                    std::size_t max_chunk_size,
+                                    CommunicationStatistics* statistics = nullptr);
 
 #if HAVE_MPI
 #if DUNE_VERSION_NEWER(DUNE_GRID, 2, 7)
@@ -327,16 +437,30 @@ private:
     /// \brief Adds entries to the parallel index set of the cells during grid construction
     void populateGlobalCellIndexSet();
 
+    /// \brief Compute the face geometry and normals from the points.
+    void computeFaceGeometry(bool turn_normals);
+
+    /// \brief Compute the cell geometry from the points and the face geometry.
+    /// \param aquifer_cell_volumes Volumes replacing the computed ones,
+    ///        by cell index.
+    void computeCellGeometry(const std::unordered_map<std::size_t, double>& aquifer_cell_volumes);
+
+    /// \brief Compute deferred geometry if not done yet.
+    /// \param codim 1 for the faces, 0 for the cells and faces.
+    void computeDeferredGeometry(int codim) const;
+
 #if HAVE_MPI
 
     /// \brief Gather data on a global grid representation.
     /// \param data A data handle for getting or setting the data
     /// \param global_view The view of the global grid (to gather the data on)
     /// \param distributed_view The view of the distributed grid.
+    /// \param statistics If not null, the statistics to count the exchange in.
     /// \tparam DataHandle The type of the data handle used.
     template<class DataHandle>
     void gatherData(DataHandle& data, CpGridData* global_view,
-                    CpGridData* distributed_view);
+                    CpGridData* distributed_view,
+                    CommunicationStatistics* statistics = nullptr);
 
 
     /// \brief Gather data specific to given codimension on a global grid representation.
@@ -344,21 +468,53 @@ private:
     /// \param global_view The view of the global grid (to gather the data on)
     /// \param distributed_view The view of the distributed grid.
     /// \tparam DataHandle The type of the data handle used.
+    /// \param counters If not null, the counters to add the exchange to.
     /// \tparam codim The codimension
     template<int codim, class DataHandle>
     void gatherCodimData(DataHandle& data, CpGridData* global_data,
-                         CpGridData* distributed_data);
+                         CpGridData* distributed_data,
+                         Opm::CommunicationCounters* counters = nullptr);
+
+    /// \brief Gather data on the global grid representation of one rank only.
+    /// \param data A data handle for getting or setting the data
+    /// \param global_view The view of the global grid (to gather the data on)
+    /// \param distributed_view The view of the distributed grid.
+    /// \param root The rank whose global view receives the data. Only
+    ///        rank 0 holds the global grid, hence it has to be 0.
+    /// \param max_chunk_size If positive, the data is streamed to the root in
+    ///        messages of at most this many data items (and entities), but at
+    ///        least one entity. Otherwise it is gathered with MPI_Gatherv.
+    /// \param statistics If not null, the statistics to count the exchange in.
+    /// \tparam DataHandle The type of the data handle used.
+    template<class DataHandle>
+    void gatherDataOnRoot(DataHandle& data, CpGridData* global_view,
+                          CpGridData* distributed_view, int root,
+                          std::size_t max_chunk_size,
+                          CommunicationStatistics* statistics = nullptr);
+
+    /// \brief Gather data specific to given codimension on the global grid
+    ///        representation of one rank only.
+    /// \see gatherDataOnRoot
+    /// \param counters If not null, the counters to add the exchange to.
+    /// \tparam codim The codimension
+    template<int codim, class DataHandle>
+    void gatherCodimDataOnRoot(DataHandle& data, CpGridData* global_data,
+                               CpGridData* distributed_data, int root,
+                               std::size_t max_chunk_size,
+                               Opm::CommunicationCounters* counters = nullptr);
 
     /// \brief Scatter data from a global grid representation
     /// to a distributed representation of the same grid.
     /// \param data A data handle for getting or setting the data
     /// \param global_view The view of the global grid (to gather the data on)
     /// \param distributed_view The view of the distributed grid.
+    /// \param statistics If not null, the statistics to count the exchange in.
     /// \tparam DataHandle The type of the data handle used.
     template<class DataHandle>
     void scatterData(DataHandle& data, CpGridData* global_data,
                      CpGridData* distributed_data, const InterfaceMap& cell_inf,
-                     const InterfaceMap& point_inf);
+                     const InterfaceMap& point_inf,
+                     CommunicationStatistics* statistics = nullptr);
 
     /// \brief Scatter data specific to given codimension from a global grid representation
     /// to a distributed representation of the same grid.
@@ -379,9 +535,12 @@ private:
     ///  and gathering the data.
     /// \param dir The direction of the communication.
     /// \param interface The information about the communication interface
+    /// \param options How to exchange the data.
+    /// \param counters If not null, the counters to add the exchange to.
     template<int codim, class DataHandle>
     void communicateCodim(Entity2IndexDataHandle<DataHandle, codim>& data, CommunicationDirection dir,
-                          const Interface& interface);
+                          const Interface& interface, const CommunicationOptions& options = {},
+                          Opm::CommunicationCounters* counters = nullptr);
 
     /// \brief Communicates data of a given codimension
     /// \tparam codim The codimension
@@ -391,9 +550,22 @@ private:
     ///  and gathering the data.
     /// \param dir The direction of the communication.
     /// \param interface The information about the communication interface
+    /// \param options How to exchange the data.
+    /// \param counters If not null, the counters to add the exchange to.
     template<int codim, class DataHandle>
     void communicateCodim(Entity2IndexDataHandle<DataHandle, codim>& data, CommunicationDirection dir,
-                          const InterfaceMap& interface);
+                          const InterfaceMap& interface, const CommunicationOptions& options = {},
+                          Opm::CommunicationCounters* counters = nullptr);
+
+    /// \brief The distributed graph communicator of the neighbors in the
+    ///        cell interface, created on first use.
+    MPI_Comm neighborCommunicator();
+
+    /// \brief The duplicate of ccobj_ for point-to-point messages,
+    ///        created on first use.
+    ///
+    /// Collective on ccobj_ when called the first time.
+    MPI_Comm pointToPointCommunicator();
 
 #endif
 
@@ -451,6 +623,11 @@ private:
     LevelGlobalIdSet* global_id_set_;
     /** @brief The indicator of the partition type of the entities */
     PartitionTypeIndicator* partition_type_indicator_;
+    /**
+     * @brief If the cells are numbered interior first, the ends of the owned
+     * cells without overlap neighbors and of all owned cells, otherwise -1.
+     */
+    std::array<int, 2> interior_first_ranges_ = {{ -1, -1 }};
 
     /// \brief The type of the collective communication.
     typedef MPIHelper::MPICommunicator MPICommunicator;
@@ -458,9 +635,28 @@ private:
     /// \brief Object for collective communication operations.
     CollectiveCommunication ccobj_;
 
+    /// \brief The timings of the construction phases, shared with the
+    ///        distributed grid data.
+    std::shared_ptr<ConstructionTimings> timings_;
+
     // Boundary information (optional).
     bool use_unique_boundary_ids_;
 
+    /// \brief Whether processEclipseFormat() defers the geometry.
+    bool lazy_geometry_;
+
+    /// \brief What is needed to compute deferred geometry.
+    struct DeferredGeometry
+    {
+        std::once_flag faces;
+        std::once_flag cells;
+        bool turn_normals = false;
+        std::unordered_map<std::size_t, double> aquifer_cell_volumes;
+    };
+
+    /// \brief Set while the face or cell geometry is not computed.
+    std::unique_ptr<DeferredGeometry> deferred_geometry_;
+
     /// This vector contains zcorn values from the initialization
     /// process where a CpGrid instance has been created from
     /// cornerpoint input zcorn and coord. During the initialization
@@ -484,26 +680,75 @@ private:
 
     /// \brief Communication interface for the cells.
     std::tuple<Interface,Interface,Interface,Interface,Interface> cell_interfaces_;
-    /*
-    // code deactivated, because users cannot access face indices and therefore
-    // communication on faces makes no sense!
-    /// \brief Interface from interior and border to interior and border for the faces.
+    /// \brief Communication interfaces for the faces.
     std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>
     face_interfaces_;
-    */
     /// \brief Interface from interior and border to interior and border for the faces.
     std::tuple<InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap,InterfaceMap>
     point_interfaces_;
 
+    /// \brief Indexed datatypes selecting the cell blocks of the lists of a neighbor.
+    struct CellBlockDatatypes
+    {
+        int rank;
+        MPI_Datatype first;
+        MPI_Datatype second;
+    };
+    /// \brief A cell interface for communicateCellValues.
+    struct CellBlockInterface
+    {
+        std::vector<CellBlockDatatypes> neighbors;
+        /// \brief Whether to use the data handle path when communicating
+        ///        forward and backward, as a cell is received twice, or
+        ///        sent and received, on some rank, or the displacements
+        ///        overflow.
+        std::array<bool, 2> use_handle;
+    };
+    /// \brief The cell interfaces for communicateCellValues by interface
+    ///        type and block size.
+    std::map<std::pair<int, int>, CellBlockInterface> cell_block_interfaces_;
+
+    /// \brief The neighbors in the cell interface, sorted.
+    std::vector<int> neighbor_ranks_;
+    /// \brief Graph communicator of the neighbors, MPI_COMM_NULL until used.
+    MPI_Comm neighbor_comm_ = MPI_COMM_NULL;
+    /// \brief Duplicate of ccobj_ for the point-to-point messages of this
+    ///        class, MPI_COMM_NULL until used.
+    ///
+    /// Keeps them apart from those of the user on ccobj_.
+    MPI_Comm p2p_comm_ = MPI_COMM_NULL;
+    /// \brief The tags of the messages on p2p_comm_.
+    ///
+    /// The neighbor collectives and the threaded packing use
+    /// neighbor_comm_ instead.
+    enum PointToPointTag
+    {
+        cell_values_tag,   ///< communicateCellValues()
+        gather_index_tag,  ///< streamed gatherCodimDataOnRoot(), global indices and sizes
+        gather_data_tag    ///< streamed gatherCodimDataOnRoot(), data
+    };
+
 #endif
 
     // Return the geometry vector corresponding to the given codim.
     template <int codim>
     const EntityVariable<Geometry<3 - codim, 3>, codim>& geomVector() const
     {
+        if (codim != 3 && deferred_geometry_) {
+            computeDeferredGeometry(codim);
+        }
         return geometry_.geomVector<codim>();
     }
 
+    // Return the face normals.
+    const SignedEntityVariable<PointType, 1>& faceNormals() const
+    {
+        if (deferred_geometry_) {
+            computeDeferredGeometry(1);
+        }
+        return face_normals_;
+    }
+
     friend class Dune::CpGrid;
     template<int> friend class Entity;
     template<int> friend class EntityRep;
@@ -540,19 +785,70 @@ T& getInterface(InterfaceType iftype,
     OPM_THROW(std::runtime_error, "Invalid Interface type was used during communication");
 }
 
+/// \brief The counters of a method for a data handle type, or nullptr
+///        if there are no statistics.
+///
+/// The key is only built when there are statistics, such that disabled
+/// statistics do not allocate.
+template<class DataHandle>
+Opm::CommunicationCounters* communicationCounters(CommunicationStatistics* statistics,
+                                                  const char* site,
+                                                  const char* interface)
+{
+    if(!statistics)
+        return nullptr;
+    static const std::string handle = Dune::className<DataHandle>();
+    return &statistics->counters(site, interface, handle);
+}
+
 } // end unnamed namespace
 
 template<int codim, class DataHandle>
 void CpGridData::communicateCodim(Entity2IndexDataHandle<DataHandle, codim>& data, CommunicationDirection dir,
-                                  const Interface& interface)
+                                  const Interface& interface, const CommunicationOptions& options,
+                                  Opm::CommunicationCounters* counters)
 {
-    this->template communicateCodim<codim>(data, dir, interface.interfaces());
+    this->template communicateCodim<codim>(data, dir, interface.interfaces(), options, counters);
 }
 
 template<int codim, class DataHandle>
 void CpGridData::communicateCodim(Entity2IndexDataHandle<DataHandle, codim>& data_wrapper, CommunicationDirection dir,
-                                  const InterfaceMap& interface)
+                                  const InterfaceMap& interface, const CommunicationOptions& options,
+                                  Opm::CommunicationCounters* counters)
 {
+    if(options.neighbor_collectives)
+    {
+        Opm::ThreadedPackCommunicator<InterfaceMap> comm(neighborCommunicator(), neighbor_ranks_,
+                                                         interface, options.pack_chunk_size);
+        comm.setCounters(counters);
+        if(dir==ForwardCommunication)
+            comm.forward(data_wrapper);
+        else
+            comm.backward(data_wrapper);
+        return;
+    }
+    if(options.pack_chunk_size > 0)
+    {
+        Opm::ThreadedPackCommunicator<InterfaceMap> comm(ccobj_, interface, options.pack_chunk_size);
+        comm.setCounters(counters);
+        if(dir==ForwardCommunication)
+            comm.forward(data_wrapper);
+        else
+            comm.backward(data_wrapper);
+        return;
+    }
+    if(counters)
+    {
+        // Dune's VariableSizeCommunicator cannot count, hence our copy of
+        // it is used instead when counting.
+        Opm::VariableSizeCommunicator<> comm(ccobj_, interface);
+        comm.setCounters(counters);
+        if(dir==ForwardCommunication)
+            comm.forward(data_wrapper);
+        else
+            comm.backward(data_wrapper);
+        return;
+    }
     Communicator comm(ccobj_, interface);
 
     if(dir==ForwardCommunication)
@@ -564,26 +860,151 @@ void CpGridData::communicateCodim(Entity2IndexDataHandle<DataHandle, codim>& dat
 
 template<class DataHandle>
 void CpGridData::communicate(DataHandle& data, InterfaceType iftype,
-                             CommunicationDirection dir)
+                             CommunicationDirection dir, const CommunicationOptions& options)
 {
 #if HAVE_MPI
+    auto counters = communicationCounters<DataHandle>(options.statistics, "communicate",
+                                                      CommunicationStatistics::interfaceName(iftype));
     if(data.contains(3,0))
     {
         Entity2IndexDataHandle<DataHandle, 0> data_wrapper(*this, data);
-        communicateCodim<0>(data_wrapper, dir, getInterface(iftype, cell_interfaces_));
+        communicateCodim<0>(data_wrapper, dir, getInterface(iftype, cell_interfaces_), options, counters);
+    }
+    if(data.contains(3,1))
+    {
+        Entity2IndexDataHandle<DataHandle, 1> data_wrapper(*this, data);
+        communicateCodim<1>(data_wrapper, dir, getInterface(iftype, face_interfaces_), options, counters);
     }
     if(data.contains(3,3))
     {
         Entity2IndexDataHandle<DataHandle, 3> data_wrapper(*this, data);
-        communicateCodim<3>(data_wrapper, dir, getInterface(iftype, point_interfaces_));
+        communicateCodim<3>(data_wrapper, dir, getInterface(iftype, point_interfaces_), options, counters);
     }
 #else
     // Suppress warnings for unused arguments.
     (void) data;
     (void) iftype;
     (void) dir;
+    (void) options;
 #endif
 }
+
+template<class T, class Reader>
+void CpGridData::scatterCartesianCellValues(Reader& read, T* values, int block_size, int root,
+                                            std::size_t max_chunk_size,
+                                            CommunicationStatistics* statistics)
+{
+    const std::size_t bs = block_size;
+    const std::size_t cartesian_size = std::size_t(logical_cartesian_size_[0])
+        * logical_cartesian_size_[1] * logical_cartesian_size_[2];
+    const std::size_t chunk_cells = max_chunk_size > 0
+        ? std::max(max_chunk_size / bs, std::size_t(1))
+        : std::max(cartesian_size, std::size_t(1));
+
+    // The local cells ordered by Cartesian index. The cells within a chunk
+    // are a contiguous range of them.
+    std::vector<int> order(global_cell_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [this](int a, int b) { return global_cell_[a] < global_cell_[b]; });
+
+#if HAVE_MPI
+    const auto& comm = ccobj_;
+    const bool is_root = comm.rank() == root;
+    Opm::CommunicationCounters* counters =
+        communicationCounters<T>(statistics, "scatterCartesianCellValues", "ScatterGather");
+    double* wait_seconds = counters ? &counters->wait_seconds : nullptr;
+    if (counters)
+    {
+        counters->calls += 1.0;
+        counters->neighbors = std::max(counters->neighbors, double(is_root ? comm.size() - 1 : 1));
+    }
+    std::vector<int> counts(is_root ? comm.size() : 1);
+    std::vector<int> displ(counts.size() + 1, 0);
+    std::vector<int> data_counts(counts.size());
+    std::vector<int> data_displ(displ.size(), 0);
+    // The Cartesian indices, relative to the chunk, requested by this rank and
+    // (on root) by all ranks.
+    std::vector<int> offsets;
+    std::vector<int> requested(1);
+    std::vector<T> send_buffer(1);
+    std::vector<T> recv_buffer;
+#else
+    // Suppress warnings for unused arguments.
+    (void) root;
+    (void) statistics;
+    const bool is_root = true;
+#endif
+    std::vector<T> chunk;
+
+    std::size_t next = 0;
+    for (std::size_t begin = 0; begin < cartesian_size; begin += chunk_cells)
+    {
+        const std::size_t end = std::min(begin + chunk_cells, cartesian_size);
+        std::size_t last = next;
+        while (last < order.size() && std::size_t(global_cell_[order[last]]) < end)
+            ++last;
+        const int count = last - next;
+        if (is_root)
+        {
+            chunk.resize((end - begin) * bs);
+            read(begin, end, chunk.data());
+        }
+#if HAVE_MPI
+        offsets.resize(std::max(count, 1));
+        for (int i = 0; i < count; ++i)
+            offsets[i] = global_cell_[order[next + i]] - begin;
+        {
+            Opm::CommunicationTimer timer(wait_seconds);
+            comm.gather(&count, counts.data(), 1, root);
+            if (is_root)
+            {
+                std::partial_sum(counts.begin(), counts.end(), displ.begin() + 1);
+                requested.resize(std::max(displ.back(), 1));
+            }
+            MPI_Gatherv(offsets.data(), count, MPITraits<int>::getType(),
+                        requested.data(), counts.data(), displ.data(),
+                        MPITraits<int>::getType(), root, comm);
+        }
+        if (is_root)
+        {
+            Opm::CommunicationTimer timer(counters ? &counters->pack_seconds : nullptr);
+            send_buffer.resize(std::max(displ.back() * bs, std::size_t(1)));
+            for (int j = 0; j < displ.back(); ++j)
+                std::copy_n(chunk.data() + requested[j] * bs, bs, send_buffer.data() + j * bs);
+            for (std::size_t p = 0; p < counts.size(); ++p)
+            {
+                data_counts[p] = counts[p] * bs;
+                data_displ[p] = displ[p] * bs;
+                if (counters && int(p) != root)
+                    counters->addMessage<T>(data_counts[p]);
+            }
+        }
+        else if (counters)
+        {
+            counters->addMessage<int>(1);
+            counters->addMessage<int>(count);
+        }
+        recv_buffer.resize(std::max(count * bs, std::size_t(1)));
+        {
+            Opm::CommunicationTimer timer(wait_seconds);
+            MPI_Scatterv(send_buffer.data(), data_counts.data(), data_displ.data(),
+                         MPITraits<T>::getType(), recv_buffer.data(), count * bs,
+                         MPITraits<T>::getType(), root, comm);
+        }
+        {
+            Opm::CommunicationTimer timer(counters ? &counters->unpack_seconds : nullptr);
+            for (int i = 0; i < count; ++i)
+                std::copy_n(recv_buffer.data() + i * bs, bs, values + order[next + i] * bs);
+        }
+#else
+        for (std::size_t i = next; i < last; ++i)
+            std::copy_n(chunk.data() + (global_cell_[order[i]] - begin) * bs, bs,
+                        values + order[i] * bs);
+#endif
+        next = last;
+    }
+}
 }}
 
 #if HAVE_MPI
@@ -716,18 +1137,19 @@ struct Mover<DataHandle,3> : public BaseMover<DataHandle>
 template<class DataHandle>
 void CpGridData::scatterData(DataHandle& data, CpGridData* global_data,
                              CpGridData* distributed_data, const InterfaceMap& cell_inf,
-                             const InterfaceMap& point_inf)
+                             const InterfaceMap& point_inf, CommunicationStatistics* statistics)
 {
 #if HAVE_MPI
+    auto counters = communicationCounters<DataHandle>(statistics, "scatterData", "ScatterGather");
     if(data.contains(3,0))
     {
         Entity2IndexDataHandle<DataHandle, 0> data_wrapper(*global_data, *distributed_data, data);
-        communicateCodim<0>(data_wrapper, ForwardCommunication, cell_inf);
+        communicateCodim<0>(data_wrapper, ForwardCommunication, cell_inf, {}, counters);
     }
     if(data.contains(3,3))
     {
         Entity2IndexDataHandle<DataHandle, 3> data_wrapper(*global_data, *distributed_data, data);
-        communicateCodim<3>(data_wrapper, ForwardCommunication, point_inf);
+        communicateCodim<3>(data_wrapper, ForwardCommunication, point_inf, {}, counters);
     }
 #endif
 }
@@ -811,21 +1233,29 @@ struct DataGatherer
 
 template<class DataHandle>
 void CpGridData::gatherData(DataHandle& data, CpGridData* global_data,
-                            CpGridData* distributed_data)
+                            CpGridData* distributed_data, CommunicationStatistics* statistics)
 {
 #if HAVE_MPI
+    auto counters = communicationCounters<DataHandle>(statistics, "gatherData", "ScatterGather");
     if(data.contains(3,0))
-       gatherCodimData<0>(data, global_data, distributed_data);
+       gatherCodimData<0>(data, global_data, distributed_data, counters);
     if(data.contains(3,3))
-       gatherCodimData<3>(data, global_data, distributed_data);
+       gatherCodimData<3>(data, global_data, distributed_data, counters);
 #endif
 }
 
 template<int codim, class DataHandle>
 void CpGridData::gatherCodimData(DataHandle& data, CpGridData* global_data,
-                                 CpGridData* distributed_data)
+                                 CpGridData* distributed_data,
+                                 Opm::CommunicationCounters* counters)
 {
 #if HAVE_MPI
+    double* wait_seconds = counters ? &counters->wait_seconds : nullptr;
+    if(counters)
+    {
+        counters->calls += 1.0;
+        counters->neighbors = std::max(counters->neighbors, double(distributed_data->ccobj_.size() - 1));
+    }
     // Get the mapping to global index from  the global id set
     const std::vector<int>& mapping =
         distributed_data->global_id_set_->getMapping<codim>();
@@ -849,7 +1279,10 @@ void CpGridData::gatherCodimData(DataHandle& data, CpGridData* global_data,
     if ( owned_sizes.empty() )
         owned_sizes.resize(1);
     std::vector<int> no_indices_to_recv(distributed_data->ccobj_.size());
-    distributed_data->ccobj_.allgather(&no_indices, 1, &(no_indices_to_recv[0]));
+    {
+        Opm::CommunicationTimer timer(wait_seconds);
+        distributed_data->ccobj_.allgather(&no_indices, 1, &(no_indices_to_recv[0]));
+    }
     // compute size of the vector capable for receiving all indices
     // and allgather the global indices and the sizes.
     // calculate displacements
@@ -859,14 +1292,17 @@ void CpGridData::gatherCodimData(DataHandle& data, CpGridData* global_data,
     int global_size=displ[displ.size()-1];//+no_indices_to_recv[displ.size()-1];
     std::vector<int>         global_indices(global_size);
     std::vector<int> global_sizes(global_size);
-    MPI_Allgatherv(&(owned_global_indices[0]), no_indices, MPITraits<int>::getType(),
-                   &(global_indices[0]), &(no_indices_to_recv[0]), &(displ[0]),
-                   MPITraits<int>::getType(),
-                   distributed_data->ccobj_);
-    MPI_Allgatherv(&(owned_sizes[0]), no_indices, MPITraits<int>::getType(),
-                   &(global_sizes[0]), &(no_indices_to_recv[0]), &(displ[0]),
-                   MPITraits<int>::getType(),
-                   distributed_data->ccobj_);
+    {
+        Opm::CommunicationTimer timer(wait_seconds);
+        MPI_Allgatherv(&(owned_global_indices[0]), no_indices, MPITraits<int>::getType(),
+                       &(global_indices[0]), &(no_indices_to_recv[0]), &(displ[0]),
+                       MPITraits<int>::getType(),
+                       distributed_data->ccobj_);
+        MPI_Allgatherv(&(owned_sizes[0]), no_indices, MPITraits<int>::getType(),
+                       &(global_sizes[0]), &(no_indices_to_recv[0]), &(displ[0]),
+                       MPITraits<int>::getType(),
+                       distributed_data->ccobj_);
+    }
     std::vector<int>().swap(owned_global_indices); // free data for reuse.
     // Compute the number of data items to send
     std::vector<int> no_data_send(distributed_data->ccobj_.size());
@@ -895,13 +1331,29 @@ void CpGridData::gatherCodimData(DataHandle& data, CpGridData* global_data,
     }
     global_data_buffer.resize(no_data_recv);
 
-    DataGatherer<DataHandle> gatherer(local_data_buffer, data);
-    visitInterior<codim>(*distributed_data, mapping.begin(), mapping.end(), gatherer);
-    MPI_Allgatherv(&(local_data_buffer.buffer_[0]), no_data_send[distributed_data->ccobj_.rank()],
-                   MPITraits<typename DataHandle::DataType>::getType(),
-                   &(global_data_buffer.buffer_[0]), &(no_data_send[0]), &(displ[0]),
-                   MPITraits<typename DataHandle::DataType>::getType(),
-                   distributed_data->ccobj_);
+    {
+        Opm::CommunicationTimer timer(counters ? &counters->pack_seconds : nullptr);
+        DataGatherer<DataHandle> gatherer(local_data_buffer, data);
+        visitInterior<codim>(*distributed_data, mapping.begin(), mapping.end(), gatherer);
+    }
+    {
+        Opm::CommunicationTimer timer(wait_seconds);
+        MPI_Allgatherv(&(local_data_buffer.buffer_[0]), no_data_send[distributed_data->ccobj_.rank()],
+                       MPITraits<typename DataHandle::DataType>::getType(),
+                       &(global_data_buffer.buffer_[0]), &(no_data_send[0]), &(displ[0]),
+                       MPITraits<typename DataHandle::DataType>::getType(),
+                       distributed_data->ccobj_);
+    }
+    if(counters)
+    {
+        // The count, indices, sizes and data of this rank are sent to all others.
+        const int others = distributed_data->ccobj_.size() - 1;
+        counters->messages += 4.0 * others;
+        counters->bytes += others * ((1 + 2*no_indices) * sizeof(int)
+                                     + no_data_send[distributed_data->ccobj_.rank()]
+                                     * sizeof(typename DataHandle::DataType));
+    }
+    Opm::CommunicationTimer unpack_timer(counters ? &counters->unpack_seconds : nullptr);
     Entity2IndexDataHandle<DataHandle, codim> edata(*global_data, data);
     int offset=0;
     for(int i=0; i< codim; ++i)
@@ -917,6 +1369,203 @@ void CpGridData::gatherCodimData(DataHandle& data, CpGridData* global_data,
 #endif
 }
 
+template<class DataHandle>
+void CpGridData::gatherDataOnRoot(DataHandle& data, CpGridData* global_data,
+                                  CpGridData* distributed_data, int root,
+                                  std::size_t max_chunk_size, CommunicationStatistics* statistics)
+{
+#if HAVE_MPI
+    auto counters = communicationCounters<DataHandle>(statistics, "gatherDataOnRoot", "ScatterGather");
+    if(data.contains(3,0))
+       gatherCodimDataOnRoot<0>(data, global_data, distributed_data, root, max_chunk_size, counters);
+    if(data.contains(3,3))
+       gatherCodimDataOnRoot<3>(data, global_data, distributed_data, root, max_chunk_size, counters);
+#endif
+}
+
+template<int codim, class DataHandle>
+void CpGridData::gatherCodimDataOnRoot(DataHandle& data, CpGridData* global_data,
+                                       CpGridData* distributed_data, int root,
+                                       std::size_t max_chunk_size,
+                                       Opm::CommunicationCounters* counters)
+{
+#if HAVE_MPI
+    using DataType = typename DataHandle::DataType;
+    const auto& comm = distributed_data->ccobj_;
+    const bool is_root = comm.rank() == root;
+    double* wait_seconds = counters ? &counters->wait_seconds : nullptr;
+    if (counters)
+    {
+        counters->calls += 1.0;
+        counters->neighbors = std::max(counters->neighbors, double(is_root ? comm.size() - 1 : 1));
+    }
+
+    // Get the mapping to global index from  the global id set
+    const std::vector<int>& mapping =
+        distributed_data->global_id_set_->getMapping<codim>();
+
+    // Get the global indices, data sizes and data of the entities that we own.
+    std::vector<int> owned_global_indices;
+    std::vector<int> owned_sizes;
+    owned_global_indices.reserve(mapping.size());
+    owned_sizes.reserve(mapping.size());
+    GlobalIndexSizeGatherer<DataHandle> gisg(data, owned_global_indices, owned_sizes);
+    visitInterior<codim>(*distributed_data, mapping.begin(), mapping.end(), gisg);
+    int no_indices = owned_sizes.size();
+    int no_data = std::accumulate(owned_sizes.begin(), owned_sizes.end(), 0);
+    mover::MoveBuffer<DataType> local_data_buffer;
+    local_data_buffer.resize(std::max(no_data, 1));
+    {
+        Opm::CommunicationTimer timer(counters ? &counters->pack_seconds : nullptr);
+        DataGatherer<DataHandle> gatherer(local_data_buffer, data);
+        visitInterior<codim>(*distributed_data, mapping.begin(), mapping.end(), gatherer);
+    }
+    // We will take the address of the first element for MPI below.
+    // Make sure the containers have such an element.
+    if ( owned_global_indices.empty() )
+        owned_global_indices.resize(1);
+    if ( owned_sizes.empty() )
+        owned_sizes.resize(1);
+
+    int offset=0;
+    for(int i=0; i< codim; ++i)
+        offset+=global_data->size(i);
+    // Scatters received data into the global view.
+    auto scatter = [&](mover::MoveBuffer<DataType>& buffer, const int* indices,
+                       const int* sizes, int n)
+    {
+        Opm::CommunicationTimer timer(counters ? &counters->unpack_seconds : nullptr);
+        Entity2IndexDataHandle<DataHandle, codim> edata(*global_data, data);
+        buffer.reset();
+        for (int i = 0; i < n; ++i)
+            edata.scatter(buffer, indices[i]-offset, sizes[i]);
+    };
+
+    if (max_chunk_size == 0)
+    {
+        Opm::CommunicationTimer timer(wait_seconds);
+        // communicate the number of indices and data items that each processor sends
+        std::vector<int> no_indices_to_recv(is_root ? comm.size() : 1);
+        std::vector<int> no_data_to_recv(is_root ? comm.size() : 1);
+        comm.gather(&no_indices, no_indices_to_recv.data(), 1, root);
+        comm.gather(&no_data, no_data_to_recv.data(), 1, root);
+        std::vector<int> displ(no_indices_to_recv.size()+1, 0);
+        std::vector<int> data_displ(no_data_to_recv.size()+1, 0);
+        std::partial_sum(no_indices_to_recv.begin(), no_indices_to_recv.end(), displ.begin()+1);
+        std::partial_sum(no_data_to_recv.begin(), no_data_to_recv.end(), data_displ.begin()+1);
+        // Only the root allocates the receive buffers.
+        std::vector<int> global_indices(is_root ? std::max(displ.back(), 1) : 1);
+        std::vector<int> global_sizes(global_indices.size());
+        mover::MoveBuffer<DataType> global_data_buffer;
+        global_data_buffer.resize(is_root ? std::max(data_displ.back(), 1) : 1);
+        MPI_Gatherv(owned_global_indices.data(), no_indices, MPITraits<int>::getType(),
+                    global_indices.data(), no_indices_to_recv.data(), displ.data(),
+                    MPITraits<int>::getType(), root, comm);
+        MPI_Gatherv(owned_sizes.data(), no_indices, MPITraits<int>::getType(),
+                    global_sizes.data(), no_indices_to_recv.data(), displ.data(),
+                    MPITraits<int>::getType(), root, comm);
+        MPI_Gatherv(local_data_buffer.buffer_.data(), no_data, MPITraits<DataType>::getType(),
+                    global_data_buffer.buffer_.data(), no_data_to_recv.data(), data_displ.data(),
+                    MPITraits<DataType>::getType(), root, comm);
+        if (counters && !is_root)
+        {
+            counters->addMessage<int>(1);
+            counters->addMessage<int>(1);
+            counters->addMessage<int>(no_indices);
+            counters->addMessage<int>(no_indices);
+            counters->addMessage<DataType>(no_data);
+        }
+        if (is_root)
+        {
+            // Scattering is counted as unpacking, not waiting.
+            if (counters)
+                counters->wait_seconds += counters->unpack_seconds;
+            scatter(global_data_buffer, global_indices.data(), global_sizes.data(), displ.back());
+            if (counters)
+                counters->wait_seconds -= counters->unpack_seconds;
+        }
+        return;
+    }
+
+    // Each rank streams whole entities to the root, as a message with the
+    // global indices followed by the sizes, and a message with the data.
+    // A message with one index only marks the end. The root receives from
+    // one rank after the other, such that messages of a later call (e.g.
+    // for the next codimension) are never taken for ones of this call.
+    const MPI_Comm p2p_comm = distributed_data->pointToPointCommunicator();
+    const int index_tag = gather_index_tag, data_tag = gather_data_tag;
+    if (is_root)
+    {
+        scatter(local_data_buffer, owned_global_indices.data(), owned_sizes.data(), no_indices);
+        std::vector<int> header;
+        mover::MoveBuffer<DataType> chunk_buffer;
+        for (int source = 0; source < comm.size(); ++source)
+        {
+            if (source == root)
+                continue;
+            for (;;)
+            {
+                MPI_Status status;
+                int count;
+                {
+                    Opm::CommunicationTimer timer(wait_seconds);
+                    MPI_Probe(source, index_tag, p2p_comm, &status);
+                    MPI_Get_count(&status, MPITraits<int>::getType(), &count);
+                    header.resize(count);
+                    MPI_Recv(header.data(), count, MPITraits<int>::getType(), source,
+                             index_tag, p2p_comm, MPI_STATUS_IGNORE);
+                }
+                const int n = count / 2;
+                if (n == 0)
+                    break;
+                const int* sizes = header.data() + n;
+                const int chunk_data = std::accumulate(sizes, sizes + n, 0);
+                chunk_buffer.resize(std::max(chunk_data, 1));
+                {
+                    Opm::CommunicationTimer timer(wait_seconds);
+                    MPI_Recv(chunk_buffer.buffer_.data(), chunk_data, MPITraits<DataType>::getType(),
+                             source, data_tag, p2p_comm, MPI_STATUS_IGNORE);
+                }
+                scatter(chunk_buffer, header.data(), sizes, n);
+            }
+        }
+    }
+    else
+    {
+        Opm::CommunicationTimer timer(wait_seconds);
+        const std::size_t max_chunk = max_chunk_size;
+        std::vector<int> header;
+        int begin = 0, data_begin = 0;
+        while (begin < no_indices)
+        {
+            int end = begin + 1;
+            std::size_t chunk_data = owned_sizes[begin];
+            while (end < no_indices && std::size_t(end - begin) < max_chunk
+                   && chunk_data + owned_sizes[end] <= max_chunk)
+            {
+                chunk_data += owned_sizes[end++];
+            }
+            header.assign(owned_global_indices.begin() + begin, owned_global_indices.begin() + end);
+            header.insert(header.end(), owned_sizes.begin() + begin, owned_sizes.begin() + end);
+            MPI_Send(header.data(), header.size(), MPITraits<int>::getType(), root, index_tag, p2p_comm);
+            MPI_Send(local_data_buffer.buffer_.data() + data_begin, chunk_data,
+                     MPITraits<DataType>::getType(), root, data_tag, p2p_comm);
+            if (counters)
+            {
+                counters->addMessage<int>(header.size());
+                counters->addMessage<DataType>(chunk_data);
+            }
+            begin = end;
+            data_begin += chunk_data;
+        }
+        int end_marker = 0;
+        MPI_Send(&end_marker, 1, MPITraits<int>::getType(), root, index_tag, p2p_comm);
+        if (counters)
+            counters->addMessage<int>(1);
+    }
+#endif
+}
+
 } // end namespace cpgrid
 } // end namespace Dune
 
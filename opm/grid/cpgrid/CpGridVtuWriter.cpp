@@ -0,0 +1,377 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "CpGridVtuWriter.hpp"
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/utility/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Dune
+{
+
+    namespace
+    {
+        static_assert(sizeof(int) == 4, "GlobalCell is written as Int32");
+
+        const char* byteOrder()
+        {
+            const std::uint16_t one = 1;
+            unsigned char first;
+            std::memcpy(&first, &one, 1);
+            return (first == 1) ? "LittleEndian" : "BigEndian";
+        }
+
+        // Strip the directory part, pieces are referenced relative to
+        // the PVTU and PVD files.
+        std::string baseName(const std::string& path)
+        {
+            const auto pos = path.find_last_of('/');
+            return (pos == std::string::npos) ? path : path.substr(pos + 1);
+        }
+
+        std::string stepName(const std::string& prefix, const int step)
+        {
+            std::ostringstream name;
+            name << prefix << '-' << std::setw(5) << std::setfill('0') << step;
+            return name.str();
+        }
+
+        std::string pieceName(const std::string& step_name, const int rank)
+        {
+            std::ostringstream name;
+            name << step_name << "-p" << std::setw(4) << std::setfill('0') << rank << ".vtu";
+            return name.str();
+        }
+
+        // Size of the data of an appended block, without the header.
+        struct Block
+        {
+            std::uint64_t bytes;
+            std::uint64_t offset;
+        };
+
+        void writeBlockHeader(std::ostream& os, const std::uint64_t bytes)
+        {
+            os.write(reinterpret_cast<const char*>(&bytes), sizeof bytes);
+        }
+
+        template <typename T>
+        void writeRaw(std::ostream& os, const T* data, const std::size_t n)
+        {
+            os.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+        }
+
+        std::ofstream openFile(const std::string& fname, const bool binary)
+        {
+            std::ofstream os(fname, binary ? (std::ios::out | std::ios::binary) : std::ios::out);
+            if (!os) {
+                OPM_THROW(std::runtime_error, "Could not open file " << fname);
+            }
+            return os;
+        }
+
+    } // anonymous namespace
+
+
+
+    CpGridVtuWriter::CpGridVtuWriter(const CpGrid& grid, const std::string& prefix,
+                                     const bool write_changed_only)
+        : grid_(grid),
+          prefix_(prefix),
+          write_changed_only_(write_changed_only),
+          num_cells_(0)
+    {
+        // Interior cells come in increasing index order.
+        const auto gv = grid_.leafGridView();
+        const auto& index_set = gv.indexSet();
+        for (const auto& element : elements(gv, Dune::Partitions::interior)) {
+            const int cell = index_set.index(element);
+            if (cell_runs_.empty() || cell_runs_.back().second != cell) {
+                cell_runs_.emplace_back(cell, cell + 1);
+            } else {
+                ++cell_runs_.back().second;
+            }
+            ++num_cells_;
+        }
+
+        // Compact numbering of the vertices of the interior cells.
+        std::vector<int> local_point(grid_.numVertices(), -1);
+        for (const auto& run : cell_runs_) {
+            for (int cell = run.first; cell < run.second; ++cell) {
+                for (const int p : grid_.cellToPoint(cell)) {
+                    local_point[p] = 0;
+                }
+            }
+        }
+        int num_points = 0;
+        for (int p = 0; p < int(local_point.size()); ++p) {
+            if (local_point[p] == 0) {
+                local_point[p] = num_points++;
+                const auto& x = grid_.vertexPosition(p);
+                points_.insert(points_.end(), x.begin(), x.end());
+            }
+        }
+
+        // VTK_HEXAHEDRON corner order, see also writeVtkVolumes().
+        const int vtk_order[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+        connectivity_.reserve(8 * std::size_t(num_cells_));
+        for (const auto& run : cell_runs_) {
+            for (int cell = run.first; cell < run.second; ++cell) {
+                const auto& corners = grid_.cellToPoint(cell);
+                for (const int c : vtk_order) {
+                    connectivity_.push_back(local_point[corners[c]]);
+                }
+            }
+        }
+    }
+
+
+
+    void CpGridVtuWriter::addCellData(const std::string& name, const std::vector<double>& data,
+                                      const int num_components)
+    {
+        if (data.size() != std::size_t(grid_.numCells()) * num_components) {
+            OPM_THROW(std::logic_error, "Cell field " << name << " has " << data.size()
+                      << " values, expected " << grid_.numCells() * num_components);
+        }
+        fields_.push_back(Field{ name, data.data(), num_components, 0, false });
+    }
+
+
+
+    void CpGridVtuWriter::clear()
+    {
+        fields_.clear();
+    }
+
+
+
+    void CpGridVtuWriter::writeChangedOnly(const bool write_changed_only)
+    {
+        write_changed_only_ = write_changed_only;
+    }
+
+
+
+    std::string CpGridVtuWriter::write(const double time)
+    {
+        const auto& comm = grid_.comm();
+
+        // Decide collectively which fields to write, all pieces of a
+        // step must have the same fields.
+        std::vector<const Field*> fields;
+        for (auto& field : fields_) {
+            const std::uint64_t hash = hashCellData(field.data, field.num_components);
+            int changed = !field.written || (hash != field.hash);
+            if (write_changed_only_) {
+                changed = comm.max(changed);
+            }
+            if (!write_changed_only_ || changed) {
+                fields.push_back(&field);
+                field.hash = hash;
+                field.written = true;
+            }
+        }
+
+        const std::string step_name = stepName(prefix_, steps_.size());
+        writePiece(pieceName(step_name, comm.rank()), fields);
+        const std::string pvtu = step_name + ".pvtu";
+        steps_.emplace_back(time, baseName(pvtu));
+        if (comm.rank() == 0) {
+            writeParallelHeader(pvtu, baseName(step_name), fields);
+            writeCollection();
+        }
+        comm.barrier();
+        return pvtu;
+    }
+
+
+
+    void CpGridVtuWriter::writePiece(const std::string& fname,
+                                     const std::vector<const Field*>& fields) const
+    {
+        const std::uint64_t nc = num_cells_;
+        const std::uint64_t np = points_.size() / 3;
+
+        // Layout of the appended data: points, connectivity, offsets,
+        // types, GlobalCell and the fields.
+        std::vector<Block> blocks;
+        std::uint64_t offset = 0;
+        auto addBlock = [&](const std::uint64_t bytes)
+        {
+            blocks.push_back(Block{ bytes, offset });
+            offset += sizeof(std::uint64_t) + bytes;
+            return blocks.back().offset;
+        };
+        std::ostringstream xml;
+        xml << "<?xml version=\"1.0\"?>\n"
+            << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+            << byteOrder() << "\" header_type=\"UInt64\">\n"
+            << "  <UnstructuredGrid>\n"
+            << "    <Piece NumberOfPoints=\"" << np << "\" NumberOfCells=\"" << nc << "\">\n"
+            << "      <Points>\n"
+            << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+            << addBlock(3 * np * sizeof(double)) << "\"/>\n"
+            << "      </Points>\n"
+            << "      <Cells>\n"
+            << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\""
+            << addBlock(8 * nc * sizeof(std::int64_t)) << "\"/>\n"
+            << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\""
+            << addBlock(nc * sizeof(std::int64_t)) << "\"/>\n"
+            << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\""
+            << addBlock(nc * sizeof(std::uint8_t)) << "\"/>\n"
+            << "      </Cells>\n"
+            << "      <CellData>\n"
+            << "        <DataArray type=\"Int32\" Name=\"GlobalCell\" format=\"appended\" offset=\""
+            << addBlock(nc * sizeof(int)) << "\"/>\n";
+        for (const Field* field : fields) {
+            xml << "        <DataArray type=\"Float64\" Name=\"" << field->name
+                << "\" NumberOfComponents=\"" << field->num_components << "\" format=\"appended\" offset=\""
+                << addBlock(nc * field->num_components * sizeof(double)) << "\"/>\n";
+        }
+        xml << "      </CellData>\n"
+            << "    </Piece>\n"
+            << "  </UnstructuredGrid>\n"
+            << "  <AppendedData encoding=\"raw\">\n"
+            << "_";
+
+        std::ofstream os = openFile(fname, true);
+        os << xml.str();
+        auto block = blocks.begin();
+
+        writeBlockHeader(os, (block++)->bytes);
+        writeRaw(os, points_.data(), points_.size());
+
+        writeBlockHeader(os, (block++)->bytes);
+        writeRaw(os, connectivity_.data(), connectivity_.size());
+
+        // Offsets and types in small batches.
+        const std::size_t batch = 4096;
+        std::vector<std::int64_t> offsets(batch);
+        writeBlockHeader(os, (block++)->bytes);
+        for (std::uint64_t first = 0; first < nc; first += batch) {
+            const std::size_t n = std::min<std::uint64_t>(batch, nc - first);
+            for (std::size_t i = 0; i < n; ++i) {
+                offsets[i] = 8 * (first + i + 1);
+            }
+            writeRaw(os, offsets.data(), n);
+        }
+        const std::vector<std::uint8_t> types(batch, 12); // VTK_HEXAHEDRON
+        writeBlockHeader(os, (block++)->bytes);
+        for (std::uint64_t first = 0; first < nc; first += batch) {
+            writeRaw(os, types.data(), std::min<std::uint64_t>(batch, nc - first));
+        }
+
+        writeBlockHeader(os, (block++)->bytes);
+        writeCellRuns(os, grid_.globalCell().data(), 1);
+
+        for (const Field* field : fields) {
+            writeBlockHeader(os, (block++)->bytes);
+            writeCellRuns(os, field->data, field->num_components);
+        }
+        os << "\n  </AppendedData>\n"
+           << "</VTKFile>\n";
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed writing file " << fname);
+        }
+    }
+
+
+
+    void CpGridVtuWriter::writeParallelHeader(const std::string& fname, const std::string& piece_base,
+                                              const std::vector<const Field*>& fields) const
+    {
+        std::ofstream os = openFile(fname, false);
+        os << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\""
+           << byteOrder() << "\" header_type=\"UInt64\">\n"
+           << "  <PUnstructuredGrid GhostLevel=\"0\">\n"
+           << "    <PPoints>\n"
+           << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+           << "    </PPoints>\n"
+           << "    <PCellData>\n"
+           << "      <PDataArray type=\"Int32\" Name=\"GlobalCell\"/>\n";
+        for (const Field* field : fields) {
+            os << "      <PDataArray type=\"Float64\" Name=\"" << field->name
+               << "\" NumberOfComponents=\"" << field->num_components << "\"/>\n";
+        }
+        os << "    </PCellData>\n";
+        for (int rank = 0; rank < grid_.comm().size(); ++rank) {
+            os << "    <Piece Source=\"" << pieceName(piece_base, rank) << "\"/>\n";
+        }
+        os << "  </PUnstructuredGrid>\n"
+           << "</VTKFile>\n";
+    }
+
+
+
+    void CpGridVtuWriter::writeCollection() const
+    {
+        std::ofstream os = openFile(prefix_ + ".pvd", false);
+        os.precision(16);
+        os << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << byteOrder() << "\">\n"
+           << "  <Collection>\n";
+        for (const auto& step : steps_) {
+            os << "    <DataSet timestep=\"" << step.first << "\" group=\"\" part=\"0\" file=\""
+               << step.second << "\"/>\n";
+        }
+        os << "  </Collection>\n"
+           << "</VTKFile>\n";
+    }
+
+
+
+    template <typename T>
+    void CpGridVtuWriter::writeCellRuns(std::ostream& os, const T* data, const int num_components) const
+    {
+        for (const auto& run : cell_runs_) {
+            writeRaw(os, data + std::size_t(run.first) * num_components,
+                     std::size_t(run.second - run.first) * num_components);
+        }
+    }
+
+
+
+    std::uint64_t CpGridVtuWriter::hashCellData(const double* data, const int num_components) const
+    {
+        // FNV-1a over the bit patterns of the interior values.
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const auto& run : cell_runs_) {
+            const double* end = data + std::size_t(run.second) * num_components;
+            for (const double* v = data + std::size_t(run.first) * num_components; v != end; ++v) {
+                std::uint64_t bits;
+                std::memcpy(&bits, v, sizeof bits);
+                hash = (hash ^ bits) * 1099511628211ULL;
+            }
+        }
+        return hash;
+    }
+
+} // namespace Dune
@@ -0,0 +1,116 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CPGRIDVTUWRITER_HEADER
+#define OPM_CPGRIDVTUWRITER_HEADER
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Dune
+{
+    class CpGrid;
+
+    /// \brief Writes cell data of a CpGrid to raw binary appended VTU files.
+    ///
+    /// In contrast to Dune::VTKWriter this writer works directly on the
+    /// cell corners, vertex positions and Cartesian indices of the grid.
+    /// Every rank writes the interior cells of its current view to its
+    /// own piece file, and rank zero writes the PVTU file collecting the
+    /// pieces of a time step and a PVD file collecting all time steps.
+    ///
+    /// Cell fields are registered once and read from the caller's
+    /// storage when a step is written, they are not copied. With
+    /// writeChangedOnly() set, a field is only written to a step if its
+    /// values changed since it was last written on some rank. The grid
+    /// itself and the Cartesian cell index ("GlobalCell") are always
+    /// written.
+    ///
+    /// The grid must not be changed, e.g. by loadBalance(), during the
+    /// lifetime of the writer.
+    class CpGridVtuWriter
+    {
+    public:
+        /// \brief Constructor.
+        /// \param grid The grid. The current view is written.
+        /// \param prefix Path and base name of the files written.
+        /// \param write_changed_only Whether to skip unchanged fields.
+        CpGridVtuWriter(const CpGrid& grid, const std::string& prefix,
+                        bool write_changed_only = false);
+
+        /// \brief Register a cell field.
+        ///
+        /// The data must stay valid, and have the same address, as long
+        /// as the field is registered.
+        /// \param name The name of the field.
+        /// \param data Values of all cells of the current view (including
+        ///             overlap), num_components consecutive values per cell.
+        /// \param num_components The number of components per cell.
+        void addCellData(const std::string& name, const std::vector<double>& data,
+                         int num_components = 1);
+
+        /// \brief Unregister all cell fields.
+        void clear();
+
+        /// \brief Whether to skip fields that did not change since they were last written.
+        void writeChangedOnly(bool write_changed_only);
+
+        /// \brief Write a time step.
+        ///
+        /// Collective operation on the communicator of the grid.
+        /// \param time The time of the step, listed in the PVD file.
+        /// \return The name of the PVTU file of the step.
+        std::string write(double time);
+
+    private:
+        struct Field
+        {
+            std::string name;
+            const double* data;
+            int num_components;
+            std::uint64_t hash;
+            bool written;
+        };
+
+        void writePiece(const std::string& fname, const std::vector<const Field*>& fields) const;
+        void writeParallelHeader(const std::string& fname, const std::string& piece_base,
+                                 const std::vector<const Field*>& fields) const;
+        void writeCollection() const;
+        template <typename T>
+        void writeCellRuns(std::ostream& os, const T* data, int num_components) const;
+        std::uint64_t hashCellData(const double* data, int num_components) const;
+
+        const CpGrid& grid_;
+        std::string prefix_;
+        bool write_changed_only_;
+        int num_cells_;
+        /// Ranges [begin, end) of consecutive interior cells.
+        std::vector<std::pair<int, int>> cell_runs_;
+        std::vector<double> points_;
+        std::vector<std::int64_t> connectivity_;
+        std::vector<Field> fields_;
+        std::vector<std::pair<double, std::string>> steps_;
+    };
+
+} // namespace Dune
+
+#endif // OPM_CPGRIDVTUWRITER_HEADER
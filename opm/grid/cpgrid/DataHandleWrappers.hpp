@@ -52,6 +52,8 @@ namespace cpgrid
 /// to faces.
 /// \warning As we send all faces of cell most of the faces will be send twice
 /// which will temporarily waste some space and bandwidth.
+/// CpGrid::communicate() also accepts handles for codim-1 entities
+/// directly, which send each face once.
 ///
 /// \tparam Handle The type of the data handle to wrap. It must gather and scatter
 ///         only for codim-1 entities.
@@ -224,6 +224,7 @@ namespace Dune
 
             using V::empty;
             using V::size;
+            using V::capacity;
             using V::assign;
             using V::begin;
             using V::end;
@@ -84,7 +84,7 @@ void Intersection::update()
             {
                 const EntityRep<1>& face = faces_of_cell_[subindex_];
                 //global_geom_ = cpgrid::Entity<1>(*pgrid_, face).geometry();
-                global_geom_ = pgrid_->geometry_.geomVector<1>()[face];
+                global_geom_ = pgrid_->geomVector<1>()[face];
                 OrientedEntityTable<1,0>::row_type cells_of_face = pgrid_->face_to_cell_[face];
                 is_on_boundary_ = cells_of_face.size() == 1;
                 // Wether there is no nother nbcell for this intersection
@@ -143,23 +143,23 @@ int Intersection::indexInInside() const
 
 FieldVector<Intersection::ctype, 3> Intersection::outerNormal(const FieldVector<ctype, 2>&) const
 {
-    return pgrid_->face_normals_[faces_of_cell_[subindex_]];
+    return pgrid_->faceNormals()[faces_of_cell_[subindex_]];
 }
 
 FieldVector<Intersection::ctype, 3> Intersection::integrationOuterNormal(const FieldVector<ctype, 2>& unused) const
 {
-    FieldVector<ctype, 3> n = pgrid_->face_normals_[faces_of_cell_[subindex_]];
+    FieldVector<ctype, 3> n = pgrid_->faceNormals()[faces_of_cell_[subindex_]];
     return n*=geometry().integrationElement(unused);
 }
 
 FieldVector<Intersection::ctype, 3> Intersection::unitOuterNormal(const FieldVector<ctype, 2>&) const
 {
-    return pgrid_->face_normals_[faces_of_cell_[subindex_]];
+    return pgrid_->faceNormals()[faces_of_cell_[subindex_]];
 }
 
 FieldVector<Intersection::ctype, 3> Intersection::centerUnitOuterNormal() const
 {
-    return pgrid_->face_normals_[faces_of_cell_[subindex_]];
+    return pgrid_->faceNormals()[faces_of_cell_[subindex_]];
 }
 
 Intersection::EntityPointer Intersection::inside() const
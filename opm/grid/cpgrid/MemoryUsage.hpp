@@ -0,0 +1,92 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_CPGRID_MEMORYUSAGE_HEADER
+#define OPM_CPGRID_MEMORYUSAGE_HEADER
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Dune
+{
+namespace cpgrid
+{
+
+/// \brief The bytes held by the components of a grid.
+///
+/// Counts the allocated storage of the containers, not the overhead
+/// of the allocator or of the nodes of associative containers.
+struct MemoryUsage
+{
+    /// \brief The component names and their sizes in bytes.
+    std::vector<std::pair<std::string, std::size_t>> components;
+
+    /// \brief Add a component.
+    void add(const std::string& name, std::size_t bytes)
+    {
+        components.emplace_back(name, bytes);
+    }
+
+    /// \brief Add the components of another breakdown.
+    /// \param prefix Prepended to the names of the added components.
+    void append(const std::string& prefix, const MemoryUsage& other)
+    {
+        for (const auto& component : other.components) {
+            add(prefix + component.first, component.second);
+        }
+    }
+
+    /// \brief The sum over all components in bytes.
+    std::size_t total() const
+    {
+        std::size_t sum = 0;
+        for (const auto& component : components) {
+            sum += component.second;
+        }
+        return sum;
+    }
+};
+
+/// \brief The bytes allocated by a vector.
+template<class T, class A>
+std::size_t vectorBytes(const std::vector<T, A>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+/// \brief The bytes of the index lists of a communication interface.
+/// \tparam InterfaceMap A map from ranks to pairs of send and receive
+///         InterfaceInformation.
+template<class InterfaceMap>
+std::size_t interfaceBytes(const InterfaceMap& interfaces)
+{
+    std::size_t bytes = 0;
+    for (const auto& rank_lists : interfaces) {
+        const auto& send = rank_lists.second.first;
+        const auto& recv = rank_lists.second.second;
+        bytes += send.size() * sizeof(send[0]) + recv.size() * sizeof(recv[0]);
+    }
+    return bytes;
+}
+
+} // end namespace cpgrid
+} // end namespace Dune
+
+#endif // OPM_CPGRID_MEMORYUSAGE_HEADER
@@ -92,7 +92,6 @@ private:
     /// Otherwise this grid is not parallel and allen entities are interior.
     std::vector<char> point_indicator_;
     friend class CpGridData;
-    friend class FacePartitionTypeIterator;
 };
 } // end namespace Dune
 } // end namespace cpgrid
@@ -0,0 +1,246 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "CpGridData.hpp"
+#include <opm/grid/utility/ErrorMacros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace Dune
+{
+
+    void cpgrid::CpGridData::checkCartesianCoordinates(const std::array<std::vector<double>, 3>& coordinates)
+    {
+        for (const auto& coord : coordinates) {
+            if (coord.size() < 2) {
+                OPM_THROW(std::invalid_argument, "A cartesian grid needs at least one cell in each direction.");
+            }
+            for (std::size_t n = 1; n < coord.size(); ++n) {
+                if (!(coord[n] > coord[n - 1])) {
+                    OPM_THROW(std::invalid_argument, "Cartesian grid coordinates must be strictly increasing.");
+                }
+            }
+        }
+        const std::size_t nx = coordinates[0].size() - 1;
+        const std::size_t ny = coordinates[1].size() - 1;
+        const std::size_t nz = coordinates[2].size() - 1;
+        const std::size_t num_faces = (nx + 1)*ny*nz + nx*(ny + 1)*nz + nx*ny*(nz + 1);
+        if (4*num_faces > std::size_t(std::numeric_limits<Opm::SparseTable<int>::index_type>::max())
+            || num_faces > std::size_t(std::numeric_limits<int>::max())) {
+            OPM_THROW(std::invalid_argument, "Cartesian grid of " << nx << " x " << ny << " x " << nz
+                      << " cells is too large for the grid index type.");
+        }
+    }
+
+    /// Create a tensor-product grid with vertical pillars.
+    ///
+    /// The numbering of points, faces and cells and the orientation of
+    /// the faces is the one produced by process_grdecl() and buildTopo()
+    /// for the same box: points per pillar (i fastest, then j) with z
+    /// increasing, then all I faces, all J faces and all K faces, each
+    /// group running along the pillars (pillar pairs) first.
+    void cpgrid::CpGridData::createCartesian(const std::array<std::vector<double>, 3>& coordinates)
+    {
+        if (ccobj_.rank() != 0) {
+            OPM_THROW(std::logic_error, "Creating a cartesian grid only allowed on rank 0");
+        }
+        checkCartesianCoordinates(coordinates);
+        ConstructionTimings::Phase phase(*timings_, "createCartesian");
+        const std::vector<double>& x = coordinates[0];
+        const std::vector<double>& y = coordinates[1];
+        const std::vector<double>& z = coordinates[2];
+        const int nx = x.size() - 1;
+        const int ny = y.size() - 1;
+        const int nz = z.size() - 1;
+
+        const int num_cells = nx*ny*nz;
+        const int num_points = (nx + 1)*(ny + 1)*(nz + 1);
+        const int num_i_faces = (nx + 1)*ny*nz;
+        const int num_j_faces = nx*(ny + 1)*nz;
+        const int num_k_faces = nx*ny*(nz + 1);
+        const int num_faces = num_i_faces + num_j_faces + num_k_faces;
+
+        auto cell = [nx, ny](int i, int j, int k) { return i + nx*(j + ny*k); };
+        auto point = [nx, nz](int i, int j, int k) { return k + (nz + 1)*(i + (nx + 1)*j); };
+        auto iFace = [nx, nz](int i, int j, int k) { return k + nz*(i + (nx + 1)*j); };
+        auto jFace = [=](int i, int j, int k) { return num_i_faces + k + nz*(i + nx*j); };
+        auto kFace = [=](int i, int j, int k) { return num_i_faces + num_j_faces + k + (nz + 1)*(i + nx*j); };
+
+        // Cells.
+        global_cell_.resize(num_cells);
+        std::iota(global_cell_.begin(), global_cell_.end(), 0);
+        logical_cartesian_size_ = {{ nx, ny, nz }};
+
+        const std::vector<int> cell_row_sizes(num_cells, 6);
+        cell_to_face_.allocate(cell_row_sizes.begin(), cell_row_sizes.end());
+        cell_to_point_.resize(num_cells);
+
+        // Faces, with -1 for a missing neighbour.
+        std::vector<std::array<int, 2>> face_cells(num_faces);
+        std::vector<int> num_face_cells(num_faces);
+        std::vector<enum face_tag> tags(num_faces);
+        const std::vector<int> face_row_sizes(num_faces, 4);
+        face_to_point_.allocate(face_row_sizes.begin(), face_row_sizes.end());
+
+        typedef FieldVector<double, 3> point_t;
+        auto& point_geom = geometry_.geomVector(std::integral_constant<int, 3>());
+        auto& face_geom = geometry_.geomVector(std::integral_constant<int, 1>());
+        auto& cell_geom = geometry_.geomVector(std::integral_constant<int, 0>());
+        point_geom.assign(num_points, Geometry<0, 3>());
+        face_geom.assign(num_faces, Geometry<2, 3>());
+        cell_geom.assign(num_cells, Geometry<3, 3>());
+        face_normals_.assign(num_faces, point_t(0.0));
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int p = 0; p < num_points; ++p) {
+            const int k = p % (nz + 1);
+            const int i = (p / (nz + 1)) % (nx + 1);
+            const int j = p / ((nz + 1)*(nx + 1));
+            point_geom.get(p) = Geometry<0, 3>(point_t{ x[i], y[j], z[k] });
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int f = 0; f < num_faces; ++f) {
+            int i, j, k;
+            int c0, c1;
+            int nodes[4];
+            point_t centroid;
+            double area;
+            point_t normal(0.0);
+            if (f < num_i_faces) {
+                k = f % nz;
+                i = (f / nz) % (nx + 1);
+                j = f / (nz*(nx + 1));
+                c0 = i > 0 ? cell(i - 1, j, k) : -1;
+                c1 = i < nx ? cell(i, j, k) : -1;
+                nodes[0] = point(i, j, k);
+                nodes[1] = point(i, j + 1, k);
+                nodes[2] = point(i, j + 1, k + 1);
+                nodes[3] = point(i, j, k + 1);
+                centroid = point_t{x[i], 0.5*(y[j] + y[j + 1]), 0.5*(z[k] + z[k + 1])};
+                area = (y[j + 1] - y[j])*(z[k + 1] - z[k]);
+                normal[0] = 1.0;
+                tags[f] = I_FACE;
+            } else if (f < num_i_faces + num_j_faces) {
+                const int fj = f - num_i_faces;
+                k = fj % nz;
+                i = (fj / nz) % nx;
+                j = fj / (nz*nx);
+                c0 = j > 0 ? cell(i, j - 1, k) : -1;
+                c1 = j < ny ? cell(i, j, k) : -1;
+                nodes[0] = point(i + 1, j, k);
+                nodes[1] = point(i, j, k);
+                nodes[2] = point(i, j, k + 1);
+                nodes[3] = point(i + 1, j, k + 1);
+                centroid = point_t{0.5*(x[i] + x[i + 1]), y[j], 0.5*(z[k] + z[k + 1])};
+                area = (x[i + 1] - x[i])*(z[k + 1] - z[k]);
+                normal[1] = 1.0;
+                tags[f] = J_FACE;
+            } else {
+                const int fk = f - num_i_faces - num_j_faces;
+                k = fk % (nz + 1);
+                i = (fk / (nz + 1)) % nx;
+                j = fk / ((nz + 1)*nx);
+                c0 = k > 0 ? cell(i, j, k - 1) : -1;
+                c1 = k < nz ? cell(i, j, k) : -1;
+                nodes[0] = point(i, j, k);
+                nodes[1] = point(i + 1, j, k);
+                nodes[2] = point(i + 1, j + 1, k);
+                nodes[3] = point(i, j + 1, k);
+                centroid = point_t{0.5*(x[i] + x[i + 1]), 0.5*(y[j] + y[j + 1]), z[k]};
+                area = (x[i + 1] - x[i])*(y[j + 1] - y[j]);
+                normal[2] = 1.0;
+                tags[f] = K_FACE;
+            }
+            face_cells[f] = {{ c0, c1 }};
+            num_face_cells[f] = (c0 != -1) + (c1 != -1);
+            auto fp = face_to_point_[f];
+            for (int n = 0; n < 4; ++n) {
+                fp[n] = nodes[n];
+            }
+            face_geom.get(f) = Geometry<2, 3>(centroid, area);
+            face_normals_.get(f) = normal;
+        }
+        face_tag_.assign(tags.begin(), tags.end());
+
+        // The first cell of a face has the lower index, and the face
+        // normal points out of it.
+        face_to_cell_.allocate(num_face_cells.begin(), num_face_cells.end());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int f = 0; f < num_faces; ++f) {
+            auto fc = face_to_cell_.row(EntityRep<1>(f, true));
+            int n = 0;
+            if (face_cells[f][0] != -1) {
+                fc[n++] = EntityRep<0>(face_cells[f][0], true);
+            }
+            if (face_cells[f][1] != -1) {
+                fc[n++] = EntityRep<0>(face_cells[f][1], false);
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int c = 0; c < num_cells; ++c) {
+            const int i = c % nx;
+            const int j = (c / nx) % ny;
+            const int k = c / (nx*ny);
+            // Faces in increasing index order, as by makeInverseRelation(),
+            // such that the top and bottom faces come last.
+            auto cf = cell_to_face_.row(EntityRep<0>(c, true));
+            cf[0] = EntityRep<1>(iFace(i, j, k), false);
+            cf[1] = EntityRep<1>(iFace(i + 1, j, k), true);
+            cf[2] = EntityRep<1>(jFace(i, j, k), false);
+            cf[3] = EntityRep<1>(jFace(i, j + 1, k), true);
+            cf[4] = EntityRep<1>(kFace(i, j, k), false);
+            cf[5] = EntityRep<1>(kFace(i, j, k + 1), true);
+            // Corners with x fastest, then y, then z.
+            cell_to_point_[c] = {{ point(i, j, k), point(i + 1, j, k),
+                                   point(i, j + 1, k), point(i + 1, j + 1, k),
+                                   point(i, j, k + 1), point(i + 1, j, k + 1),
+                                   point(i, j + 1, k + 1), point(i + 1, j + 1, k + 1) }};
+            const point_t centroid{ 0.5*(x[i] + x[i + 1]), 0.5*(y[j] + y[j + 1]), 0.5*(z[k] + z[k + 1]) };
+            const double volume = (x[i + 1] - x[i])*(y[j + 1] - y[j])*(z[k + 1] - z[k]);
+            cell_geom.get(c) = Geometry<3, 3>(centroid, volume, point_geom, cell_to_point_[c].data());
+        }
+
+        computeUniqueBoundaryIds();
+
+        if (ccobj_.size() > 1) {
+            populateGlobalCellIndexSet();
+        }
+        phase.setCounts(num_cells, num_faces, num_points);
+    }
+
+} // namespace Dune
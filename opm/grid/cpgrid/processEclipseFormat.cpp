@@ -48,21 +48,23 @@
 #include <opm/grid/cpgpreprocess/preprocess.h>
 #include <opm/grid/MinpvProcessor.hpp>
 #include <opm/grid/RepairZCORN.hpp>
-#include <opm/grid/utility/StopWatch.hpp>
 
 #include <opm/grid/utility/OpmParserIncludes.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <iostream>
 #include <initializer_list>
-#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace Dune
 {
 
-    using NNCMap = std::set<std::pair<int, int>>;
+    /// Sorted, unique pairs of cartesian cell indices.
+    using NNCMap = std::vector<std::pair<int, int>>;
     using NNCMaps = std::array<NNCMap, 2>;
     enum NNCMapsIndex { PinchNNC = 0,
                         ExplicitNNC = 1 };
@@ -88,6 +90,7 @@ namespace Dune
                                std::vector<int>& new_actnum,
                                grdecl& output);
         void removeOuterCellLayer(processed_grid& grid);
+        void sortAndRemoveDuplicates(NNCMap& nnc);
         // void removeUnusedNodes(processed_grid& grid); // NOTE: not deleted, see comment at definition.
         void buildTopo(const processed_grid& output,
                        const NNCMaps& nnc,
@@ -97,16 +100,8 @@ namespace Dune
                        Opm::SparseTable<int>& f2p,
                        std::vector<std::array<int,8> >& c2p,
                        std::vector<int>& face_to_output_face);
-        void buildGeom(const processed_grid& output,
-                       const cpgrid::OrientedEntityTable<0, 1>& c2f,
-                       const std::vector<std::array<int,8> >& c2p,
-                       const std::vector<int>& face_to_output_face,
-                       const std::unordered_map<size_t, double>& aquifer_cell_volumes,
-                       cpgrid::EntityVariable<cpgrid::Geometry<3, 3>, 0>& cell_geom,
-                       cpgrid::EntityVariable<cpgrid::Geometry<2, 3>, 1>& face_geom,
-                       cpgrid::EntityVariable<cpgrid::Geometry<0, 3>, 3>& point_geom,
-                       cpgrid::SignedEntityVariable<FieldVector<double, 3> , 1>& normals,
-                       bool turn_normals);
+        void buildPointGeom(const processed_grid& output,
+                            cpgrid::EntityVariable<cpgrid::Geometry<0, 3>, 3>& point_geom);
     } // anon namespace
 
 
@@ -126,13 +121,18 @@ namespace cpgrid
             // Store global grid only on rank 0
             return removed_cells;
         }
+        ConstructionTimings::Phase phase(*timings_, "processEclipseFormat");
 
         const Opm::EclipseGrid& ecl_grid = *ecl_grid_ptr;
         std::vector<double> coordData = ecl_grid.getCOORD();
         std::vector<int> actnumData = ecl_grid.getACTNUM();
 
         // Mutable because grdecl::zcorn is non-const.
-        auto zcornData = getSanitizedZCORN(ecl_grid, actnumData);
+        std::vector<double> zcornData;
+        {
+            ConstructionTimings::Phase repair(*timings_, "getSanitizedZCORN");
+            zcornData = getSanitizedZCORN(ecl_grid, actnumData);
+        }
 
         // Make input struct for processing code.
         grdecl g;
@@ -147,36 +147,33 @@ namespace cpgrid
 
         // Possibly process MINPV
         if (ecl_state && (ecl_grid.getMinpvMode() != Opm::MinpvMode::ModeEnum::Inactive)) {
+            ConstructionTimings::Phase minpv(*timings_, "MinpvProcessor");
             Opm::MinpvProcessor mp(g.dims[0], g.dims[1], g.dims[2]);
             // Currently PINCH is always assumed to be active
-            const size_t cartGridSize = g.dims[0] * g.dims[1] * g.dims[2];
-            std::vector<double> thickness(cartGridSize);
-            for (size_t i = 0; i < cartGridSize; ++i) {
-                thickness[i] = ecl_grid.getCellThickness(i);
-            }
             const double z_tolerance = ecl_grid.isPinchActive() ?  ecl_grid.getPinchThresholdThickness() : 0.0;
             const bool nogap = ecl_grid.getPinchGapMode() ==  Opm::PinchMode::ModeEnum::NOGAP;
             const auto& poreVolume = ecl_state->fieldProps().porv(true);
-            minpv_result = mp.process(thickness, z_tolerance, poreVolume, ecl_grid.getMinpvVector(), actnumData, false, zcornData.data(), nogap);
+            // The cell thickness is computed from ZCORN by the processor.
+            minpv_result = mp.process({}, z_tolerance, poreVolume, ecl_grid.getMinpvVector(), actnumData, false, zcornData.data(), nogap);
             if (minpv_result.nnc.size() > 0) {
                 this->zcorn = zcornData;
             }
         }
 
         NNCMaps nnc_cells;
-        // Add PINCH NNCs.
-        for (const auto& [cell1, cell2] : minpv_result.nnc)
-            nnc_cells[PinchNNC].insert({cell1, cell2});
+        // Add PINCH NNCs, the map yields them sorted and unique.
+        nnc_cells[PinchNNC].assign(minpv_result.nnc.begin(), minpv_result.nnc.end());
 
         // Add explicit NNCs.
         if (ecl_state) {
             const auto& nncs = ecl_state->getInputNNC();
-            for (const auto single_nnc : nncs.input()) {
-                // Repeated NNCs will only exist in the map once (repeated
-                // insertions have no effect). The code that computes the
+            nnc_cells[ExplicitNNC].reserve(nncs.input().size());
+            for (const auto& single_nnc : nncs.input()) {
+                // Repeated NNCs will only exist in the list once (they
+                // are removed when sorting). The code that computes the
                 // transmissibilities is responsible for ensuring repeated NNC
                 // transmissibilities are added.
-                nnc_cells[ExplicitNNC].insert({single_nnc.cell1, single_nnc.cell2});
+                nnc_cells[ExplicitNNC].emplace_back(single_nnc.cell1, single_nnc.cell2);
             }
         }
 
@@ -236,6 +233,7 @@ namespace cpgrid
             // Make the grid.
             processEclipseFormat(g, ecl_state, nnc_cells, false, turn_normals, pinchActive);
         }
+        phase.setCounts(size(0), face_to_cell_.size(), size(3));
 
         return minpv_result.removed_cells;
     }
@@ -254,21 +252,35 @@ namespace cpgrid
         {
             OPM_THROW(std::logic_error, "Processing  eclipse file only allowed on rank 0");
         }
+        ConstructionTimings::Phase phase(*timings_, "processGrid");
         // Process.
 #ifdef VERBOSE
         std::cout << "Processing eclipse data." << std::endl;
 #endif
+        for (auto& nnc_list : nnc) {
+            sortAndRemoveDuplicates(nnc_list);
+        }
+
         processed_grid output;
-        if (ecl_state && ecl_state->aquifer().hasNumericalAquifer()) {
-            const auto aquifer_cell_volumes = ecl_state->aquifer().numericalAquifers().aquiferCellVolumes();
-            const size_t global_nc = input_data.dims[0] * input_data.dims[1] * input_data.dims[2];
-            std::vector<int> is_aquifer_cell(global_nc, 0);
-            for ([[maybe_unused]]const auto&[global_index, volume] : aquifer_cell_volumes) {
-                is_aquifer_cell[global_index] = 1;
+        {
+            ConstructionTimings::Phase process(*timings_, "process_grdecl");
+            if (ecl_state && ecl_state->aquifer().hasNumericalAquifer()) {
+                const auto aquifer_cell_volumes = ecl_state->aquifer().numericalAquifers().aquiferCellVolumes();
+                const size_t global_nc = input_data.dims[0] * input_data.dims[1] * input_data.dims[2];
+                std::vector<int> is_aquifer_cell(global_nc, 0);
+                for ([[maybe_unused]]const auto&[global_index, volume] : aquifer_cell_volumes) {
+                    is_aquifer_cell[global_index] = 1;
+                }
+                process_grdecl(&input_data, 0, is_aquifer_cell.data(), &output, pinchActive);
+            } else {
+                process_grdecl(&input_data, 0, nullptr, &output, pinchActive);
             }
-            process_grdecl(&input_data, 0, is_aquifer_cell.data(), &output, pinchActive);
-        } else {
-            process_grdecl(&input_data, 0, nullptr, &output, pinchActive);
+            process.setCounts(output.number_of_cells, output.number_of_faces, output.number_of_nodes);
+        }
+        if (output.number_of_degenerate_intersections > 0) {
+            Opm::OpmLog::warning("degenerate_intersections",
+                                 std::to_string(output.number_of_degenerate_intersections)
+                                 + " fault intersections between (nearly) parallel lines were placed at a fallback position.");
         }
         if (remove_ij_boundary) {
             removeOuterCellLayer(output);
@@ -289,9 +301,10 @@ namespace cpgrid
                 const auto& aquifer_nnc = aquifer.numericalAquifers().aquiferConnectionNNCs(ecl_grid, fp);
                 // We need to update the nnc in the ecl_state
                 ecl_state->appendInputNNC(aquifer_nnc);
-                for (const auto single_nnc : aquifer_nnc) {
-                    nnc[ExplicitNNC].insert({single_nnc.cell1, single_nnc.cell2});
+                for (const auto& single_nnc : aquifer_nnc) {
+                    nnc[ExplicitNNC].emplace_back(single_nnc.cell1, single_nnc.cell2);
                 }
+                sortAndRemoveDuplicates(nnc[ExplicitNNC]);
             }
         }
 
@@ -300,26 +313,42 @@ namespace cpgrid
         std::cout << "Building topology." << std::endl;
 #endif
         std::vector<int> face_to_output_face;
-        buildTopo(output, nnc, global_cell_, cell_to_face_, face_to_cell_, face_to_point_, cell_to_point_, face_to_output_face);
+        {
+            ConstructionTimings::Phase topo(*timings_, "buildTopo");
+            buildTopo(output, nnc, global_cell_, cell_to_face_, face_to_cell_, face_to_point_, cell_to_point_, face_to_output_face);
+            topo.setCounts(cell_to_face_.size(), face_to_cell_.size(), output.number_of_nodes);
+        }
         std::copy(output.dimensions, output.dimensions + 3, logical_cartesian_size_.begin());
 
 #ifdef VERBOSE
         std::cout << "Building geometry." << std::endl;
 #endif
-        // here we need the cell volumes based on the active index order
-        std::unordered_map<size_t, double> aquifer_cell_volumes_local;
-        if (ecl_state && ecl_state->aquifer().hasNumericalAquifer()) {
-            const auto& aquifer_cell_volumes = ecl_state->aquifer().numericalAquifers().aquiferCellVolumes();
-            for (auto nc = this->global_cell_.size(), i = 0 * nc; i < nc; ++i) {
-                auto aquCellPos = aquifer_cell_volumes.find(this->global_cell_[i]);
-                if (aquCellPos != aquifer_cell_volumes.end()) {
-                    aquifer_cell_volumes_local.emplace(i, aquCellPos->second);
+        {
+            ConstructionTimings::Phase geom(*timings_, "buildGeom");
+            // here we need the cell volumes based on the active index order
+            std::unordered_map<size_t, double> aquifer_cell_volumes_local;
+            if (ecl_state && ecl_state->aquifer().hasNumericalAquifer()) {
+                const auto& aquifer_cell_volumes = ecl_state->aquifer().numericalAquifers().aquiferCellVolumes();
+                for (auto nc = this->global_cell_.size(), i = 0 * nc; i < nc; ++i) {
+                    auto aquCellPos = aquifer_cell_volumes.find(this->global_cell_[i]);
+                    if (aquCellPos != aquifer_cell_volumes.end()) {
+                        aquifer_cell_volumes_local.emplace(i, aquCellPos->second);
+                    }
                 }
             }
+            buildPointGeom(output, geometry_.geomVector(std::integral_constant<int,3>()));
+            if (lazy_geometry_) {
+                // The face and cell geometry is computed on first access.
+                deferred_geometry_ = std::make_unique<DeferredGeometry>();
+                deferred_geometry_->turn_normals = turn_normals;
+                deferred_geometry_->aquifer_cell_volumes = std::move(aquifer_cell_volumes_local);
+            } else {
+                deferred_geometry_.reset();
+                computeFaceGeometry(turn_normals);
+                computeCellGeometry(aquifer_cell_volumes_local);
+            }
+            geom.setCounts(cell_to_face_.size(), face_to_cell_.size(), size(3));
         }
-        buildGeom(output, cell_to_face_, cell_to_point_, face_to_output_face, aquifer_cell_volumes_local, geometry_.geomVector(std::integral_constant<int,0>()),
-                  geometry_.geomVector(std::integral_constant<int,1>()), geometry_.geomVector(std::integral_constant<int,3>()),
-                  face_normals_, turn_normals);
 
 #ifdef VERBOSE
         std::cout << "Assigning face tags." << std::endl;
@@ -347,6 +376,7 @@ namespace cpgrid
         if(ccobj_.size()>1)
             populateGlobalCellIndexSet();
 
+        phase.setCounts(size(0), face_to_cell_.size(), size(3));
 #ifdef VERBOSE
         std::cout << "Done with grid processing." << std::endl;
 #endif
@@ -370,15 +400,14 @@ namespace cpgrid
         {
             std::vector<double> zcornData = ecl_grid.getZCORN();
 
-            auto repair = ::Opm::UgGridHelpers::RepairZCORN {
-                std::move(zcornData), actnumData,
+            // Repaired in place.
+            const auto repair = ::Opm::UgGridHelpers::RepairZCORN {
+                zcornData.data(), actnumData,
                 std::vector<std::size_t>{ ecl_grid.getNX() ,
                                           ecl_grid.getNY() ,
                                           ecl_grid.getNZ() }
             };
 
-            zcornData = repair.destructivelyGrabSanitizedValues();
-
             if (repair.switchedToDepth()) {
                 std::cout << "ZCORN Values Switched from Elevation to "
                           << "Depth (Sign Reversal)\n";
@@ -689,7 +718,7 @@ namespace cpgrid
             for (int face = 0; face < grid.number_of_faces; ++face) {
                 if (grid.face_neighbors[2*face] != -1 || grid.face_neighbors[2*face + 1] != -1) {
                     // Face is reachable
-                    for (int ii = grid.face_ptr[face]; ii < grid.face_ptr[face + 1]; ++ii) {
+                    for (cpg_offset_t ii = grid.face_ptr[face]; ii < grid.face_ptr[face + 1]; ++ii) {
                         int node = grid.face_nodes[ii];
                         old_to_new[node] = 0;
                     }
@@ -706,7 +735,7 @@ namespace cpgrid
             }
 
             //   2. Use old_to_new to transform grid.face_nodes and grid.node_coordinates[].
-            for (int fnode = 0; fnode < grid.face_ptr[grid.number_of_faces]; ++fnode) {
+            for (cpg_offset_t fnode = 0; fnode < grid.face_ptr[grid.number_of_faces]; ++fnode) {
                 int old = grid.face_nodes[fnode];
                 grid.face_nodes[fnode] = old_to_new[old];
             }
@@ -728,6 +757,18 @@ namespace cpgrid
 
 
 
+        void sortAndRemoveDuplicates(NNCMap& nnc)
+        {
+            if (!std::is_sorted(nnc.begin(), nnc.end())) {
+                std::sort(nnc.begin(), nnc.end());
+            }
+            nnc.erase(std::unique(nnc.begin(), nnc.end()), nnc.end());
+        }
+
+
+
+
+
         std::vector<int> createGlobalToLocal(const processed_grid& output,
                                              const std::vector<int>& global_cell)
         {
@@ -768,26 +809,41 @@ namespace cpgrid
             }
             // Sort face->cell mappings according to first, then second cell.
             std::sort(face_cells.begin(), face_cells.end());
-            // For each nnc, add it to filtered_nnc only if not found in face->cell mappings.
-            for (const auto& nncpair : nnc) {
+            // Classify all nncs in one (parallel) pass, an nnc is kept
+            // only if not found in face->cell mappings.
+            enum { Keep, Invalid, Inactive, Existing };
+            const int num_nnc = nnc.size();
+            std::vector<char> status(num_nnc);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int n = 0; n < num_nnc; ++n) {
+                const auto& nncpair = nnc[n];
                 if (nncpair.first < 0 || nncpair.second < 0 ||
                     nncpair.first >= static_cast<int>(global_to_local.size()) ||
                     nncpair.second >= static_cast<int>(global_to_local.size())) {
-                    Opm::OpmLog::warning("nnc_invalid", "NNC connection requested between invalid cells.");
+                    status[n] = Invalid;
                     continue;
                 }
                 const int c1 = global_to_local[nncpair.first];
                 const int c2 = global_to_local[nncpair.second];
                 if (c1 < 0 || c2 < 0) {
-                    Opm::OpmLog::warning("nnc_inactive", "NNC connection requested between inactive cells.");
-                    continue;
+                    status[n] = Inactive;
+                } else if (std::binary_search(face_cells.begin(), face_cells.end(), std::make_pair(c1, c2))) {
+                    status[n] = Existing;
+                } else {
+                    status[n] = Keep;
                 }
-                const auto beg = std::lower_bound(face_cells.begin(), face_cells.end(), std::make_pair(c1, -1));
-                const auto end = std::find_if(beg, face_cells.end(), [c1](const std::pair<int, int>& p){ return p.first > c1; });
-                const auto it = std::find_if(beg, end, [c2](const std::pair<int, int>& p){ return p.second == c2; });
-                if (it == end) {
-                    // The connection (c1, c2) was not found in the face->cell mapping.
-                    filtered_nnc.insert(nncpair);
+            }
+            // The nnc list is sorted, and so is the filtered one.
+            filtered_nnc.reserve(std::count(status.begin(), status.end(), Keep));
+            for (int n = 0; n < num_nnc; ++n) {
+                if (status[n] == Invalid) {
+                    Opm::OpmLog::warning("nnc_invalid", "NNC connection requested between invalid cells.");
+                } else if (status[n] == Inactive) {
+                    Opm::OpmLog::warning("nnc_inactive", "NNC connection requested between inactive cells.");
+                } else if (status[n] == Keep) {
+                    filtered_nnc.push_back(nnc[n]);
                 }
             }
             return filtered_nnc;
@@ -865,8 +921,10 @@ namespace cpgrid
                         // at the bottom of the cell.
                         if(fnc[0] != -1)
                         {
-                            auto it = nnc[PinchNNC].lower_bound({global_cell[fnc[0]], 0});
-                            if (it != nnc[PinchNNC].end() && it->first == global_cell[fnc[0]]) {
+                            const auto& pinch = nnc[PinchNNC];
+                            auto it = std::lower_bound(pinch.begin(), pinch.end(),
+                                                       std::make_pair(global_cell[fnc[0]], 0));
+                            if (it != pinch.end() && it->first == global_cell[fnc[0]]) {
                                 const int other_cell = global_to_local[it->second];
                                 cells[cellcount].setValue(other_cell, false);
                                 ++cellcount;
@@ -933,7 +991,7 @@ namespace cpgrid
 
             // Build face to point
             const int* fn = output.face_nodes;
-            const int* fp = output.face_ptr;
+            const cpg_offset_t* fp = output.face_ptr;
             for (int face = 0; face < num_faces; ++face) {
                 int output_face = face_to_output_face[face];
                 if (output_face == cpgrid::NNCFace) {
@@ -952,10 +1010,10 @@ namespace cpgrid
                 // We know that the bottom and top faces come last.
                 int numf = cf.size();
                 int bot_face = face_to_output_face[cf[numf - 2].index()];
-                int bfbegin = output.face_ptr[bot_face];
+                const cpg_offset_t bfbegin = output.face_ptr[bot_face];
                 assert(output.face_ptr[bot_face + 1] - bfbegin == 4);
                 int top_face = face_to_output_face[cf[numf - 1].index()];
-                int tfbegin = output.face_ptr[top_face];
+                const cpg_offset_t tfbegin = output.face_ptr[top_face];
                 assert(output.face_ptr[top_face + 1] - tfbegin == 4);
                 // We want the corners in 'x fastest, then y, then z' order,
                 // so we need to take the face_nodes in noncyclic order: 0 1 3 2.
@@ -1045,92 +1103,115 @@ namespace cpgrid
 
 
 
-        void buildGeom(const processed_grid& output,
-                       const cpgrid::OrientedEntityTable<0, 1>& c2f,
-                       const std::vector<std::array<int,8> >& c2p,
-                       const std::vector<int>& face_to_output_face,
-                       const std::unordered_map<size_t, double>& aquifer_cell_volumes,
-                       cpgrid::EntityVariable<cpgrid::Geometry<3, 3>, 0>& cell_geom,
-                       cpgrid::EntityVariable<cpgrid::Geometry<2, 3>, 1>& face_geom,
-                       cpgrid::EntityVariable<cpgrid::Geometry<0, 3>, 3>& point_geom,
-                       cpgrid::SignedEntityVariable<FieldVector<double, 3>, 1>& normals,
-                       bool turn_normals)
+        void buildPointGeom(const processed_grid& output,
+                            cpgrid::EntityVariable<cpgrid::Geometry<0, 3>, 3>& point_geom)
         {
-            typedef FieldVector<double, 3> point_t;
-            std::vector<point_t> points;
-            std::vector<point_t> face_normals;
-            std::vector<point_t> face_centroids;
-            std::vector<double>  face_areas;
-            std::vector<point_t> cell_centroids;
-            std::vector<double>  cell_volumes;
-            using namespace GeometryHelpers;
-#ifdef VERBOSE
-            Opm::time::StopWatch clock;
-            clock.start();
-#endif
-            // Get the points.
-            int np = output.number_of_nodes;
-            points.clear();
-            points.reserve(np);
+            const int np = output.number_of_nodes;
+            point_geom.assign(np, cpgrid::Geometry<0, 3>());
             for (int i = 0; i < np; ++i) {
                 // \TODO add a convenience explicit constructor
                 // for FieldVector taking an iterator.
-                point_t pt;
+                FieldVector<double, 3> pt;
                 for (int dd = 0; dd < 3; ++dd) {
                     pt[dd] = output.node_coordinates[3*i + dd];
                 }
-                points.push_back(pt);
+                point_geom.get(i) = cpgrid::Geometry<0, 3>(pt);
             }
-#ifdef VERBOSE
-            std::cout << "Points:             " << clock.secsSinceLast() << std::endl;
-#endif
+        }
+    } // anon namespace
 
-            // Get the face data.
-            // \TODO Both the face and (especially) the cell section
-            // is not very efficient. It could be rewritten easily
-            // (focus on the polygonCellXXX methods first).
-            // \TODO Use exact geometry instead of these approximations.
-            int nf = face_to_output_face.size();
-            const int* fn = output.face_nodes;
-            const int* fp = output.face_ptr;
-            for (int face = 0; face < nf; ++face) {
-                // Computations in this loop could be speeded up
-                // by doing more of them simultaneously.
-                int output_face = face_to_output_face[face];
-                if (output_face == cpgrid::NNCFace) {
-                    // NNC faces are purely topological constructs,
-                    // and do not have any embedded geometry.
-                    // However, since the ewoms code will multiply and
-                    // divide by the face area even if not necessary
-                    // for the cell-centered FV discretization (because
-                    // it wants to deal with velocities rather than fluxes),
-                    // we have to set the areas to 1 to avoid trouble.
-                    face_normals.push_back({-1e100, -1e100, -1e100});
-                    face_centroids.push_back({-1e100, -1e100, -1e100});
-                    face_areas.push_back(1.0);
-                } else {
-                    IndirectArray<point_t> face_pts(points, fn + fp[output_face], fn + fp[output_face+1]);
-                    point_t avg = average(face_pts);
-                    point_t centroid = polygonCentroid(face_pts, avg);
-                    point_t normal = polygonNormal(face_pts, centroid);
-                    double area = polygonArea(face_pts, centroid);
-                    face_normals.push_back(normal);
-                    face_centroids.push_back(centroid);
-                    face_areas.push_back(area);
+
+
+namespace cpgrid
+{
+
+    void CpGridData::computeFaceGeometry(bool turn_normals)
+    {
+        typedef FieldVector<double, 3> point_t;
+        using namespace GeometryHelpers;
+        const auto& point_geom = geometry_.geomVector(std::integral_constant<int,3>());
+        const int np = point_geom.size();
+        std::vector<point_t> points(np);
+        for (int i = 0; i < np; ++i) {
+            points[i] = point_geom.get(i).center();
+        }
+
+        // \TODO Use exact geometry instead of these approximations.
+        const int nf = face_to_point_.size();
+        auto& face_geom = geometry_.geomVector(std::integral_constant<int,1>());
+        face_geom.assign(nf, Geometry<2, 3>());
+        face_normals_.assign(nf, point_t(0.0));
+        MakeGeometry<2> mfaceg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int face = 0; face < nf; ++face) {
+            const auto face_points = face_to_point_[face];
+            if (face_points.empty()) {
+                // NNC faces are purely topological constructs,
+                // and do not have any embedded geometry.
+                // However, since the ewoms code will multiply and
+                // divide by the face area even if not necessary
+                // for the cell-centered FV discretization (because
+                // it wants to deal with velocities rather than fluxes),
+                // we have to set the areas to 1 to avoid trouble.
+                point_t normal = {-1e100, -1e100, -1e100};
+                if (turn_normals) {
+                    normal *= -1.0;
                 }
+                face_normals_.get(face) = normal;
+                face_geom.get(face) = mfaceg(point_t{-1e100, -1e100, -1e100}, 1.0);
+                continue;
             }
-#ifdef VERBOSE
-            std::cout << "Faces:              " << clock.secsSinceLast() << std::endl;
+            const int* fn = &*face_points.begin();
+            IndirectArray<point_t> face_pts(points, fn, fn + face_points.size());
+            point_t avg = average(face_pts);
+            point_t centroid = polygonCentroid(face_pts, avg);
+            point_t normal = polygonNormal(face_pts, centroid);
+            double area = polygonArea(face_pts, centroid);
+            if (turn_normals) {
+                normal *= -1.0;
+            }
+            face_normals_.get(face) = normal;
+            face_geom.get(face) = mfaceg(centroid, area);
+        }
+    }
+
+    void CpGridData::computeCellGeometry(const std::unordered_map<std::size_t, double>& aquifer_cell_volumes)
+    {
+        typedef FieldVector<double, 3> point_t;
+        using namespace GeometryHelpers;
+        const auto& point_geom = geometry_.geomVector(std::integral_constant<int,3>());
+        const int np = point_geom.size();
+        std::vector<point_t> points(np);
+        for (int i = 0; i < np; ++i) {
+            points[i] = point_geom.get(i).center();
+        }
+        const auto& face_geom = geometry_.geomVector(std::integral_constant<int,1>());
+        const int nf = face_geom.size();
+        std::vector<point_t> face_centroids(nf);
+        for (int face = 0; face < nf; ++face) {
+            face_centroids[face] = face_geom.get(face).center();
+        }
+
+        const int nc = cell_to_face_.size();
+        auto& cell_geom = geometry_.geomVector(std::integral_constant<int,0>());
+        cell_geom.assign(nc, Geometry<3, 3>());
+        MakeGeometry<3> mcellg(point_geom);
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
-            // Get the cell data.
-            int nc = output.number_of_cells;
+        {
             std::vector<int> face_indices;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
             for (int cell = 0; cell < nc; ++cell) {
-                cpgrid::EntityRep<0> cell_ent(cell, true);
-                cpgrid::OrientedEntityTable<0, 1>::row_type cf = c2f[cell_ent];
+                OrientedEntityTable<0, 1>::row_type cf = cell_to_face_[EntityRep<0>(cell, true)];
                 face_indices.clear();
                 for (int local_index = 0; local_index < cf.size(); ++local_index) {
-                    if (face_to_output_face[cf[local_index].index()] != cpgrid::NNCFace) {
+                    // NNC faces do not contribute to the cell geometry.
+                    if (!face_to_point_[cf[local_index].index()].empty()) {
                         face_indices.push_back(cf[local_index].index());
                     }
                 }
@@ -1138,14 +1219,10 @@ namespace cpgrid
                 point_t cell_avg = average(cell_pts);
                 point_t cell_centroid(0.0);
                 double tot_cell_vol = 0.0;
-                for (int local_index = 0; local_index < cf.size(); ++local_index) {
-                    int face = cf[local_index].index();
-                    int output_face = face_to_output_face[face];
-                    if (output_face == cpgrid::NNCFace) {
-                        // Skip NNC face, do not contribute to cell geometry.
-                        continue;
-                    }
-                    IndirectArray<point_t> face_pts(points, fn + fp[output_face], fn + fp[output_face+1]);
+                for (const int face : face_indices) {
+                    const auto face_points = face_to_point_[face];
+                    const int* fn = &*face_points.begin();
+                    IndirectArray<point_t> face_pts(points, fn, fn + face_points.size());
                     double small_vol = polygonCellVolume(face_pts, face_centroids[face], cell_avg);
                     tot_cell_vol += small_vol;
                     point_t face_contrib = polygonCellCentroid(face_pts, face_centroids[face], cell_avg);
@@ -1164,63 +1241,36 @@ namespace cpgrid
                 cell_centroid += face_centroids[face_indices[numf - 1]];
                 cell_centroid *= 0.5;
 #endif
-                cell_centroids.push_back(cell_centroid);
-                cell_volumes.push_back(tot_cell_vol);
+                cell_geom.get(cell) = mcellg(cell_centroid, tot_cell_vol, cell_to_point_[cell]);
             }
-            // update the volumes of numerical aquifer cells
-            for (const auto& [index, volume] : aquifer_cell_volumes) {
-                cell_volumes[index] = volume;
-            }
-
-
-
-#ifdef VERBOSE
-            std::cout << "Cells:              " << clock.secsSinceLast() << std::endl;
-#endif
-
-
-            // \TODO Fix the code below , as it is:
-            // A) wasteful
-            // B) wordy,
-            // C) slow
-            // D) copied from readSintefLegacyFormat.cpp
-            // Points
-            // Points
-            point_geom.reserve(points.size());
-            MakeGeometry<0> mpointg;
-            std::transform(points.begin(), points.end(),
-                           std::back_inserter(point_geom), mpointg);
-            // Cells
-            cell_geom.reserve(nc);
-            MakeGeometry<3> mcellg(point_geom);
-//             std::transform(cell_centroids.begin(), cell_centroids.end(),
-//                            cell_volumes.begin(),
-//                            std::back_inserter(cell_geom, mcellg);
-            for (int c = 0;  c < nc; ++c) {
-                cell_geom.push_back(mcellg(cell_centroids[c], cell_volumes[c], c2p[c]));
-            }
-            // Faces
-            face_geom.reserve(face_centroids.size());
-            MakeGeometry<2> mfaceg;
-            std::transform(face_centroids.begin(), face_centroids.end(),
-                           face_areas.begin(),
-                           std::back_inserter(face_geom), mfaceg);
-#ifdef VERBOSE
-            std::cout << "Transforms/copies:  " << clock.secsSinceLast() << std::endl;
-#endif
+        }
+        // update the volumes of numerical aquifer cells
+        for (const auto& [index, volume] : aquifer_cell_volumes) {
+            const auto& geom = cell_geom.get(index);
+            cell_geom.get(index) = mcellg(geom.center(), volume, cell_to_point_[index]);
+        }
+    }
 
-            // The final, combined object (yes, a lot of copying goes on here).
-            if (turn_normals) {
-                int num_normals = face_normals.size();
-                for (int i = 0; i < num_normals; ++i) {
-                    face_normals[i] *= -1.0;
-                }
-            }
-            normals.assign(face_normals.begin(), face_normals.end());
-#ifdef VERBOSE
-            std::cout << "Final construction: " << clock.secsSinceLast() << std::endl;
-#endif
+    void CpGridData::computeDeferredGeometry(int codim) const
+    {
+        // The geometry is logically part of the grid, only its
+        // computation is deferred. std::call_once makes concurrent
+        // first accesses wait for a single computation.
+        auto& self = const_cast<CpGridData&>(*this);
+        auto& deferred = *deferred_geometry_;
+        std::call_once(deferred.faces, [&self, &deferred]() {
+            ConstructionTimings::Phase phase(*self.timings_, "computeFaceGeometry");
+            self.computeFaceGeometry(deferred.turn_normals);
+            phase.setCounts(-1, self.face_to_cell_.size(), -1);
+        });
+        if (codim == 0) {
+            std::call_once(deferred.cells, [&self, &deferred]() {
+                ConstructionTimings::Phase phase(*self.timings_, "computeCellGeometry");
+                self.computeCellGeometry(deferred.aquifer_cell_volumes);
+                phase.setCounts(self.cell_to_face_.size(), -1, -1);
+            });
         }
-    } // anon namespace
-} // namespace Dune
+    }
 
+} // end namespace cpgrid
+} // namespace Dune
@@ -85,6 +85,9 @@ namespace Dune
             if (!file) {
                 OPM_THROW(std::runtime_error, "Could not open file " << geomfilename);
             }
+            if (deferred_geometry_) {
+                computeDeferredGeometry(0);
+            }
             writeGeom(file, geometry_, face_normals_);
         }
         std::string mapfilename = grid_prefix + "-map.dat";
@@ -0,0 +1,311 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/grid/UnstructuredGrid.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    bool isSpace(const char c)
+    {
+        return (c == ' ') || (c == '\n') || (c == '\t') ||
+               (c == '\r') || (c == '\v') || (c == '\f');
+    }
+
+    // Parse a complete token [begin, end) as an integer or a double.
+    // A leading '+' is accepted by scanf() but not by from_chars().
+    bool parseToken(const char* begin, const char* end, long long& value)
+    {
+        if (begin != end && *begin == '+') { ++begin; }
+        const auto res = std::from_chars(begin, end, value);
+        return (res.ec == std::errc()) && (res.ptr == end);
+    }
+
+    bool parseToken(const char* begin, const char* end, int& value)
+    {
+        if (begin != end && *begin == '+') { ++begin; }
+        const auto res = std::from_chars(begin, end, value);
+        return (res.ec == std::errc()) && (res.ptr == end);
+    }
+
+    bool parseToken(const char* begin, const char* end, double& value)
+    {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        if (begin != end && *begin == '+') { ++begin; }
+        const auto res = std::from_chars(begin, end, value);
+        return (res.ec == std::errc()) && (res.ptr == end);
+#else
+        // Floating point from_chars() not available, the token is
+        // followed by whitespace or the terminating null character.
+        char* stop = nullptr;
+        value = std::strtod(begin, &stop);
+        return stop == end;
+#endif
+    }
+
+    // Locate next token at or after pos. Returns false at end of input.
+    bool nextToken(const char*& pos, const char* end,
+                   const char*& tok_begin, const char*& tok_end)
+    {
+        while (pos != end && isSpace(*pos)) { ++pos; }
+        if (pos == end) {
+            return false;
+        }
+        tok_begin = pos;
+        while (pos != end && !isSpace(*pos)) { ++pos; }
+        tok_end = pos;
+        return true;
+    }
+
+    template <typename T>
+    bool readHeaderValue(const char*& pos, const char* end, T& value)
+    {
+        const char* b = nullptr;
+        const char* e = nullptr;
+        return nextToken(pos, end, b, e) && parseToken(b, e, value);
+    }
+
+    // A contiguous range of tokens stored to one array, or to two
+    // arrays alternately (cell_faces and cell_facetag).
+    struct Segment
+    {
+        std::size_t begin;  // First token index
+        std::size_t count;  // Number of tokens
+        int* ints[2];
+        double* doubles;
+    };
+
+    bool storeToken(const Segment& seg, const std::size_t t,
+                    const char* b, const char* e)
+    {
+        const std::size_t k = t - seg.begin;
+        if (seg.doubles != nullptr) {
+            return parseToken(b, e, seg.doubles[k]);
+        }
+        if (seg.ints[1] != nullptr) {
+            return parseToken(b, e, seg.ints[k % 2][k / 2]);
+        }
+        return parseToken(b, e, seg.ints[0][k]);
+    }
+
+    struct FreeDeleter
+    {
+        void operator()(char* p) const { std::free(p); }
+    };
+
+    // Read the whole file in a single operation, null-terminated.
+    std::unique_ptr<char, FreeDeleter> readFile(const char* fname, std::size_t& size)
+    {
+        std::unique_ptr<char, FreeDeleter> buf;
+        FILE* fp = std::fopen(fname, "rb");
+        if (fp == nullptr) {
+            return buf;
+        }
+        if (std::fseek(fp, 0, SEEK_END) == 0) {
+            const long len = std::ftell(fp);
+            if (len >= 0 && std::fseek(fp, 0, SEEK_SET) == 0) {
+                size = len;
+                buf.reset(static_cast<char*>(std::malloc(size + 1)));
+                if (buf && std::fread(buf.get(), 1, size, fp) == size) {
+                    buf.get()[size] = '\0';
+                } else {
+                    buf.reset();
+                }
+            }
+        }
+        std::fclose(fp);
+        return buf;
+    }
+
+    struct GridDeleter
+    {
+        void operator()(UnstructuredGrid* g) const { destroy_grid(g); }
+    };
+
+} // anonymous namespace
+
+
+struct UnstructuredGrid *
+read_grid_text_parallel(const char *fname)
+{
+    std::size_t size = 0;
+    auto buf = readFile(fname, size);
+    if (!buf) {
+        return nullptr;
+    }
+    const char* pos = buf.get();
+    const char* const end = pos + size;
+
+    // Header, see allocate_grid_from_file() in UnstructuredGrid.c.
+    enum { NDims, NCells, NFaces, NNodes, NFaceNodes, NCellFaces, NMeta };
+    long long dimens[NMeta];
+    for (int i = 0; i < NMeta; ++i) {
+        if (!readHeaderValue(pos, end, dimens[i]) || dimens[i] < 0) {
+            return nullptr;
+        }
+    }
+    int has_tag = 0, has_indexmap = 0;
+    if (!readHeaderValue(pos, end, has_tag) || !readHeaderValue(pos, end, has_indexmap)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<UnstructuredGrid, GridDeleter>
+        G(allocate_grid(dimens[NDims], dimens[NCells], dimens[NFaces],
+                        dimens[NFaceNodes], dimens[NCellFaces], dimens[NNodes]));
+    if (!G) {
+        return nullptr;
+    }
+    if (!has_tag) {
+        std::free(G->cell_facetag);
+        G->cell_facetag = nullptr;
+    }
+    if (has_indexmap) {
+        G->global_cell = static_cast<int*>(std::malloc(dimens[NCells] * sizeof *G->global_cell));
+        if (G->global_cell == nullptr) {
+            return nullptr;
+        }
+    }
+    const int num_cartdims = sizeof(G->cartdims) / sizeof(G->cartdims[0]);
+    for (int i = 0; i < num_cartdims; ++i) {
+        if (i < dimens[NDims]) {
+            if (!readHeaderValue(pos, end, G->cartdims[i])) {
+                return nullptr;
+            }
+        } else {
+            G->cartdims[i] = 1;
+        }
+    }
+
+    // Layout of the remaining tokens. The sequential reader takes the
+    // number of face-nodes and cell-faces from the position arrays,
+    // we take them from the header and check consistency afterwards.
+    const std::size_t nd = dimens[NDims];
+    const std::size_t nc = dimens[NCells];
+    const std::size_t nf = dimens[NFaces];
+    const std::size_t ncf = dimens[NCellFaces];
+    std::vector<Segment> segments;
+    std::size_t num_tokens = 0;
+    auto addSegment = [&](std::size_t count, int* i0, int* i1, double* d)
+    {
+        segments.push_back(Segment{ num_tokens, count, { i0, i1 }, d });
+        num_tokens += count;
+    };
+    addSegment(nd * dimens[NNodes], nullptr, nullptr, G->node_coordinates);
+    addSegment(nf + 1, G->face_nodepos, nullptr, nullptr);
+    addSegment(dimens[NFaceNodes], G->face_nodes, nullptr, nullptr);
+    addSegment(2 * nf, G->face_cells, nullptr, nullptr);
+    addSegment(nf, nullptr, nullptr, G->face_areas);
+    addSegment(nd * nf, nullptr, nullptr, G->face_centroids);
+    addSegment(nd * nf, nullptr, nullptr, G->face_normals);
+    addSegment(nc + 1, G->cell_facepos, nullptr, nullptr);
+    if (has_tag) {
+        addSegment(2 * ncf, G->cell_faces, G->cell_facetag, nullptr);
+    } else {
+        addSegment(ncf, G->cell_faces, nullptr, nullptr);
+    }
+    if (has_indexmap) {
+        addSegment(nc, G->global_cell, nullptr, nullptr);
+    }
+    addSegment(nc, nullptr, nullptr, G->cell_volumes);
+    addSegment(nd * nc, nullptr, nullptr, G->cell_centroids);
+    segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                  [](const Segment& s) { return s.count == 0; }),
+                   segments.end());
+
+    // Split the body into chunks starting at whitespace, so that no
+    // token straddles two chunks.
+#ifdef _OPENMP
+    const int num_threads = omp_get_max_threads();
+#else
+    const int num_threads = 1;
+#endif
+    const std::size_t min_chunk_size = 1 << 16;
+    const std::size_t body_size = end - pos;
+    const int num_chunks = std::max<std::size_t>(1, std::min<std::size_t>(body_size / min_chunk_size,
+                                                                          16 * num_threads));
+    std::vector<const char*> chunk_begin(num_chunks + 1, end);
+    chunk_begin[0] = pos;
+    for (int c = 1; c < num_chunks; ++c) {
+        const char* b = std::max(chunk_begin[c - 1], pos + c * (body_size / num_chunks));
+        while (b != end && !isSpace(*b)) { ++b; }
+        chunk_begin[c] = b;
+    }
+
+    // Pass 1: count tokens per chunk.
+    std::vector<std::size_t> first_token(num_chunks + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < num_chunks; ++c) {
+        std::size_t count = 0;
+        bool in_token = false;
+        for (const char* p = chunk_begin[c]; p != chunk_begin[c + 1]; ++p) {
+            const bool space = isSpace(*p);
+            count += !space && !in_token;
+            in_token = !space;
+        }
+        first_token[c + 1] = count;
+    }
+    for (int c = 0; c < num_chunks; ++c) {
+        first_token[c + 1] += first_token[c];
+    }
+    if (first_token[num_chunks] < num_tokens) {
+        return nullptr;
+    }
+
+    // Pass 2: parse tokens into their destination arrays. Trailing
+    // tokens are ignored, as by the sequential reader.
+    bool ok = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(&&: ok)
+#endif
+    for (int c = 0; c < num_chunks; ++c) {
+        std::size_t t = first_token[c];
+        if (t >= num_tokens) {
+            continue;
+        }
+        auto seg = std::upper_bound(segments.begin(), segments.end(), t,
+                                    [](std::size_t tok, const Segment& s) { return tok < s.begin; }) - 1;
+        const char* p = chunk_begin[c];
+        const char* b = nullptr;
+        const char* e = nullptr;
+        while (ok && t < num_tokens && nextToken(p, chunk_begin[c + 1], b, e)) {
+            while (t >= seg->begin + seg->count) { ++seg; }
+            ok = storeToken(*seg, t, b, e);
+            ++t;
+        }
+    }
+
+    ok = ok
+        && (G->face_nodepos[nf] == dimens[NFaceNodes])
+        && (G->cell_facepos[nc] == dimens[NCellFaces]);
+
+    return ok ? G.release() : nullptr;
+}
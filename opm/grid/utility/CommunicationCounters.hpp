@@ -0,0 +1,103 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_COMMUNICATIONCOUNTERS_HEADER
+#define OPM_COMMUNICATIONCOUNTERS_HEADER
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace Opm
+{
+
+/// \brief Volume and time of data exchanges, summed over the exchanges.
+///
+/// The counts are stored as doubles, such that averages over ranks can
+/// be stored in the same type.
+struct CommunicationCounters
+{
+    /// \brief Number of exchanges.
+    double calls = 0.0;
+    /// \brief Number of messages sent.
+    double messages = 0.0;
+    /// \brief Number of bytes sent.
+    double bytes = 0.0;
+    /// \brief The largest number of neighbor ranks of an exchange.
+    double neighbors = 0.0;
+    /// \brief Seconds spent waiting for messages.
+    double wait_seconds = 0.0;
+    /// \brief Seconds spent gathering data into messages.
+    double pack_seconds = 0.0;
+    /// \brief Seconds spent scattering data from messages.
+    double unpack_seconds = 0.0;
+
+    /// \brief Count a message of a number of items.
+    template<class T>
+    void addMessage(std::size_t items)
+    {
+        messages += 1.0;
+        bytes += items * sizeof(T);
+    }
+
+    CommunicationCounters& operator+=(const CommunicationCounters& other)
+    {
+        calls += other.calls;
+        messages += other.messages;
+        bytes += other.bytes;
+        neighbors = std::max(neighbors, other.neighbors);
+        wait_seconds += other.wait_seconds;
+        pack_seconds += other.pack_seconds;
+        unpack_seconds += other.unpack_seconds;
+        return *this;
+    }
+};
+
+/// \brief Adds the wall time from construction to destruction to a
+///        counter, unless that is null.
+///
+/// Without a counter the clock is not read.
+class CommunicationTimer
+{
+public:
+    explicit CommunicationTimer(double* seconds)
+        : seconds_(seconds)
+    {
+        if (seconds_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    CommunicationTimer(const CommunicationTimer&) = delete;
+    CommunicationTimer& operator=(const CommunicationTimer&) = delete;
+
+    ~CommunicationTimer()
+    {
+        if (seconds_) {
+            *seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+    }
+
+private:
+    double* seconds_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // end namespace Opm
+
+#endif // OPM_COMMUNICATIONCOUNTERS_HEADER
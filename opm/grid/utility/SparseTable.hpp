@@ -38,6 +38,9 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <opm/grid/utility/ErrorMacros.hpp>
 #include <opm/grid/utility/IteratorRange.hpp>
 
@@ -46,14 +49,28 @@
 namespace Opm
 {
 
+    /// The default type of the row start indices of a SparseTable.
+    /// Builds configured with 64-bit grid indices use 64-bit offsets,
+    /// such that the total number of entries may exceed the range of int.
+#if OPM_GRID_64BIT_INDICES
+    using SparseTableIndexType = std::int64_t;
+#else
+    using SparseTableIndexType = int;
+#endif
+
     /// A SparseTable stores a table with rows of varying size
     /// as efficiently as possible.
     /// It is supposed to behave similarly to a vector of vectors.
     /// Its behaviour is similar to compressed row sparse matrices.
-    template <typename T>
+    /// Rows are numbered by int, while positions in the table data
+    /// are of type IndexType.
+    template <typename T, typename IndexType = SparseTableIndexType>
     class SparseTable
     {
     public:
+        /// The type of the positions in the table data.
+        using index_type = IndexType;
+
         /// Default constructor. Yields an empty SparseTable.
         SparseTable()
             : row_start_(1, 0)
@@ -124,25 +141,32 @@ namespace Opm
         }
 
         /// Allocate storage for table of expected size
-        void reserve(int exptd_nrows, int exptd_ndata)
+        void reserve(int exptd_nrows, IndexType exptd_ndata)
         {
             row_start_.reserve(exptd_nrows + 1);
             data_.reserve(exptd_ndata);
         }
 
-        /// Swap contents for other SparseTable<T>
-        void swap(SparseTable<T>& other)
+        /// Swap contents for other SparseTable<T, IndexType>
+        void swap(SparseTable& other)
         {
             row_start_.swap(other.row_start_);
             data_.swap(other.data_);
         }
 
         /// Returns the number of data elements.
-        int dataSize() const
+        IndexType dataSize() const
         {
             return data_.size();
         }
 
+        /// Returns the number of bytes allocated for the data and the
+        /// row start positions.
+        std::size_t allocatedBytes() const
+        {
+            return data_.capacity()*sizeof(T) + row_start_.capacity()*sizeof(IndexType);
+        }
+
         /// Returns the size of a table row.
         int rowSize(int row) const
         {
@@ -235,7 +259,7 @@ namespace Opm
 
             os << "Row starts = [";
             std::copy(row_start_.begin(), row_start_.end(),
-                      std::ostream_iterator<int>(os, " "));
+                      std::ostream_iterator<IndexType>(os, " "));
             os << "\b]\n";
 
             os << "Data values = [";
@@ -243,7 +267,7 @@ namespace Opm
                       std::ostream_iterator<T>(os, " "));
             os << "\b]\n";
         }
-        const T data(int i)const {
+        const T data(IndexType i)const {
         	return data_[i];
         }
 
@@ -251,7 +275,7 @@ namespace Opm
         std::vector<T> data_;
         // Like in the compressed row sparse matrix format,
         // row_start_.size() is equal to the number of rows + 1.
-        std::vector<int> row_start_;
+        std::vector<IndexType> row_start_;
 
 	template <class IntegerIter>
 	void setRowStartsFromSizes(IntegerIter rowsize_beg, IntegerIter rowsize_end)
@@ -264,14 +288,23 @@ namespace Opm
                 }
             }
 #endif
+            if (data_.size() > std::size_t(std::numeric_limits<IndexType>::max())) {
+                OPM_THROW(std::runtime_error, "Table data size exceeds the range of the index type.");
+            }
             // Since we do not store the row sizes, but cumulative row sizes,
             // we have to create the cumulative ones.
             int num_rows = rowsize_end - rowsize_beg;
             row_start_.resize(num_rows + 1);
-            row_start_[0] = 0;
-            std::partial_sum(rowsize_beg, rowsize_end, row_start_.begin() + 1);
+            // Accumulate in IndexType, the row sizes may be of a narrower type.
+            IndexType start = 0;
+            row_start_[0] = start;
+            auto rs = row_start_.begin() + 1;
+            for (auto it = rowsize_beg; it != rowsize_end; ++it, ++rs) {
+                start += *it;
+                *rs = start;
+            }
             // Check that data_ and row_start_ match.
-            if (int(data_.size()) != row_start_.back()) {
+            if (IndexType(data_.size()) != row_start_.back()) {
                 OPM_THROW(std::runtime_error, "End of row start indices different from data size.");
             }
 
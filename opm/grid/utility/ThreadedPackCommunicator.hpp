@@ -0,0 +1,367 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_THREADEDPACKCOMMUNICATOR_HEADER
+#define OPM_THREADEDPACKCOMMUNICATOR_HEADER
+
+#if HAVE_MPI
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dune/common/parallel/interface.hh>
+#include <dune/common/parallel/mpitraits.hh>
+
+#include <opm/grid/utility/CommunicationCounters.hpp>
+
+namespace Opm
+{
+
+/// \brief A message buffer reading or writing contiguous memory.
+///
+/// Each thread packing or unpacking a chunk of a message uses its own
+/// buffer starting at the position of the chunk.
+template<class T>
+class PackBuffer
+{
+public:
+    explicit PackBuffer(T* data)
+        : data_(data)
+    {}
+
+    void write(const T& data)
+    {
+        *data_++ = data;
+    }
+
+    void read(T& data)
+    {
+        data = *data_++;
+    }
+
+private:
+    T* data_;
+};
+
+/// \brief A communicator that packs and unpacks its messages with threads.
+///
+/// Has the interface of VariableSizeCommunicator, but packs the whole
+/// message to each neighbor into a contiguous buffer before sending it.
+/// If a chunk size is given, the index lists of the interface are split
+/// into chunks that are gathered in parallel, and scattered in parallel
+/// after receiving. For data handles of fixed size the position of each
+/// entity in the messages is known up front. Otherwise the sizes are
+/// computed and sent ahead of the data.
+///
+/// The messages are exchanged either point-to-point or, given a
+/// distributed graph communicator of the neighboring ranks, with
+/// MPI_Neighbor_alltoallv.
+///
+/// With threads, the size, gather, and scatter methods of the data handle
+/// are called concurrently with OpenMP and must be thread-safe. Scatter is
+/// only called concurrently for distinct indices, as the messages of the
+/// neighbors are unpacked one after the other.
+///
+/// \tparam InterfaceMap A map from ranks to pairs of send and receive
+///         InterfaceInformation.
+template<class InterfaceMap>
+class ThreadedPackCommunicator
+{
+public:
+    /// \brief Communicate with point-to-point messages.
+    /// \param comm The MPI communicator to use.
+    /// \param interface The communication interface.
+    /// \param chunk_size The number of entities packed or unpacked by a thread
+    ///        at a time. Zero packs and unpacks serially.
+    ThreadedPackCommunicator(MPI_Comm comm, const InterfaceMap& interface, std::size_t chunk_size)
+        : interface_(interface), chunk_size_(chunk_size), graph_neighbors_(nullptr)
+    {
+        MPI_Comm_dup(comm, &communicator_);
+    }
+
+    /// \brief Communicate with neighborhood collectives.
+    /// \param graph_comm A distributed graph communicator whose sources and
+    ///        destinations are both the neighbors.
+    /// \param neighbors The sorted neighbor ranks. Must contain all ranks
+    ///        of the interface.
+    /// \param interface The communication interface.
+    /// \param chunk_size The number of entities packed or unpacked by a thread
+    ///        at a time. Zero packs and unpacks serially.
+    ThreadedPackCommunicator(MPI_Comm graph_comm, const std::vector<int>& neighbors,
+                             const InterfaceMap& interface, std::size_t chunk_size)
+        : communicator_(graph_comm), interface_(interface), chunk_size_(chunk_size),
+          graph_neighbors_(&neighbors)
+    {}
+
+    ~ThreadedPackCommunicator()
+    {
+        if (!graph_neighbors_) {
+            MPI_Comm_free(&communicator_);
+        }
+    }
+
+    ThreadedPackCommunicator(const ThreadedPackCommunicator&) = delete;
+    ThreadedPackCommunicator& operator=(const ThreadedPackCommunicator&) = delete;
+
+    /// \brief Communicate forward.
+    /// \see VariableSizeCommunicator::forward for the interface of the handle.
+    template<class DataHandle>
+    void forward(DataHandle& handle)
+    {
+        communicate<true>(handle);
+    }
+
+    /// \brief Communicate backward.
+    /// \see VariableSizeCommunicator::backward for the interface of the handle.
+    template<class DataHandle>
+    void backward(DataHandle& handle)
+    {
+        communicate<false>(handle);
+    }
+
+    /// \brief Count the messages and time of the communication.
+    /// \param counters The counters to add to, or nullptr to not count.
+    void setCounters(CommunicationCounters* counters)
+    {
+        counters_ = counters;
+    }
+
+private:
+    using Lists = std::vector<const Dune::InterfaceInformation*>;
+
+    /// \brief A range of positions in the index list of a neighbor.
+    struct Chunk
+    {
+        std::size_t neighbor;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /// \brief Split the index lists of the given neighbors into chunks.
+    std::vector<Chunk> chunks(const Lists& lists, std::size_t first, std::size_t last) const
+    {
+        std::vector<Chunk> result;
+        for (std::size_t n = first; n < last; ++n) {
+            const std::size_t size = lists[n]->size();
+            const std::size_t step = chunk_size_ > 0 ? chunk_size_ : size;
+            for (std::size_t begin = 0; begin < size; begin += step) {
+                result.push_back({ n, begin, std::min(size, begin + step) });
+            }
+        }
+        return result;
+    }
+
+    /// \brief Call a function for each chunk, in parallel if threaded.
+    template<class F>
+    void forEachChunk(const std::vector<Chunk>& chunks, const F& f) const
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(chunk_size_ > 0)
+#endif
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            f(chunks[c]);
+        }
+    }
+
+    /// \brief The positions of per-neighbor arrays of list size plus extra
+    ///        entries in one contiguous array, or none if a list is empty.
+    static std::vector<std::size_t> positions(const Lists& lists, std::size_t extra)
+    {
+        std::vector<std::size_t> begin(lists.size() + 1, 0);
+        for (std::size_t n = 0; n < lists.size(); ++n) {
+            begin[n + 1] = begin[n] + (lists[n]->size() ? lists[n]->size() + extra : 0);
+        }
+        return begin;
+    }
+
+    /// \brief Send a message to each neighbor and receive one from it.
+    /// \param send_begin, receive_begin The positions of the messages of
+    ///        the neighbors in the buffers, followed by the end.
+    template<class T>
+    void exchange(const std::vector<int>& ranks,
+                  const T* send, const std::vector<std::size_t>& send_begin,
+                  T* receive, const std::vector<std::size_t>& receive_begin, int tag)
+    {
+        const MPI_Datatype type = Dune::MPITraits<T>::getType();
+        CommunicationTimer timer(counters_ ? &counters_->wait_seconds : nullptr);
+        if (counters_) {
+            for (std::size_t n = 0; n < ranks.size(); ++n) {
+                if (send_begin[n + 1] > send_begin[n]) {
+                    counters_->addMessage<T>(send_begin[n + 1] - send_begin[n]);
+                }
+            }
+        }
+        if (graph_neighbors_) {
+            const std::size_t degree = graph_neighbors_->size();
+            std::vector<int> send_counts(degree, 0), send_displs(degree, 0);
+            std::vector<int> receive_counts(degree, 0), receive_displs(degree, 0);
+            for (std::size_t n = 0; n < ranks.size(); ++n) {
+                const std::size_t g = std::lower_bound(graph_neighbors_->begin(), graph_neighbors_->end(), ranks[n])
+                    - graph_neighbors_->begin();
+                assert(g < degree && (*graph_neighbors_)[g] == ranks[n]);
+                send_counts[g] = send_begin[n + 1] - send_begin[n];
+                send_displs[g] = send_begin[n];
+                receive_counts[g] = receive_begin[n + 1] - receive_begin[n];
+                receive_displs[g] = receive_begin[n];
+            }
+            MPI_Neighbor_alltoallv(send, send_counts.data(), send_displs.data(), type,
+                                   receive, receive_counts.data(), receive_displs.data(), type,
+                                   communicator_);
+            return;
+        }
+        std::vector<MPI_Request> requests;
+        for (std::size_t n = 0; n < ranks.size(); ++n) {
+            if (receive_begin[n + 1] > receive_begin[n]) {
+                requests.emplace_back();
+                MPI_Irecv(receive + receive_begin[n], receive_begin[n + 1] - receive_begin[n], type,
+                          ranks[n], tag, communicator_, &requests.back());
+            }
+        }
+        for (std::size_t n = 0; n < ranks.size(); ++n) {
+            if (send_begin[n + 1] > send_begin[n]) {
+                requests.emplace_back();
+                MPI_Isend(send + send_begin[n], send_begin[n + 1] - send_begin[n], type,
+                          ranks[n], tag, communicator_, &requests.back());
+            }
+        }
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template<bool FORWARD, class DataHandle>
+    void communicate(DataHandle& handle)
+    {
+        using DataType = typename DataHandle::DataType;
+        enum { size_tag = 0, data_tag = 1 };
+
+        std::vector<int> ranks;
+        Lists send_lists, receive_lists;
+        for (const auto& neighbor : interface_) {
+            ranks.push_back(neighbor.first);
+            send_lists.push_back(FORWARD ? &neighbor.second.first : &neighbor.second.second);
+            receive_lists.push_back(FORWARD ? &neighbor.second.second : &neighbor.second.first);
+        }
+        const std::size_t num_neighbors = ranks.size();
+        if (counters_) {
+            counters_->calls += 1.0;
+            counters_->neighbors = std::max(counters_->neighbors, double(num_neighbors));
+        }
+
+        // The offsets of the entities in the messages, or for a fixed
+        // size the number of items per entity.
+        const bool fixed = handle.fixedsize();
+        std::size_t fixed_size = 0;
+        const auto send_offsets_begin = positions(send_lists, 1);
+        const auto receive_offsets_begin = positions(receive_lists, 1);
+        std::vector<std::size_t> send_offsets, receive_offsets;
+        const auto send_chunks = chunks(send_lists, 0, num_neighbors);
+        if (fixed) {
+            for (std::size_t n = 0; n < num_neighbors; ++n) {
+                if (send_lists[n]->size()) {
+                    fixed_size = handle.size((*send_lists[n])[0]);
+                    break;
+                }
+                if (receive_lists[n]->size()) {
+                    fixed_size = handle.size((*receive_lists[n])[0]);
+                    break;
+                }
+            }
+        } else {
+            send_offsets.assign(send_offsets_begin.back(), 0);
+            receive_offsets.resize(receive_offsets_begin.back());
+            CommunicationTimer timer(counters_ ? &counters_->pack_seconds : nullptr);
+            forEachChunk(send_chunks, [&](const Chunk& c) {
+                const auto& list = *send_lists[c.neighbor];
+                std::size_t* offsets = send_offsets.data() + send_offsets_begin[c.neighbor];
+                for (std::size_t i = c.begin; i < c.end; ++i) {
+                    offsets[i + 1] = handle.size(list[i]);
+                }
+            });
+            for (std::size_t n = 0; n < num_neighbors; ++n) {
+                const auto begin = send_offsets.begin() + send_offsets_begin[n];
+                const auto end = send_offsets.begin() + send_offsets_begin[n + 1];
+                std::partial_sum(begin, end, begin);
+            }
+        }
+        if (!fixed) {
+            exchange(ranks, send_offsets.data(), send_offsets_begin,
+                     receive_offsets.data(), receive_offsets_begin, size_tag);
+        }
+        auto offset = [&](const std::vector<std::size_t>& offsets, const std::vector<std::size_t>& begin,
+                          std::size_t n, std::size_t i) {
+            return fixed ? i * fixed_size : offsets[begin[n] + i];
+        };
+
+        // The positions of the messages in the contiguous buffers.
+        std::vector<std::size_t> send_begin(num_neighbors + 1, 0), receive_begin(num_neighbors + 1, 0);
+        for (std::size_t n = 0; n < num_neighbors; ++n) {
+            const std::size_t send_size = send_lists[n]->size(), receive_size = receive_lists[n]->size();
+            send_begin[n + 1] = send_begin[n]
+                + (send_size ? offset(send_offsets, send_offsets_begin, n, send_size) : 0);
+            receive_begin[n + 1] = receive_begin[n]
+                + (receive_size ? offset(receive_offsets, receive_offsets_begin, n, receive_size) : 0);
+        }
+
+        std::vector<DataType> send_buffer(send_begin.back()), receive_buffer(receive_begin.back());
+        {
+            CommunicationTimer timer(counters_ ? &counters_->pack_seconds : nullptr);
+            forEachChunk(send_chunks, [&](const Chunk& c) {
+                const auto& list = *send_lists[c.neighbor];
+                PackBuffer<DataType> buffer(send_buffer.data() + send_begin[c.neighbor]
+                                            + offset(send_offsets, send_offsets_begin, c.neighbor, c.begin));
+                for (std::size_t i = c.begin; i < c.end; ++i) {
+                    handle.gather(buffer, list[i]);
+                }
+            });
+        }
+        exchange(ranks, send_buffer.data(), send_begin, receive_buffer.data(), receive_begin, data_tag);
+
+        // An entity may be received from several neighbors, hence only
+        // the chunks of one neighbor are unpacked concurrently.
+        CommunicationTimer timer(counters_ ? &counters_->unpack_seconds : nullptr);
+        for (std::size_t n = 0; n < num_neighbors; ++n) {
+            forEachChunk(chunks(receive_lists, n, n + 1), [&](const Chunk& c) {
+                const auto& list = *receive_lists[n];
+                PackBuffer<DataType> buffer(receive_buffer.data() + receive_begin[n]
+                                            + offset(receive_offsets, receive_offsets_begin, n, c.begin));
+                for (std::size_t i = c.begin; i < c.end; ++i) {
+                    const std::size_t size = fixed ? fixed_size
+                        : offset(receive_offsets, receive_offsets_begin, n, i + 1)
+                        - offset(receive_offsets, receive_offsets_begin, n, i);
+                    handle.scatter(buffer, list[i], size);
+                }
+            });
+        }
+    }
+
+    MPI_Comm communicator_;
+    const InterfaceMap& interface_;
+    std::size_t chunk_size_;
+    const std::vector<int>* graph_neighbors_;
+    CommunicationCounters* counters_ = nullptr;
+};
+
+} // end namespace Opm
+
+#endif // HAVE_MPI
+
+#endif // OPM_THREADEDPACKCOMMUNICATOR_HEADER
@@ -34,6 +34,8 @@ Copyright 2013-2017 Statoil ASA
 #include <dune/common/parallel/mpitraits.hh>
 #include <dune/common/unused.hh>
 
+#include <opm/grid/utility/CommunicationCounters.hpp>
+
 /**
  * @addtogroup Common_Parallel
  *
@@ -465,6 +467,15 @@ public:
     communicate<false>(handle);
   }
 
+  /**
+   * @brief Count the messages and time of the communication.
+   * @param counters The counters to add to, or nullptr to not count.
+   */
+  void setCounters(CommunicationCounters* counters)
+  {
+    counters_ = counters;
+  }
+
 private:
   template<bool FORWARD, class DataHandle>
   void communicateSizes(DataHandle& handle,
@@ -530,6 +541,10 @@ private:
    * This is a cloned communicator to ensure there are no interferences.
    */
   MPI_Comm communicator_;
+  /**
+   * @brief The counters of messages and time, or nullptr.
+   */
+  CommunicationCounters* counters_ = nullptr;
 };
 
 /** @} */
@@ -698,6 +713,10 @@ struct PackEntries
 template<class DataHandle>
 struct UnpackEntries{
 
+  explicit UnpackEntries(CommunicationCounters* counters=nullptr)
+    : counters_(counters)
+  {}
+
   /**
    * @brief packs data.
    * @param handle The handle describing the data and the gather and scatter operations.
@@ -709,6 +728,7 @@ struct UnpackEntries{
                   MessageBuffer<typename DataHandle::DataType>& buffer,
                   int count=0)
   {
+    CommunicationTimer timer(counters_ ? &counters_->unpack_seconds : nullptr);
     if(tracker.fixedSize) // fixed size if variable is >0!
     {
       std::size_t noIndices=std::min(buffer.size()/tracker.fixedSize, tracker.indicesLeft());
@@ -734,6 +754,8 @@ struct UnpackEntries{
       return tracker.finished();
     }
   }
+
+  CommunicationCounters* counters_;
 };
 
 
@@ -807,6 +829,10 @@ struct UnpackSizeEntries{
  */
 template<class DataHandle>
 struct SetupSendRequest{
+  explicit SetupSendRequest(CommunicationCounters* counters=nullptr)
+    : counters_(counters)
+  {}
+
   void operator()(DataHandle& handle,
                   InterfaceTracker& tracker,
                   MessageBuffer<typename DataHandle::DataType>& buffer,
@@ -814,17 +840,25 @@ struct SetupSendRequest{
                   MPI_Comm comm) const
   {
     buffer.reset();
-    int size=PackEntries<DataHandle>()(handle, tracker, buffer);
-    // Skip indices of zero size.
-    while(!tracker.finished() &&  !handle.size(tracker.index()))
-      tracker.moveToNextIndex();
+    int size;
+    {
+      CommunicationTimer timer(counters_ ? &counters_->pack_seconds : nullptr);
+      size=PackEntries<DataHandle>()(handle, tracker, buffer);
+      // Skip indices of zero size.
+      while(!tracker.finished() &&  !handle.size(tracker.index()))
+        tracker.moveToNextIndex();
+    }
     if(size)
     {
       assert(std::size_t(size) <= buffer.size());
       MPI_Issend(buffer, size, Dune::MPITraits<typename DataHandle::DataType>::getType(),
                  tracker.rank(), 933399, comm, &request);
+      if(counters_)
+        counters_->addMessage<typename DataHandle::DataType>(size);
     }
   }
+
+  CommunicationCounters* counters_;
 };
 
 
@@ -955,16 +989,18 @@ std::size_t receiveSizeAndSetupReceive(DataHandle& handle,
  * @param requests The requests for the asynchronous communication.
  * @param buffers The buffers to use for sending.
  * @param comm The mpi communicator to use.
+ * @param counters The counters of messages and time, or nullptr.
  */
 template<class DataHandle>
 std::size_t checkSendAndContinueSending(DataHandle& handle,
                                         std::vector<InterfaceTracker>& trackers,
                                         std::vector<MPI_Request>& requests,
                                         std::vector<MessageBuffer<typename DataHandle::DataType> >& buffers,
-                                        MPI_Comm comm)
+                                        MPI_Comm comm,
+                                        CommunicationCounters* counters=nullptr)
 {
   return checkAndContinue(handle, trackers, requests, requests, buffers, comm,
-                          NullPackUnpackFunctor<DataHandle>(), SetupSendRequest<DataHandle>());
+                          NullPackUnpackFunctor<DataHandle>(), SetupSendRequest<DataHandle>(counters));
 }
 
 /**
@@ -974,16 +1010,18 @@ std::size_t checkSendAndContinueSending(DataHandle& handle,
  * @param requests The requests for the asynchronous communication.
  * @param buffers The buffers to use for receiving.
  * @param comm The mpi communicator to use.
+ * @param counters The counters of messages and time, or nullptr.
  */
 template<class DataHandle>
 std::size_t checkReceiveAndContinueReceiving(DataHandle& handle,
                                              std::vector<InterfaceTracker>& trackers,
                                              std::vector<MPI_Request>& requests,
                                              std::vector<MessageBuffer<typename DataHandle::DataType> >& buffers,
-                                             MPI_Comm comm)
+                                             MPI_Comm comm,
+                                             CommunicationCounters* counters=nullptr)
 {
   return checkAndContinue(handle, trackers, requests, requests, buffers, comm,
-                          UnpackEntries<DataHandle>(), SetupRecvRequest<DataHandle>(),
+                          UnpackEntries<DataHandle>(counters), SetupRecvRequest<DataHandle>(),
                           true, !handle.fixedsize());
 }
 
@@ -1070,6 +1108,9 @@ void VariableSizeCommunicator<Allocator>::communicateFixedSize(DataHandle& handl
   std::vector<InterfaceTracker> recv_trackers;
   setupInterfaceTrackers<FORWARD>(handle,send_trackers, recv_trackers);
   sendFixedSize(send_trackers,  size_send_req, recv_trackers, size_recv_req, communicator_);
+  if(counters_)
+    for(std::size_t i=0; i<send_trackers.size(); ++i)
+      counters_->addMessage<std::size_t>(1);
 
   std::vector<MPI_Request> data_send_req(interface_->size(), MPI_REQUEST_NULL);
   std::vector<MPI_Request> data_recv_req(interface_->size(), MPI_REQUEST_NULL);
@@ -1079,7 +1120,7 @@ void VariableSizeCommunicator<Allocator>::communicateFixedSize(DataHandle& handl
 
 
   setupRequests(handle, send_trackers, send_buffers, data_send_req,
-                SetupSendRequest<DataHandle>(), communicator_);
+                SetupSendRequest<DataHandle>(counters_), communicator_);
 
   std::size_t no_size_to_recv,  no_to_send, no_to_recv, old_size;
   no_size_to_recv = no_to_send = no_to_recv = old_size = interface_->size();
@@ -1104,11 +1145,11 @@ void VariableSizeCommunicator<Allocator>::communicateFixedSize(DataHandle& handl
     // Check send completion and initiate other necessary sends
     if(no_to_send)
       no_to_send -= checkSendAndContinueSending(handle, send_trackers, data_send_req,
-                                              send_buffers, communicator_);
+                                              send_buffers, communicator_, counters_);
     if(validRecvRequests(data_recv_req))
       // Receive data and setup new unblocking receives if necessary
       no_to_recv -= checkReceiveAndContinueReceiving(handle, recv_trackers, data_recv_req,
-                                                     recv_buffers, communicator_);
+                                                     recv_buffers, communicator_, counters_);
   }
 
   // Wait for completion of sending the size.
@@ -1133,7 +1174,7 @@ void VariableSizeCommunicator<Allocator>::communicateSizes(DataHandle& handle,
   SizeDataHandle<DataHandle> size_handle(handle,data_recv_trackers);
   setupInterfaceTrackers<FORWARD>(size_handle,send_trackers, recv_trackers);
   setupRequests(size_handle, send_trackers, send_buffers, send_requests,
-                                SetupSendRequest<SizeDataHandle<DataHandle> >(), communicator_);
+                SetupSendRequest<SizeDataHandle<DataHandle> >(counters_), communicator_);
   setupRequests(size_handle, recv_trackers, recv_buffers, recv_requests,
                 SetupRecvRequest<SizeDataHandle<DataHandle> >(), communicator_);
 
@@ -1151,7 +1192,7 @@ void VariableSizeCommunicator<Allocator>::communicateSizes(DataHandle& handle,
     if(size_to_send)
       size_to_send -=
         checkSendAndContinueSending(size_handle, send_trackers, send_requests,
-                                    send_buffers, communicator_);
+                                    send_buffers, communicator_, counters_);
     if(size_to_recv)
       // Could have done this using checkSendAndContinueSending
       // But the call below is more efficient as UnpackSizeEntries
@@ -1182,7 +1223,7 @@ void VariableSizeCommunicator<Allocator>::communicateVariableSize(DataHandle& ha
   communicateSizes<FORWARD>(handle, recv_trackers);
   // Setup requests for sending and receiving.
   setupRequests(handle, send_trackers, send_buffers, send_requests,
-                SetupSendRequest<DataHandle>(), communicator_);
+                SetupSendRequest<DataHandle>(counters_), communicator_);
   setupRequests(handle, recv_trackers, recv_buffers, recv_requests,
                 SetupRecvRequest<DataHandle>(), communicator_);
 
@@ -1199,11 +1240,11 @@ void VariableSizeCommunicator<Allocator>::communicateVariableSize(DataHandle& ha
     // Check send completion and initiate other necessary sends
     if(no_to_send)
       no_to_send -= checkSendAndContinueSending(handle, send_trackers, send_requests,
-                                              send_buffers, communicator_);
+                                              send_buffers, communicator_, counters_);
     if(no_to_recv)
       // Receive data and setup new unblocking receives if necessary
       no_to_recv -= checkReceiveAndContinueReceiving(handle, recv_trackers, recv_requests,
-                                                     recv_buffers, communicator_);
+                                                     recv_buffers, communicator_, counters_);
   }
 }
 
@@ -1211,15 +1252,29 @@ template<class Allocator>
 template<bool FORWARD, class DataHandle>
 void VariableSizeCommunicator<Allocator>::communicate(DataHandle& handle)
 {
+  if(counters_)
+  {
+    counters_->calls += 1.0;
+    counters_->neighbors = std::max(counters_->neighbors, double(interface_->size()));
+  }
+
   if( interface_->size() == 0)
     // Simply return as otherwise we will index an empty container
     // either for MPI_Wait_all or MPI_Test_some.
     return;
 
-  if(handle.fixedsize())
-    communicateFixedSize<FORWARD>(handle);
-  else
-    communicateVariableSize<FORWARD>(handle);
+  // The time not spent packing and unpacking is spent waiting for messages.
+  const double packing = counters_ ? counters_->pack_seconds + counters_->unpack_seconds : 0.0;
+  double total = 0.0;
+  {
+    CommunicationTimer timer(counters_ ? &total : nullptr);
+    if(handle.fixedsize())
+      communicateFixedSize<FORWARD>(handle);
+    else
+      communicateVariableSize<FORWARD>(handle);
+  }
+  if(counters_)
+    counters_->wait_seconds += total - (counters_->pack_seconds + counters_->unpack_seconds - packing);
 }
 } // end namespace Dune
 
@@ -168,15 +168,74 @@ namespace Opm
                                                 double* v) const
     {
         const int n = bcmethod_.numCorners(cell);
-        const int dim = grid_.dimensions;
         bary_coord_.resize(n);
         bcmethod_.cartToBary(cell, x, &bary_coord_[0]);
+        weightCornerVelocities(cell, &bary_coord_[0], v);
+    }
+
+    /// Interpolate velocity at a batch of points in the same cell.
+    /// \param[in]  cell        Cell in which to interpolate.
+    /// \param[in]  num_points  Number of points.
+    /// \param[in]  x           Coordinates of points at which to interpolate.
+    ///                         Must be array of length num_points*grid.dimensions.
+    /// \param[out] v           Interpolated velocities.
+    ///                         Must be array of length num_points*grid.dimensions.
+    void VelocityInterpolationECVI::interpolateBatch(const int cell,
+                                                     const int num_points,
+                                                     const double* x,
+                                                     double* v) const
+    {
+        const int n = bcmethod_.numCorners(cell);
+        const int dim = grid_.dimensions;
+        std::vector<double> bary_coord(n*num_points);
+        bcmethod_.cartToBary(cell, num_points, x, bary_coord.data());
+        for (int p = 0; p < num_points; ++p) {
+            weightCornerVelocities(cell, &bary_coord[n*p], v + dim*p);
+        }
+    }
+
+    /// Interpolate velocity at a batch of (cell, point) pairs.
+    /// \param[in]  num_points  Number of points.
+    /// \param[in]  cells       Cell of each point, array of length num_points.
+    /// \param[in]  x           Coordinates of points at which to interpolate.
+    ///                         Must be array of length num_points*grid.dimensions.
+    /// \param[out] v           Interpolated velocities.
+    ///                         Must be array of length num_points*grid.dimensions.
+    void VelocityInterpolationECVI::interpolateBatch(const int num_points,
+                                                     const int* cells,
+                                                     const double* x,
+                                                     double* v) const
+    {
+        const int dim = grid_.dimensions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // One scratch buffer per thread, large enough for any cell.
+            std::vector<double> bary_coord(bcmethod_.maxNumCorners());
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int p = 0; p < num_points; ++p) {
+                bcmethod_.cartToBary(cells[p], 1, x + dim*p, bary_coord.data());
+                weightCornerVelocities(cells[p], bary_coord.data(), v + dim*p);
+            }
+        }
+    }
+
+    /// Sums corner velocities weighted by barycentric coordinates.
+    void VelocityInterpolationECVI::weightCornerVelocities(const int cell,
+                                                           const double* bary_coord,
+                                                           double* v) const
+    {
+        const int dim = grid_.dimensions;
         std::fill(v, v + dim, 0.0);
-        const SparseTable<WachspressCoord::CornerInfo>& all_ci = bcmethod_.cornerInfo();
+        const auto corners = bcmethod_.cornerInfo()[cell];
+        const int n = corners.size();
         for (int i = 0; i < n; ++i) {
-            const int cid = all_ci[cell][i].corner_id;
+            const double* cv = &corner_velocity_[dim*corners[i].corner_id];
             for (int dd = 0; dd < dim; ++dd) {
-                v[dd] += corner_velocity_[dim*cid + dd] * bary_coord_[i];
+                v[dd] += cv[dd] * bary_coord[i];
             }
         }
     }
@@ -107,7 +107,40 @@ namespace Opm
         virtual void interpolate(const int cell,
                                  const double* x,
                                  double* v) const;
+
+        /// Interpolate velocity at a batch of points in the same cell.
+        /// Not virtual, and thread safe, intended for tracing many
+        /// points at a time.
+        /// \param[in]  cell        Cell in which to interpolate.
+        /// \param[in]  num_points  Number of points.
+        /// \param[in]  x           Coordinates of points at which to interpolate.
+        ///                         Must be array of length num_points*grid.dimensions.
+        /// \param[out] v           Interpolated velocities.
+        ///                         Must be array of length num_points*grid.dimensions.
+        void interpolateBatch(const int cell,
+                              const int num_points,
+                              const double* x,
+                              double* v) const;
+
+        /// Interpolate velocity at a batch of (cell, point) pairs.
+        /// Not virtual, and thread safe. The points are processed
+        /// in parallel if OpenMP is enabled.
+        /// \param[in]  num_points  Number of points.
+        /// \param[in]  cells       Cell of each point, array of length num_points.
+        /// \param[in]  x           Coordinates of points at which to interpolate.
+        ///                         Must be array of length num_points*grid.dimensions.
+        /// \param[out] v           Interpolated velocities.
+        ///                         Must be array of length num_points*grid.dimensions.
+        void interpolateBatch(const int num_points,
+                              const int* cells,
+                              const double* x,
+                              double* v) const;
     private:
+        /// Sums corner velocities weighted by barycentric coordinates.
+        void weightCornerVelocities(const int cell,
+                                    const double* bary_coord,
+                                    double* v) const;
+
         WachspressCoord bcmethod_;
         const UnstructuredGrid& grid_;
         mutable std::vector<double> bary_coord_;
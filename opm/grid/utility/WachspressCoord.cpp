@@ -20,9 +20,9 @@
 #include "config.h"
 #include <opm/grid/utility/WachspressCoord.hpp>
 #include <opm/grid/UnstructuredGrid.h>
+#include <algorithm>
 #include <cmath>
-#include <map>
-#include <set>
+#include <utility>
 
 namespace Opm
 {
@@ -95,7 +95,7 @@ namespace Opm
     /// Constructor.
     /// \param[in]  grid   A grid.
     WachspressCoord::WachspressCoord(const UnstructuredGrid& grid)
-        : grid_(grid)
+        : grid_(grid), max_num_corners_(0), max_num_faces_(0)
     {
         enum { Maxdim = 3 };
         const int dim = grid.dimensions;
@@ -103,58 +103,145 @@ namespace Opm
             OPM_THROW(std::runtime_error, "Grid has more than " << Maxdim << " dimensions.");
         }
         // Compute static data for each corner.
+        // All cells are independent, so this is done in two parallel
+        // passes: the first one counts the corners of each cell, the
+        // second one fills the flat per-corner arrays at offsets given
+        // by the cumulative counts. Corners are numbered cell by cell,
+        // in increasing vertex order within each cell.
         const int num_cells = grid.number_of_cells;
-        int corner_id_count = 0;
+        std::vector<int> num_corners(num_cells);
+        int max_corners = 0;
+        int max_faces = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(max: max_corners, max_faces)
+#endif
         for (int cell = 0; cell < num_cells; ++cell) {
-            std::set<int> cell_vertices;
-            std::vector<int> cell_faces;
-            std::multimap<int, int> vertex_adj_faces;
+            std::vector<int> cell_vertices;
             for (int hface = grid.cell_facepos[cell]; hface < grid.cell_facepos[cell + 1]; ++hface) {
                 const int face = grid.cell_faces[hface];
-                cell_faces.push_back(face);
-                const int fn0 = grid.face_nodepos[face];
-                const int fn1 = grid.face_nodepos[face + 1];
-                cell_vertices.insert(grid.face_nodes + fn0, grid.face_nodes + fn1);
-                for (int fn = fn0; fn < fn1; ++fn) {
-                    const int vertex = grid.face_nodes[fn];
-                    vertex_adj_faces.insert(std::make_pair(vertex, face));
+                cell_vertices.insert(cell_vertices.end(),
+                                     grid.face_nodes + grid.face_nodepos[face],
+                                     grid.face_nodes + grid.face_nodepos[face + 1]);
+            }
+            std::sort(cell_vertices.begin(), cell_vertices.end());
+            num_corners[cell] = std::unique(cell_vertices.begin(), cell_vertices.end()) - cell_vertices.begin();
+            max_corners = std::max(max_corners, num_corners[cell]);
+            max_faces = std::max(max_faces, grid.cell_facepos[cell + 1] - grid.cell_facepos[cell]);
+        }
+        max_num_corners_ = max_corners;
+        max_num_faces_ = max_faces;
+
+        std::vector<int> corner_start(num_cells + 1, 0);
+        nonadj_start_.assign(num_cells + 1, 0);
+        for (int cell = 0; cell < num_cells; ++cell) {
+            const int num_faces = grid.cell_facepos[cell + 1] - grid.cell_facepos[cell];
+            corner_start[cell + 1] = corner_start[cell] + num_corners[cell];
+            nonadj_start_[cell + 1] = nonadj_start_[cell] + num_corners[cell]*std::max(num_faces - dim, 0);
+        }
+        const int num_total_corners = corner_start[num_cells];
+
+        std::vector<CornerInfo> corner_data(num_total_corners);
+        std::vector<int> nonadj_data(nonadj_start_[num_cells]);
+        std::vector<int> nonadj_sizes(num_total_corners);
+        adj_faces_.resize(dim*num_total_corners);
+        nonadj_local_.resize(nonadj_start_[num_cells]);
+        face_data_.resize(2*dim*grid.cell_facepos[num_cells]);
+
+        int bad_cell = -1;
+        int bad_vertex = -1;
+        bool bad_too_many = false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int cell = 0; cell < num_cells; ++cell) {
+            const int hf0 = grid.cell_facepos[cell];
+            const int num_faces = grid.cell_facepos[cell + 1] - hf0;
+            std::vector<int> cell_vertices;
+            std::vector<std::pair<int, int>> cell_faces; // (face, local face index), sorted by face.
+            for (int hface = hf0; hface < hf0 + num_faces; ++hface) {
+                const int face = grid.cell_faces[hface];
+                cell_faces.emplace_back(face, hface - hf0);
+                cell_vertices.insert(cell_vertices.end(),
+                                     grid.face_nodes + grid.face_nodepos[face],
+                                     grid.face_nodes + grid.face_nodepos[face + 1]);
+                // Outward normal and centroid of the half-face.
+                const double sign = (grid.face_cells[2*face] == cell) ? 1.0 : -1.0;
+                assert(sign > 0.0 || grid.face_cells[2*face + 1] == cell);
+                double* fd = &face_data_[2*dim*hface];
+                for (int dd = 0; dd < dim; ++dd) {
+                    fd[dd] = sign*grid.face_normals[dim*face + dd];
+                    fd[dim + dd] = grid.face_centroids[dim*face + dd];
                 }
             }
-            std::sort(cell_faces.begin(), cell_faces.end()); // set_difference requires sorted ranges
-            std::vector<CornerInfo> cell_corner_info;
-            std::set<int>::const_iterator it = cell_vertices.begin();
-            for (; it != cell_vertices.end(); ++it) {
-                CornerInfo ci;
-                ci.corner_id = corner_id_count++;;
-                ci.vertex = *it;
+            std::sort(cell_vertices.begin(), cell_vertices.end());
+            cell_vertices.erase(std::unique(cell_vertices.begin(), cell_vertices.end()), cell_vertices.end());
+            std::sort(cell_faces.begin(), cell_faces.end()); // Nonadjacent faces are stored in face order.
+
+            int nonadj_pos = nonadj_start_[cell];
+            for (int i = 0; i < num_corners[cell]; ++i) {
+                const int cid = corner_start[cell] + i;
+                CornerInfo& ci = corner_data[cid];
+                ci.corner_id = cid;
+                ci.vertex = cell_vertices[i];
                 double* fnorm[Maxdim] = { 0 };
-                typedef std::multimap<int, int>::const_iterator MMIt;
-                std::pair<MMIt, MMIt> frange = vertex_adj_faces.equal_range(ci.vertex);
+                int vert_adj_faces[Maxdim] = { -1, -1, -1 };
                 int fi = 0;
-                std::vector<int> vert_adj_faces(dim);
-                for (MMIt face_it = frange.first; face_it != frange.second; ++face_it, ++fi) {
+                bool too_many = false;
+                for (int hface = hf0; hface < hf0 + num_faces; ++hface) {
+                    const int face = grid.cell_faces[hface];
+                    const int* fn0 = grid.face_nodes + grid.face_nodepos[face];
+                    const int* fn1 = grid.face_nodes + grid.face_nodepos[face + 1];
+                    if (std::find(fn0, fn1, ci.vertex) == fn1) {
+                        continue;
+                    }
                     if (fi >= dim) {
-                        OPM_THROW(std::runtime_error, "In cell " << cell << ", vertex " << ci.vertex << " has "
-                              << " more than " << dim << " adjacent faces.");
+                        too_many = true;
+                        break;
+                    }
+                    fnorm[fi] = grid_.face_normals + dim*face;
+                    vert_adj_faces[fi] = face;
+                    ++fi;
+                }
+                if (too_many || fi != dim) {
+                    // Reported after the loop, for the lowest bad cell.
+#ifdef _OPENMP
+#pragma omp critical(WachspressCoordError)
+#endif
+                    {
+                        if (bad_cell < 0 || cell < bad_cell) {
+                            bad_cell = cell;
+                            bad_vertex = ci.vertex;
+                            bad_too_many = too_many;
+                        }
+                    }
+                    continue;
+                }
+                std::copy(vert_adj_faces, vert_adj_faces + dim, adj_faces_.begin() + dim*cid);
+                ci.volume = cornerVolume(fnorm, dim);
+                // Nonadjacent faces: all cell faces not adjacent to this vertex.
+                const int nonadj_begin = nonadj_pos;
+                for (const auto& face : cell_faces) {
+                    int* adj_it = std::find(vert_adj_faces, vert_adj_faces + dim, face.first);
+                    if (adj_it != vert_adj_faces + dim) {
+                        *adj_it = -1; // Each adjacent face is removed only once.
+                        continue;
                     }
-                    fnorm[fi] = grid_.face_normals + dim*(face_it->second);
-                    vert_adj_faces[fi] = face_it->second;
+                    nonadj_data[nonadj_pos] = face.first;
+                    nonadj_local_[nonadj_pos] = face.second;
+                    ++nonadj_pos;
                 }
-                assert(fi == dim);
-                adj_faces_.insert(adj_faces_.end(), vert_adj_faces.begin(), vert_adj_faces.end());
-                const double corner_vol = cornerVolume(fnorm, dim);
-                ci.volume = corner_vol;
-                cell_corner_info.push_back(ci);
-                std::sort(vert_adj_faces.begin(), vert_adj_faces.end());
-                std::vector<int> vert_nonadj_faces(cell_faces.size() - vert_adj_faces.size());
-                std::set_difference(cell_faces.begin(), cell_faces.end(),
-                                    vert_adj_faces.begin(), vert_adj_faces.end(),
-                                    vert_nonadj_faces.begin());
-                nonadj_faces_.appendRow(vert_nonadj_faces.begin(), vert_nonadj_faces.end());
+                nonadj_sizes[cid] = nonadj_pos - nonadj_begin;
             }
-            corner_info_.appendRow(cell_corner_info.begin(), cell_corner_info.end());
         }
-        assert(corner_id_count == corner_info_.dataSize());
+        if (bad_cell >= 0) {
+            OPM_THROW(std::runtime_error, "In cell " << bad_cell << ", vertex " << bad_vertex << " has "
+                      << (bad_too_many ? "more" : "fewer") << " than " << dim << " adjacent faces.");
+        }
+        corner_info_.assign(corner_data.begin(), corner_data.end(),
+                            num_corners.begin(), num_corners.end());
+        nonadj_faces_.assign(nonadj_data.begin(), nonadj_data.end(),
+                             nonadj_sizes.begin(), nonadj_sizes.end());
+        assert(num_total_corners == corner_info_.dataSize());
     }
 
 
@@ -187,6 +274,22 @@ namespace Opm
 
 
 
+    /// Largest number of corners of any cell in the grid.
+    int WachspressCoord::maxNumCorners() const
+    {
+        return max_num_corners_;
+    }
+
+
+
+    /// Largest number of faces of any cell in the grid.
+    int WachspressCoord::maxNumFaces() const
+    {
+        return max_num_faces_;
+    }
+
+
+
     /// Compute generalized barycentric coordinates for some point x
     /// with respect to the vertices of a grid cell.
     /// \param[in]  cell   Cell in which to compute coordinates.
@@ -199,11 +302,12 @@ namespace Opm
                                      double* xb) const
     {
         // Note:
-        // A possible optimization is: compute all n_j * (c_j - x) factors
+        // The batched version below computes all n_j * (c_j - x) factors
         // once, instead of repeating computation for all corners (for
         // which j is a nonadjacent face).
         const int n = numCorners(cell);
         const int dim = grid_.dimensions;
+        const double* cell_face_data = face_data_.data() + 2*dim*grid_.cell_facepos[cell];
         double totw = 0.0;
         for (int i = 0; i < n; ++i) {
             const CornerInfo& ci = corner_info_[cell][i];
@@ -211,18 +315,15 @@ namespace Opm
             // V_i * (prod_{j \in nonadjacent faces} n_j * (c_j - x) )
             // ^^^                                   ^^^    ^^^
             // corner "volume"                    normal    centroid
+            // The stored normals are already outward-pointing.
             xb[i] = ci.volume;
-            const int num_nonadj_faces = nonadj_faces_[ci.corner_id].size();
+            const int num_nonadj_faces = nonadj_faces_.rowSize(ci.corner_id);
+            const int* local_faces = nonadj_local_.data() + nonadj_start_[cell] + i*num_nonadj_faces;
             for (int j = 0; j < num_nonadj_faces; ++j) {
-                const int face = nonadj_faces_[ci.corner_id][j];
+                const double* fd = cell_face_data + 2*dim*local_faces[j];
                 double factor = 0.0;
                 for (int dd = 0; dd < dim; ++dd) {
-                    factor += grid_.face_normals[dim*face + dd]*(grid_.face_centroids[dim*face + dd] - x[dd]);
-                }
-                // Assumes outward-pointing normals, so negate factor if necessary.
-                if (grid_.face_cells[2*face] != cell) {
-                    assert(grid_.face_cells[2*face + 1] == cell);
-                    factor = -factor;
+                    factor += fd[dd]*(fd[dim + dd] - x[dd]);
                 }
                 xb[i] *= factor;
             }
@@ -235,4 +336,68 @@ namespace Opm
 
 
 
+    /// Compute generalized barycentric coordinates for a batch of
+    /// points, all with respect to the vertices of the same cell.
+    void WachspressCoord::cartToBary(const int cell,
+                                     const int num_points,
+                                     const double* x,
+                                     double* xb) const
+    {
+        const int n = numCorners(cell);
+        const int dim = grid_.dimensions;
+        const auto corners = corner_info_[cell];
+        const int num_faces = grid_.cell_facepos[cell + 1] - grid_.cell_facepos[cell];
+        const int num_nonadj_faces = num_faces - dim;
+        // Avoid heap allocation for all but the most complex cells.
+        enum { MaxStackFaces = 32 };
+        double stack_factors[MaxStackFaces];
+        std::vector<double> heap_factors;
+        double* factors = stack_factors;
+        if (num_faces > MaxStackFaces) {
+            heap_factors.resize(num_faces);
+            factors = heap_factors.data();
+        }
+        for (int p = 0; p < num_points; ++p) {
+            faceFactors(cell, x + dim*p, factors);
+            double* xbp = xb + n*p;
+            double totw = 0.0;
+            // All corners of a cell have the same number of nonadjacent
+            // faces, stored contiguously in corner order.
+            const int* local_faces = nonadj_local_.data() + nonadj_start_[cell];
+            for (int i = 0; i < n; ++i, local_faces += num_nonadj_faces) {
+                double w = corners[i].volume;
+                for (int j = 0; j < num_nonadj_faces; ++j) {
+                    w *= factors[local_faces[j]];
+                }
+                xbp[i] = w;
+                totw += w;
+            }
+            for (int i = 0; i < n; ++i) {
+                xbp[i] /= totw;
+            }
+        }
+    }
+
+
+
+    /// Computes s_j * n_j * (c_j - x) for all faces j of cell.
+    void WachspressCoord::faceFactors(const int cell,
+                                      const double* x,
+                                      double* factors) const
+    {
+        const int dim = grid_.dimensions;
+        const int hf0 = grid_.cell_facepos[cell];
+        const int num_faces = grid_.cell_facepos[cell + 1] - hf0;
+        const double* fd = face_data_.data() + 2*dim*hf0;
+        for (int j = 0; j < num_faces; ++j, fd += 2*dim) {
+            double factor = 0.0;
+            for (int dd = 0; dd < dim; ++dd) {
+                factor += fd[dd]*(fd[dim + dd] - x[dd]);
+            }
+            factors[j] = factor;
+        }
+    }
+
+
+
 } // namespace Opm
@@ -56,6 +56,28 @@ namespace Opm
                         const double* x,
                         double* xb) const;
 
+        /// Compute generalized barycentric coordinates for a batch of
+        /// points, all with respect to the vertices of the same cell.
+        /// The factors n_j * (c_j - x) are computed once per face and
+        /// point, and shared by all corners of the cell.
+        /// \param[in]  cell        Cell in which to compute coordinates.
+        /// \param[in]  num_points  Number of points.
+        /// \param[in]  x           Coordinates of points in cartesian coordinates.
+        ///                         Must be array of length num_points*grid.dimensions.
+        /// \param[out] xb          Coordinates of points in barycentric coordinates.
+        ///                         Must be array of length num_points*numCorners(cell),
+        ///                         the coordinates of point p start at p*numCorners(cell).
+        void cartToBary(const int cell,
+                        const int num_points,
+                        const double* x,
+                        double* xb) const;
+
+        /// Largest number of corners of any cell in the grid.
+        int maxNumCorners() const;
+
+        /// Largest number of faces of any cell in the grid.
+        int maxNumFaces() const;
+
         // A corner is here defined as a {cell, vertex} pair where the
         // vertex is adjacent to the cell.
         struct CornerInfo
@@ -74,10 +96,21 @@ namespace Opm
         const std::vector<int>& adjacentFaces() const;
 
     private:
+        /// Computes s_j * n_j * (c_j - x) for all faces j of cell, where
+        /// s_j = +/-1 makes the normal point out of the cell.
+        void faceFactors(const int cell,
+                         const double* x,
+                         double* factors) const;
+
         const UnstructuredGrid& grid_;
         SparseTable<CornerInfo> corner_info_;   // Corner info by cell.
         std::vector<int> adj_faces_;    // Set of adjacent faces, by corner id. Contains dim face indices per corner.
         SparseTable<int> nonadj_faces_; // Set of nonadjacent faces, by corner id.
+        std::vector<int> nonadj_local_; // As nonadj_faces_, but local (cell_facepos-relative) face indices.
+        std::vector<int> nonadj_start_; // Start of each cell's entries in nonadj_local_.
+        std::vector<double> face_data_; // For each half-face: outward normal (dim) and face centroid (dim).
+        int max_num_corners_;
+        int max_num_faces_;
     };
 
 } // namespace Opm
@@ -0,0 +1,116 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE ConstructionTimingsTests
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include "cornerpoint_input.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const Dune::cpgrid::ConstructionPhase*
+    findPhase(const std::vector<Dune::cpgrid::ConstructionPhase>& phases, const std::string& name)
+    {
+        auto phase = std::find_if(phases.begin(), phases.end(),
+                                  [&name](const Dune::cpgrid::ConstructionPhase& p) { return p.name == name; });
+        return phase == phases.end() ? nullptr : &*phase;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(nestedPhases)
+{
+    Dune::cpgrid::ConstructionTimings timings(3);
+    {
+        Dune::cpgrid::ConstructionTimings::Phase outer(timings, "outer");
+        {
+            Dune::cpgrid::ConstructionTimings::Phase inner(timings, "inner");
+            inner.setCounts(1, 2, 3);
+        }
+        Dune::cpgrid::ConstructionTimings::Phase second(timings, "second");
+    }
+    const auto& phases = timings.phases();
+    BOOST_REQUIRE_EQUAL(phases.size(), 3u);
+    BOOST_CHECK_EQUAL(phases[0].name, "outer");
+    BOOST_CHECK_EQUAL(phases[1].name, "outer/inner");
+    BOOST_CHECK_EQUAL(phases[2].name, "outer/second");
+    for (const auto& phase : phases) {
+        BOOST_CHECK_EQUAL(phase.rank, 3);
+        BOOST_CHECK(phase.seconds >= 0.0);
+        BOOST_CHECK(phase.peak_rss_delta_kb >= 0);
+    }
+    BOOST_CHECK(phases[0].seconds >= phases[1].seconds);
+    BOOST_CHECK_EQUAL(phases[1].cells, 1);
+    BOOST_CHECK_EQUAL(phases[1].faces, 2);
+    BOOST_CHECK_EQUAL(phases[1].points, 3);
+    BOOST_CHECK_EQUAL(phases[0].cells, -1);
+
+    const std::string json = Dune::cpgrid::ConstructionTimings::toJson(phases);
+    BOOST_CHECK(json.find("\"name\": \"outer/inner\", \"rank\": 3") != std::string::npos);
+    BOOST_CHECK(json.find("\"cells\": 1, \"faces\": 2, \"points\": 3}") != std::string::npos);
+
+    timings.clear();
+    BOOST_CHECK(timings.phases().empty());
+    BOOST_CHECK_EQUAL(Dune::cpgrid::ConstructionTimings::toJson(timings.phases()), "{\"phases\": [\n]}\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(processGrid)
+{
+    const CornerPointInput input({{ { 0.0, 1.0, 2.0, 3.0, 4.0 },
+                                    { 0.0, 1.0, 2.0, 3.0 },
+                                    { 0.0, 1.0, 2.0 } }});
+    Dune::CpGrid grid(Dune::MPIHelper::getLocalCommunicator());
+    grid.processEclipseFormat(input.grdeclData(), false);
+
+    const auto phases = grid.gatherConstructionTimings();
+    BOOST_CHECK_EQUAL(phases.size(), grid.constructionTimings().phases().size());
+    for (const char* name : { "processGrid", "processGrid/process_grdecl",
+                              "processGrid/buildTopo", "processGrid/buildGeom" }) {
+        const auto* phase = findPhase(phases, name);
+        BOOST_REQUIRE_MESSAGE(phase, "Missing phase " << name);
+        BOOST_CHECK_EQUAL(phase->cells, grid.numCells());
+        BOOST_CHECK(phase->seconds >= 0.0);
+    }
+    BOOST_CHECK_EQUAL(findPhase(phases, "processGrid")->faces, grid.numFaces());
+    BOOST_CHECK_EQUAL(findPhase(phases, "processGrid")->points, grid.numVertices());
+
+    const std::string json = grid.constructionTimingsJson();
+    BOOST_CHECK(json.find("\"name\": \"processGrid/buildGeom\"") != std::string::npos);
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
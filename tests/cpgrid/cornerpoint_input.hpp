@@ -0,0 +1,77 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_TESTS_CPGRID_CORNERPOINT_INPUT_HEADER
+#define OPM_TESTS_CPGRID_CORNERPOINT_INPUT_HEADER
+
+#include <opm/grid/cpgpreprocess/preprocess.h>
+
+#include <array>
+#include <vector>
+
+/// \brief Corner-point input of a tensor-product grid with vertical pillars,
+///        for the tests that need to go through processEclipseFormat().
+///
+/// The zcorn values may be changed before calling grdeclData() to get a
+/// non-Cartesian grid on the same pillars.
+struct CornerPointInput
+{
+    /// \param coordinates The strictly increasing node coordinates along
+    ///        each cartesian direction.
+    explicit CornerPointInput(const std::array<std::vector<double>, 3>& coordinates)
+    {
+        const auto& x = coordinates[0];
+        const auto& y = coordinates[1];
+        const auto& z = coordinates[2];
+        for (int d = 0; d < 3; ++d) {
+            dims[d] = coordinates[d].size() - 1;
+        }
+        const int nx = dims[0], ny = dims[1], nz = dims[2];
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                const double pillar[6] = { x[i], y[j], z[0], x[i], y[j], z[nz] };
+                coord.insert(coord.end(), pillar, pillar + 6);
+            }
+        }
+        for (int k = 0; k < nz; ++k) {
+            zcorn.insert(zcorn.end(), 4*nx*ny, z[k]);
+            zcorn.insert(zcorn.end(), 4*nx*ny, z[k + 1]);
+        }
+        actnum.assign(nx*ny*nz, 1);
+    }
+
+    /// \brief The input referring to the vectors of this object.
+    grdecl grdeclData() const
+    {
+        grdecl g;
+        g.dims[0] = dims[0];
+        g.dims[1] = dims[1];
+        g.dims[2] = dims[2];
+        g.coord = coord.data();
+        g.zcorn = zcorn.data();
+        g.actnum = actnum.data();
+        return g;
+    }
+
+    std::array<int, 3> dims;
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+    std::vector<int> actnum;
+};
+
+#endif // OPM_TESTS_CPGRID_CORNERPOINT_INPUT_HEADER
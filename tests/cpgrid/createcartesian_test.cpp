@@ -0,0 +1,169 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE CreateCartesianTests
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include "cornerpoint_input.hpp"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Build the grid through the corner-point processing.
+    void processCornerPoint(const std::array<std::vector<double>, 3>& coordinates,
+                            Dune::CpGrid& grid)
+    {
+        const CornerPointInput input(coordinates);
+        grid.processEclipseFormat(input.grdeclData(), false);
+    }
+
+    template <class Vector>
+    void checkClose(const Vector& a, const Vector& b, const double scale)
+    {
+        for (int d = 0; d < 3; ++d) {
+            BOOST_CHECK_SMALL(a[d] - b[d], 1e-12*scale);
+        }
+    }
+
+    void checkEqual(const Dune::CpGrid& fast, const Dune::CpGrid& ref, const double scale)
+    {
+        BOOST_REQUIRE_EQUAL(fast.numCells(), ref.numCells());
+        BOOST_REQUIRE_EQUAL(fast.numFaces(), ref.numFaces());
+        BOOST_REQUIRE_EQUAL(fast.numVertices(), ref.numVertices());
+        BOOST_CHECK(fast.logicalCartesianSize() == ref.logicalCartesianSize());
+        BOOST_CHECK(fast.globalCell() == ref.globalCell());
+
+        for (int cell = 0; cell < ref.numCells(); ++cell) {
+            const auto fast_row = fast.cellFaceRow(cell);
+            const auto ref_row = ref.cellFaceRow(cell);
+            BOOST_REQUIRE_EQUAL(fast_row.size(), ref_row.size());
+            for (int f = 0; f < ref_row.size(); ++f) {
+                BOOST_CHECK(fast_row[f] == ref_row[f]);
+            }
+            BOOST_CHECK(fast.cellToPoint(cell) == ref.cellToPoint(cell));
+            BOOST_CHECK_CLOSE(fast.cellVolume(cell), ref.cellVolume(cell), 1e-10);
+            checkClose(fast.cellCentroid(cell), ref.cellCentroid(cell), scale);
+        }
+
+        // Cell corners are taken from the shared point geometry.
+        const auto fast_view = fast.leafGridView();
+        const auto ref_view = ref.leafGridView();
+        auto fast_elem = fast_view.begin<0>();
+        for (const auto& ref_elem : elements(ref_view)) {
+            const auto fast_geom = fast_elem->geometry();
+            const auto ref_geom = ref_elem.geometry();
+            for (int corner = 0; corner < 8; ++corner) {
+                checkClose(fast_geom.corner(corner), ref_geom.corner(corner), scale);
+            }
+            ++fast_elem;
+        }
+
+        for (int face = 0; face < ref.numFaces(); ++face) {
+            BOOST_CHECK_EQUAL(fast.faceCell(face, 0), ref.faceCell(face, 0));
+            BOOST_CHECK_EQUAL(fast.faceCell(face, 1), ref.faceCell(face, 1));
+            BOOST_REQUIRE_EQUAL(fast.numFaceVertices(face), ref.numFaceVertices(face));
+            for (int v = 0; v < ref.numFaceVertices(face); ++v) {
+                BOOST_CHECK_EQUAL(fast.faceVertex(face, v), ref.faceVertex(face, v));
+            }
+            BOOST_CHECK_EQUAL(fast.boundaryId(face), ref.boundaryId(face));
+            BOOST_CHECK_CLOSE(fast.faceArea(face), ref.faceArea(face), 1e-10);
+            checkClose(fast.faceCentroid(face), ref.faceCentroid(face), scale);
+            checkClose(fast.faceNormal(face), ref.faceNormal(face), 1.0);
+        }
+
+        for (int vertex = 0; vertex < ref.numVertices(); ++vertex) {
+            checkClose(fast.vertexPosition(vertex), ref.vertexPosition(vertex), scale);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(uniform)
+{
+    const std::array<int, 3> dims = {{ 4, 3, 5 }};
+    const std::array<double, 3> cellsize = {{ 10.0, 20.0, 1.5 }};
+    Dune::CpGrid fast(Dune::MPIHelper::getLocalCommunicator());
+    fast.createCartesian(dims, cellsize);
+
+    std::array<std::vector<double>, 3> coordinates;
+    for (int dim = 0; dim < 3; ++dim) {
+        for (int n = 0; n <= dims[dim]; ++n) {
+            coordinates[dim].push_back(n*cellsize[dim]);
+        }
+    }
+    Dune::CpGrid ref(Dune::MPIHelper::getLocalCommunicator());
+    processCornerPoint(coordinates, ref);
+
+    checkEqual(fast, ref, 100.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(tensor)
+{
+    // Geometrically growing spacing, with an offset origin.
+    std::array<std::vector<double>, 3> coordinates;
+    const std::array<int, 3> dims = {{ 5, 1, 7 }};
+    const std::array<double, 3> growth = {{ 1.3, 2.0, 0.8 }};
+    for (int dim = 0; dim < 3; ++dim) {
+        double pos = 1000.0*dim;
+        double h = 1.0 + dim;
+        coordinates[dim].push_back(pos);
+        for (int n = 0; n < dims[dim]; ++n) {
+            pos += h;
+            h *= growth[dim];
+            coordinates[dim].push_back(pos);
+        }
+    }
+    Dune::CpGrid fast(Dune::MPIHelper::getLocalCommunicator());
+    fast.createCartesian(coordinates);
+    Dune::CpGrid ref(Dune::MPIHelper::getLocalCommunicator());
+    processCornerPoint(coordinates, ref);
+
+    checkEqual(fast, ref, 2000.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(invalidCoordinates)
+{
+    Dune::CpGrid grid(Dune::MPIHelper::getLocalCommunicator());
+    std::array<std::vector<double>, 3> coordinates = {{ { 0.0, 1.0 }, { 0.0, 1.0 }, { 0.0 } }};
+    BOOST_CHECK_THROW(grid.createCartesian(coordinates), std::invalid_argument);
+    coordinates[2] = { 0.0, 2.0, 1.0 };
+    BOOST_CHECK_THROW(grid.createCartesian(coordinates), std::invalid_argument);
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
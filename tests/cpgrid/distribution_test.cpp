@@ -27,6 +27,8 @@
 #include <opm/grid/utility/platform_dependent/reenable_warnings.h>
 #include <dune/grid/common/mcmgmapper.hh>
 
+#include <cmath>
+
 #ifdef HAVE_ZOLTAN
 bool USE_ZOLTAN = true;
 #else
@@ -349,6 +351,161 @@ private:
     std::vector<int>& cont_;
 };
 
+/// \brief Sends the global ids of the faces and checks them at the
+/// receiving end.
+class CheckFaceGlobalIdHandle
+{
+public:
+    CheckFaceGlobalIdHandle(const Dune::CpGrid& grid)
+        : grid_(grid)
+    {}
+
+    typedef int DataType;
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+    bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+    bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+    {
+        return true;
+    }
+
+    template<class T>
+    std::size_t size(const T&)
+    {
+        return 1;
+    }
+    template<class B, class T>
+    void gather(B& buffer, const T& t)
+    {
+        buffer.write(grid_.globalIdSet().id(t));
+        ++sent;
+    }
+    template<class B, class T>
+    void scatter(B& buffer, const T& t, std::size_t)
+    {
+        int id;
+        buffer.read(id);
+        if (id != grid_.globalIdSet().id(t))
+            OPM_THROW(std::runtime_error, "Received the data of another face");
+        ++received;
+    }
+    bool contains(int dim, int codim)
+    {
+        return dim==3 && codim==1;
+    }
+    int sent = 0;
+    int received = 0;
+private:
+    const Dune::CpGrid& grid_;
+};
+
+/// \brief Sends the global id of a cell between one and three times
+/// and stores it at the receiving end, if all copies match.
+class VariableSizeGlobalIdHandle
+{
+public:
+    VariableSizeGlobalIdHandle(const Dune::CpGrid& grid, std::vector<int>& received)
+        : grid_(grid), received_(received)
+    {}
+
+    typedef int DataType;
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+    bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+    bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+    {
+        return false;
+    }
+
+    template<class T>
+    std::size_t size(const T& t)
+    {
+        return 1 + grid_.globalIdSet().id(t) % 3;
+    }
+    template<class B, class T>
+    void gather(B& buffer, const T& t)
+    {
+        for (std::size_t i = 0; i < size(t); ++i)
+            buffer.write(grid_.globalIdSet().id(t));
+    }
+    template<class B, class T>
+    void scatter(B& buffer, const T& t, std::size_t s)
+    {
+        bool match = s == size(t);
+        for (std::size_t i = 0; i < s; ++i)
+        {
+            int id;
+            buffer.read(id);
+            match = match && id == grid_.globalIdSet().id(t);
+        }
+        received_[t.index()] = match ? grid_.globalIdSet().id(t) : -2;
+    }
+    bool contains(int dim, int codim)
+    {
+        return dim==3 && codim==0;
+    }
+private:
+    const Dune::CpGrid& grid_;
+    std::vector<int>& received_;
+};
+
+/// \brief Sends the center of cells and points, the former followed by
+/// zero to two copies of its first coordinate, and counts how often the
+/// receiving end gets the entities with matching values.
+class CenterCountHandle
+{
+public:
+    CenterCountHandle(std::vector<int>& cell_counts, std::vector<int>& point_counts)
+        : cell_counts_(cell_counts), point_counts_(point_counts)
+    {}
+
+    typedef double DataType;
+#if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
+    bool fixedSize(int /*dim*/, int /*codim*/)
+#else
+    bool fixedsize(int /*dim*/, int /*codim*/)
+#endif
+    {
+        return false;
+    }
+
+    template<class T>
+    std::size_t size(const T& t)
+    {
+        return T::codimension == 0 ? 3 + int(t.geometry().center()[0]) % 3 : 3;
+    }
+    template<class B, class T>
+    void gather(B& buffer, const T& t)
+    {
+        const auto center = t.geometry().center();
+        for (std::size_t i = 0; i < size(t); ++i)
+            buffer.write(center[i < 3 ? i : 0]);
+    }
+    template<class B, class T>
+    void scatter(B& buffer, const T& t, std::size_t s)
+    {
+        const auto center = t.geometry().center();
+        bool match = s == size(t);
+        for (std::size_t i = 0; i < s; ++i)
+        {
+            double value;
+            buffer.read(value);
+            match = match && std::abs(value - center[i < 3 ? i : 0]) < 1e-12;
+        }
+        auto& counts = T::codimension == 0 ? cell_counts_ : point_counts_;
+        counts[t.index()] += match ? 1 : 1000;
+    }
+    bool contains(int dim, int codim)
+    {
+        return dim==3 && (codim==0 || codim==3);
+    }
+private:
+    std::vector<int>& cell_counts_;
+    std::vector<int>& point_counts_;
+};
+
 BOOST_AUTO_TEST_CASE(testDistributedComm)
 {
 #if HAVE_MPI
@@ -379,6 +536,332 @@ BOOST_AUTO_TEST_CASE(testDistributedComm)
 #endif
 }
 
+BOOST_AUTO_TEST_CASE(testDistributedFaceComm)
+{
+#if HAVE_MPI
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+
+    for (const auto iftype : { Dune::InteriorBorder_InteriorBorder_Interface,
+                               Dune::InteriorBorder_All_Interface,
+                               Dune::All_All_Interface })
+    {
+        CheckFaceGlobalIdHandle handle(grid);
+        grid.communicate(handle, iftype, Dune::ForwardCommunication);
+        const int sent = grid.comm().sum(handle.sent);
+        BOOST_CHECK_EQUAL(sent, grid.comm().sum(handle.received));
+        if (grid.comm().size() > 1)
+            BOOST_CHECK(sent > 0);
+    }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(testCommunicationBackends)
+{
+#if HAVE_MPI
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+#ifdef HAVE_DUNE_ISTL
+    using AttributeSet = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+#else
+    enum AttributeSet{owner, overlap, copy};
+#endif
+    const auto& indexSet = grid.getCellIndexSet();
+
+    // Threaded packing with point-to-point messages and neighborhood
+    // collectives, and serial packing with neighborhood collectives.
+    for (const auto& backend : { std::make_pair(3, false), std::make_pair(3, true),
+                                 std::make_pair(0, true) })
+    {
+        grid.setThreadedPacking(backend.first);
+        grid.setNeighborCollectives(backend.second);
+
+        // Fixed size
+        std::vector<int> cont(grid.size(0), 1);
+        for ( const auto& index: indexSet)
+            if (index.local().attribute() != AttributeSet::owner )
+                cont[index.local()] = -1;
+        CopyCellValues handle(cont);
+        grid.communicate(handle, Dune::InteriorBorder_All_Interface,
+                         Dune::ForwardCommunication);
+        for ( const auto& index: indexSet)
+            BOOST_REQUIRE(cont[index.local()] == 1);
+
+        // Variable size
+        std::vector<int> received(grid.size(0), -1);
+        VariableSizeGlobalIdHandle variable_handle(grid, received);
+        grid.communicate(variable_handle, Dune::InteriorBorder_All_Interface,
+                         Dune::ForwardCommunication);
+        for (const auto& element : elements(grid.leafGridView()))
+        {
+            if (element.partitionType() != Dune::InteriorEntity)
+                BOOST_CHECK_EQUAL(received[element.index()], grid.globalIdSet().id(element));
+            else
+                BOOST_CHECK_EQUAL(received[element.index()], -1);
+        }
+    }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(testCellValueComm)
+{
+#if HAVE_MPI
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+    const int block_size = 3;
+
+    // Without (InteriorBorder_All) and with (All_All) cells that are both
+    // sent and received. The latter sends the values of the copies, too.
+    for (const auto iftype : { Dune::InteriorBorder_All_Interface,
+                               Dune::All_All_Interface })
+    {
+        for (int repetition = 0; repetition < 2; ++repetition)
+        {
+            std::vector<double> values(block_size * grid.size(0), -1.0);
+            for (const auto& element : elements(grid.leafGridView()))
+                if (element.partitionType() == Dune::InteriorEntity
+                    || iftype == Dune::All_All_Interface)
+                    for (int i = 0; i < block_size; ++i)
+                        values[block_size * element.index() + i] = grid.globalIdSet().id(element) + 0.1 * i;
+            grid.communicate(values, block_size, iftype, Dune::ForwardCommunication);
+            for (const auto& element : elements(grid.leafGridView()))
+                for (int i = 0; i < block_size; ++i)
+                    BOOST_CHECK_EQUAL(values[block_size * element.index() + i],
+                                      grid.globalIdSet().id(element) + 0.1 * i);
+        }
+    }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(testCommunicationStatistics)
+{
+#if HAVE_MPI
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+
+    std::vector<int> cont(grid.size(0), 1);
+    CopyCellValues handle(cont);
+    grid.setCommunicationStatistics(true);
+    grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    grid.setThreadedPacking(3);
+    grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    grid.setThreadedPacking(0);
+    grid.setCommunicationStatistics(false);
+    grid.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+
+    const auto reports = grid.communicationReport();
+    BOOST_REQUIRE_EQUAL(grid.comm().max(int(reports.size())), 1);
+    BOOST_REQUIRE_EQUAL(grid.comm().min(int(reports.size())), 1);
+    const auto& report = reports.front();
+    BOOST_CHECK_EQUAL(report.key.site, "communicate");
+    BOOST_CHECK_EQUAL(report.key.interface, "InteriorBorder_All");
+    const auto& records = grid.communicationStatistics().records();
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records.begin()->second.calls, report.local.calls);
+    BOOST_CHECK_EQUAL(report.local.bytes, records.begin()->second.bytes);
+    BOOST_CHECK(report.min.calls <= report.average.calls && report.average.calls <= report.max.calls);
+    BOOST_CHECK(report.min.bytes <= report.average.bytes && report.average.bytes <= report.max.bytes);
+    if (grid.comm().size() > 1)
+    {
+        // Both backends send to each neighbor.
+        BOOST_CHECK_EQUAL(report.max.calls, 2);
+        BOOST_CHECK(report.max.messages >= 2);
+        BOOST_CHECK(report.max.bytes >= 2 * sizeof(int));
+        BOOST_CHECK(report.max.neighbors >= 1);
+    }
+
+    grid.clearCommunicationStatistics();
+    BOOST_CHECK(grid.communicationStatistics().records().empty());
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(testInteriorFirstOrdering)
+{
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    auto ranges = grid.interiorFirstCellRanges();
+    BOOST_CHECK_EQUAL(ranges[0], grid.size(0));
+    BOOST_CHECK_EQUAL(ranges[1], grid.size(0));
+    grid.setInteriorFirstOrdering(true);
+    if (!grid.loadBalance(1, USE_ZOLTAN))
+        return;
+
+    ranges = grid.interiorFirstCellRanges();
+    BOOST_REQUIRE(ranges[0] <= ranges[1]);
+    BOOST_REQUIRE(ranges[1] <= ranges[2]);
+    BOOST_REQUIRE_EQUAL(ranges[2], grid.size(0));
+    const auto& gv = grid.leafGridView();
+    std::vector<int> gids(grid.size(0), -1);
+    for (const auto& element : elements(gv))
+    {
+        const int index = element.index();
+        bool overlap_neighbor = false;
+        for (const auto& intersection : intersections(gv, element))
+            if (intersection.neighbor())
+                overlap_neighbor = overlap_neighbor
+                    || intersection.outside().partitionType() == Dune::OverlapEntity;
+        if (index < ranges[1])
+        {
+            BOOST_CHECK(element.partitionType() == Dune::InteriorEntity);
+            BOOST_CHECK_EQUAL(overlap_neighbor, index >= ranges[0]);
+            gids[index] = grid.globalIdSet().id(element);
+        }
+        else
+            BOOST_CHECK(element.partitionType() == Dune::OverlapEntity);
+    }
+
+    // The cells of each range are sorted by global index.
+    for (int i = 1; i < grid.size(0); ++i)
+        if (i != ranges[0] && i != ranges[1])
+            BOOST_CHECK(grid.globalCell()[i - 1] < grid.globalCell()[i]);
+
+    // The interfaces follow the numbering.
+    std::vector<double> values(grid.size(0), -1.0);
+    for (int i = 0; i < ranges[1]; ++i)
+        values[i] = gids[i];
+    grid.communicate(values, 1, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    for (const auto& element : elements(gv))
+        BOOST_CHECK_EQUAL(values[element.index()], grid.globalIdSet().id(element));
+}
+
+BOOST_AUTO_TEST_CASE(testScatterCartesianData)
+{
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+    const int block_size = 2;
+    const std::size_t cartesian_size = dims[0] * dims[1] * dims[2];
+
+    // Whole field, chunks of less than a cell, and chunks of a few cells.
+    for (const std::size_t max_chunk_size : { std::size_t(0), std::size_t(1), std::size_t(7) })
+    {
+        std::size_t next = 0;
+        std::vector<int> values;
+        grid.scatterCartesianData([&](std::size_t begin, std::size_t end, int* chunk)
+                                  {
+                                      BOOST_REQUIRE_EQUAL(begin, next);
+                                      BOOST_REQUIRE(end > begin);
+                                      if (max_chunk_size > 0)
+                                          BOOST_REQUIRE((end - begin - 1) * block_size < max_chunk_size);
+                                      for (std::size_t c = begin; c < end; ++c)
+                                          for (int i = 0; i < block_size; ++i)
+                                              chunk[(c - begin) * block_size + i] = 10 * c + i;
+                                      next = end;
+                                  },
+                                  values, block_size, 0, max_chunk_size);
+        BOOST_REQUIRE_EQUAL(values.size(), std::size_t(block_size * grid.size(0)));
+        if (grid.comm().rank() == 0)
+            BOOST_CHECK_EQUAL(next, cartesian_size);
+        for (int cell = 0; cell < grid.size(0); ++cell)
+            for (int i = 0; i < block_size; ++i)
+                BOOST_CHECK_EQUAL(values[block_size * cell + i], 10 * grid.globalCell()[cell] + i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testStreamedGatherOnRoot)
+{
+    Dune::CpGrid grid;
+    std::array<int, 3> dims={{8, 4, 2}};
+    std::array<double, 3> size={{ 8.0, 4.0, 2.0}};
+    grid.createCartesian(dims, size);
+    grid.loadBalance(1, USE_ZOLTAN);
+    if (grid.comm().size() == 1)
+        return;
+    auto global_grid = grid;
+    global_grid.switchToGlobalView();
+    // Only rank 0 holds the global grid.
+    const int root = 0;
+    const bool is_root = grid.comm().rank() == root;
+    if (is_root)
+    {
+        BOOST_REQUIRE(global_grid.size(0) > 0);
+        BOOST_REQUIRE(global_grid.size(3) > 0);
+    }
+    std::vector<int> no_counts;
+    CenterCountHandle no_handle(no_counts, no_counts);
+    BOOST_CHECK_THROW(grid.gatherData(no_handle, 1, 4), std::logic_error);
+
+    // Cells and points in one call, such that the points of fast ranks
+    // arrive while the root still waits for the cells of others.
+    std::vector<int> all_cell_counts(global_grid.size(0)), all_point_counts(global_grid.size(3));
+    CenterCountHandle all_handle(all_cell_counts, all_point_counts);
+    grid.gatherData(all_handle, root);
+    for (const std::size_t max_chunk_size : { std::size_t(1), std::size_t(4) })
+    {
+        std::vector<int> cell_counts(global_grid.size(0)), point_counts(global_grid.size(3));
+        CenterCountHandle handle(cell_counts, point_counts);
+        for (int repetition = 0; repetition < 2; ++repetition)
+            grid.gatherData(handle, root, max_chunk_size);
+        if (is_root)
+        {
+            for (int cell = 0; cell < global_grid.size(0); ++cell)
+            {
+                BOOST_CHECK_EQUAL(all_cell_counts[cell], 1);
+                BOOST_CHECK_EQUAL(cell_counts[cell], 2);
+            }
+            for (int point = 0; point < global_grid.size(3); ++point)
+            {
+                BOOST_CHECK(all_point_counts[point] <= 1);
+                BOOST_CHECK_EQUAL(point_counts[point], 2 * all_point_counts[point]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testRemoteIndicesFromExportList)
+{
+#if HAVE_MPI
+    // The remote indices set up from the export list of the partitioning
+    // have to be the ones RemoteIndices::rebuild finds by communication.
+    for (const int overlap_layers : { 1, 2 })
+    {
+        Dune::CpGrid grid;
+        std::array<int, 3> dims={{8, 8, 2}};
+        std::array<double, 3> size={{ 8.0, 8.0, 2.0}};
+        grid.createCartesian(dims, size);
+        grid.loadBalance(overlap_layers, USE_ZOLTAN);
+
+        Dune::CpGrid::RemoteIndices rebuilt(grid.getCellIndexSet(), grid.getCellIndexSet(),
+                                            grid.comm());
+        rebuilt.rebuild<false>();
+        const auto& remote = grid.getCellRemoteIndices();
+        BOOST_REQUIRE_EQUAL(remote.neighbours(), rebuilt.neighbours());
+        for (auto l1 = remote.begin(), l2 = rebuilt.begin(); l1 != remote.end(); ++l1, ++l2)
+        {
+            BOOST_REQUIRE_EQUAL(l1->first, l2->first);
+            // One list for sending and receiving, as both index sets are the same.
+            BOOST_CHECK(l1->second.first == l1->second.second);
+            BOOST_REQUIRE_EQUAL(l1->second.first->size(), l2->second.first->size());
+            auto i2 = l2->second.first->begin();
+            for (const auto& index : *l1->second.first)
+            {
+                BOOST_CHECK_EQUAL(index.attribute(), i2->attribute());
+                BOOST_CHECK_EQUAL(index.localIndexPair().global(), i2->localIndexPair().global());
+                BOOST_CHECK_EQUAL(index.localIndexPair().local().local(),
+                                  i2->localIndexPair().local().local());
+                ++i2;
+            }
+        }
+    }
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(compareWithSequential)
 {
 #if HAVE_MPI
@@ -593,6 +1076,9 @@ BOOST_AUTO_TEST_CASE(distribute)
                                                      point_ids,
                                                      cell_ids);
         grid.gatherData(gather_gid_set_data);
+        // Only on one rank, at once and streamed in small chunks.
+        grid.gatherData(gather_gid_set_data, 0);
+        grid.gatherData(gather_gid_set_data, 0, 3);
 
     }
     decltype(std::get<0>(Dune::CpGrid().loadBalance(nullptr))) test1 = true;
@@ -0,0 +1,139 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE LazyGeometryTests
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include "cornerpoint_input.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool hasPhase(const Dune::CpGrid& grid, const std::string& name)
+    {
+        const auto& phases = grid.constructionTimings().phases();
+        return std::any_of(phases.begin(), phases.end(),
+                           [&name](const Dune::cpgrid::ConstructionPhase& p) { return p.name == name; });
+    }
+
+    // A grid with a fault between i = 1 and i = 2, such that the
+    // faces along it are split.
+    CornerPointInput faultedInput()
+    {
+        const int nx = 4, ny = 3, nz = 2;
+        CornerPointInput input({{ { 0.0, 1.0, 2.0, 3.0, 4.0 },
+                                  { 0.0, 1.0, 2.0, 3.0 },
+                                  { 0.0, 1.0, double(nz + 1) } }});
+        input.zcorn.clear();
+        for (int k = 0; k < 2*nz; ++k) {
+            const int layer = (k + 1) / 2;
+            for (int j = 0; j < 2*ny; ++j) {
+                for (int i = 0; i < 2*nx; ++i) {
+                    const double throw_ = i >= 4 ? 0.5 : 0.0;
+                    input.zcorn.push_back(layer + throw_ + 0.1*((i + 1) / 2)*((j + 1) / 2));
+                }
+            }
+        }
+        return input;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(sameAsEager)
+{
+    const CornerPointInput input = faultedInput();
+    for (const bool turn_normals : { false, true }) {
+        Dune::CpGrid eager(Dune::MPIHelper::getLocalCommunicator());
+        eager.processEclipseFormat(input.grdeclData(), false, turn_normals);
+
+        Dune::CpGrid lazy(Dune::MPIHelper::getLocalCommunicator());
+        lazy.setLazyGeometry(true);
+        lazy.processEclipseFormat(input.grdeclData(), false, turn_normals);
+        BOOST_CHECK(!hasPhase(lazy, "computeFaceGeometry"));
+        BOOST_REQUIRE_EQUAL(lazy.numCells(), eager.numCells());
+        BOOST_REQUIRE_EQUAL(lazy.numFaces(), eager.numFaces());
+        BOOST_REQUIRE_EQUAL(lazy.numVertices(), eager.numVertices());
+
+        // Faces first, then the cells.
+        for (int face = 0; face < eager.numFaces(); ++face) {
+            BOOST_CHECK_EQUAL(lazy.faceArea(face), eager.faceArea(face));
+            for (int d = 0; d < 3; ++d) {
+                BOOST_CHECK_EQUAL(lazy.faceCentroid(face)[d], eager.faceCentroid(face)[d]);
+                BOOST_CHECK_EQUAL(lazy.faceNormal(face)[d], eager.faceNormal(face)[d]);
+            }
+        }
+        BOOST_CHECK(hasPhase(lazy, "computeFaceGeometry"));
+        BOOST_CHECK(!hasPhase(lazy, "computeCellGeometry"));
+        for (int cell = 0; cell < eager.numCells(); ++cell) {
+            BOOST_CHECK_EQUAL(lazy.cellVolume(cell), eager.cellVolume(cell));
+            for (int d = 0; d < 3; ++d) {
+                BOOST_CHECK_EQUAL(lazy.cellCentroid(cell)[d], eager.cellCentroid(cell)[d]);
+            }
+        }
+        BOOST_CHECK(hasPhase(lazy, "computeCellGeometry"));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(entityGeometry)
+{
+    const CornerPointInput input = faultedInput();
+    Dune::CpGrid eager(Dune::MPIHelper::getLocalCommunicator());
+    eager.processEclipseFormat(input.grdeclData(), false);
+    Dune::CpGrid lazy(Dune::MPIHelper::getLocalCommunicator());
+    lazy.setLazyGeometry(true);
+    lazy.processEclipseFormat(input.grdeclData(), false);
+
+    const auto eager_view = eager.leafGridView();
+    const auto lazy_view = lazy.leafGridView();
+    auto eager_elem = eager_view.begin<0>();
+    for (const auto& elem : elements(lazy_view)) {
+        BOOST_CHECK_EQUAL(elem.geometry().volume(), eager_elem->geometry().volume());
+        for (int corner = 0; corner < 8; ++corner) {
+            BOOST_CHECK(elem.geometry().corner(corner) == eager_elem->geometry().corner(corner));
+        }
+        auto eager_is = eager_view.ibegin(*eager_elem);
+        for (const auto& is : intersections(lazy_view, elem)) {
+            BOOST_CHECK(is.centerUnitOuterNormal() == eager_is->centerUnitOuterNormal());
+            BOOST_CHECK_EQUAL(is.geometry().volume(), eager_is->geometry().volume());
+            ++eager_is;
+        }
+        ++eager_elem;
+    }
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,79 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE MemoryUsageTests
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace
+{
+    std::size_t bytesOf(const Dune::cpgrid::MemoryUsage& usage, const std::string& name)
+    {
+        auto component = std::find_if(usage.components.begin(), usage.components.end(),
+                                      [&name](const auto& c) { return c.first == name; });
+        BOOST_REQUIRE_MESSAGE(component != usage.components.end(), "Missing component " << name);
+        return component->second;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(serialGrid)
+{
+    Dune::CpGrid grid(Dune::MPIHelper::getLocalCommunicator());
+    const std::array<int, 3> dims = {{ 4, 3, 2 }};
+    const std::array<double, 3> cellsize = {{ 1.0, 1.0, 1.0 }};
+    grid.createCartesian(dims, cellsize);
+    const int nc = grid.numCells();
+    const int nf = grid.numFaces();
+
+    const auto usage = grid.memoryUsage();
+    BOOST_CHECK_GE(bytesOf(usage, "global/cell_to_face"), 6*nc*sizeof(int));
+    BOOST_CHECK_GE(bytesOf(usage, "global/face_to_cell"), (2*nf - 2*(12 + 8 + 6))*sizeof(int));
+    BOOST_CHECK_GE(bytesOf(usage, "global/face_to_point"), 4*nf*sizeof(int));
+    BOOST_CHECK_GE(bytesOf(usage, "global/cell_to_point"), 8*nc*sizeof(int));
+    BOOST_CHECK_GE(bytesOf(usage, "global/global_cell"), nc*sizeof(int));
+    BOOST_CHECK_GT(bytesOf(usage, "global/geometry"), 0u);
+    BOOST_CHECK_EQUAL(bytesOf(usage, "global/zcorn"), 0u);
+
+    std::size_t sum = 0;
+    for (const auto& component : usage.components) {
+        BOOST_CHECK(component.first.rfind("distributed/", 0) != 0);
+        sum += component.second;
+    }
+    BOOST_CHECK_EQUAL(usage.total(), sum);
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
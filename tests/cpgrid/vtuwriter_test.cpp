@@ -0,0 +1,129 @@
+#include <config.h>
+
+#define BOOST_TEST_MODULE CpGridVtuWriterTests
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/cpgrid/CpGridVtuWriter.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string readFile(const std::string& fname)
+    {
+        std::ifstream is(fname, std::ios::binary);
+        BOOST_REQUIRE(is);
+        return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+
+    bool hasField(const std::string& xml, const std::string& name)
+    {
+        return xml.find("Name=\"" + name + "\"") != std::string::npos;
+    }
+
+    // Values of the last appended block of a piece file.
+    std::vector<double> lastBlock(const std::string& vtu, const int num_values)
+    {
+        const std::string end_tag = "\n  </AppendedData>";
+        const auto end = vtu.rfind(end_tag);
+        BOOST_REQUIRE(end != std::string::npos);
+        const std::size_t bytes = num_values * sizeof(double);
+        std::uint64_t header;
+        std::memcpy(&header, vtu.data() + end - bytes - sizeof header, sizeof header);
+        BOOST_CHECK_EQUAL(header, bytes);
+        std::vector<double> values(num_values);
+        std::memcpy(values.data(), vtu.data() + end - bytes, bytes);
+        return values;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(writeSteps)
+{
+    Dune::CpGrid grid;
+    const std::array<int, 3> dims = {{ 4, 3, 2 }};
+    const std::array<double, 3> size = {{ 1.0, 1.0, 1.0 }};
+    grid.createCartesian(dims, size);
+    grid.loadBalance();
+    const auto& comm = grid.comm();
+
+    std::vector<double> pressure(grid.numCells());
+    std::vector<double> velocity(3 * grid.numCells(), 1.0);
+    for (int cell = 0; cell < grid.numCells(); ++cell) {
+        pressure[cell] = grid.globalCell()[cell];
+    }
+
+    Dune::CpGridVtuWriter writer(grid, "vtuwriter_test", true);
+    writer.addCellData("pressure", pressure);
+    writer.addCellData("velocity", velocity, 3);
+    const std::string step0 = writer.write(0.0);
+    const std::string xml0 = readFile(step0);
+    BOOST_CHECK(hasField(xml0, "GlobalCell"));
+    BOOST_CHECK(hasField(xml0, "pressure"));
+    BOOST_CHECK(hasField(xml0, "velocity"));
+
+    // Only the pressure changes.
+    for (auto& p : pressure) {
+        p += 1.0;
+    }
+    const std::string step1 = writer.write(1.0);
+    const std::string xml1 = readFile(step1);
+    BOOST_CHECK(hasField(xml1, "pressure"));
+    BOOST_CHECK(!hasField(xml1, "velocity"));
+
+    // Nothing changed.
+    const std::string xml2 = readFile(writer.write(2.0));
+    BOOST_CHECK(!hasField(xml2, "pressure"));
+    BOOST_CHECK(!hasField(xml2, "velocity"));
+
+    // Without change detection all fields are written.
+    writer.writeChangedOnly(false);
+    const std::string xml3 = readFile(writer.write(3.0));
+    BOOST_CHECK(hasField(xml3, "pressure"));
+    BOOST_CHECK(hasField(xml3, "velocity"));
+
+    // The piece of this rank holds its interior cells, the pressure
+    // being the last field written.
+    int num_interior = 0;
+    std::vector<double> interior_pressure;
+    const auto gv = grid.leafGridView();
+    for (const auto& element : elements(gv, Dune::Partitions::interior)) {
+        interior_pressure.push_back(pressure[gv.indexSet().index(element)]);
+        ++num_interior;
+    }
+    writer.clear();
+    writer.addCellData("pressure", pressure);
+    writer.write(4.0);
+    char piece[64];
+    std::snprintf(piece, sizeof piece, "vtuwriter_test-00004-p%04d.vtu", comm.rank());
+    const std::string vtu = readFile(piece);
+    BOOST_CHECK(vtu.find("NumberOfCells=\"" + std::to_string(num_interior) + "\"") != std::string::npos);
+    const auto written = lastBlock(vtu, num_interior);
+    BOOST_CHECK_EQUAL_COLLECTIONS(written.begin(), written.end(),
+                                  interior_pressure.begin(), interior_pressure.end());
+
+    if (comm.rank() == 0) {
+        const std::string pvd = readFile("vtuwriter_test.pvd");
+        BOOST_CHECK(pvd.find("file=\"vtuwriter_test-00004.pvtu\"") != std::string::npos);
+    }
+}
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,149 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE ComputeGeometryTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/cart_grid.h>
+#include <opm/grid/cornerpoint_grid.h>  /* compute_geometry */
+
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    struct GridDeleter
+    {
+        void operator()(UnstructuredGrid* g) const { destroy_grid(g); }
+    };
+    using GridPtr = std::unique_ptr<UnstructuredGrid, GridDeleter>;
+
+    // Deterministic displacement of node n, in [-amp, amp].
+    double displacement(const int n, const int d, const double amp)
+    {
+        return amp * std::sin(1.7*n + 0.9*d + 0.3);
+    }
+
+    void moveNodes(UnstructuredGrid& g, const std::vector<int>& nodes, const double amp)
+    {
+        const int dim = g.dimensions;
+        for (const int n : nodes) {
+            for (int d = 0; d < dim; ++d) {
+                g.node_coordinates[dim*n + d] += displacement(n, d, amp);
+            }
+        }
+    }
+
+    template <typename T>
+    void checkEqual(const T* a, const T* b, const int n)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(a, a + n, b, b + n);
+    }
+
+    void checkSameGeometry(const UnstructuredGrid& g1, const UnstructuredGrid& g2)
+    {
+        const int dim = g1.dimensions;
+        checkEqual(g1.face_centroids, g2.face_centroids, dim*g1.number_of_faces);
+        checkEqual(g1.face_normals, g2.face_normals, dim*g1.number_of_faces);
+        checkEqual(g1.face_areas, g2.face_areas, g1.number_of_faces);
+        checkEqual(g1.cell_centroids, g2.cell_centroids, dim*g1.number_of_cells);
+        checkEqual(g1.cell_volumes, g2.cell_volumes, g1.number_of_cells);
+    }
+
+    void checkIncremental(GridPtr g_incr, GridPtr g_full)
+    {
+        std::vector<int> all(g_incr->number_of_nodes);
+        std::iota(all.begin(), all.end(), 0);
+        moveNodes(*g_incr, all, 0.05);
+        moveNodes(*g_full, all, 0.05);
+        compute_geometry(g_incr.get());
+        compute_geometry(g_full.get());
+        checkSameGeometry(*g_incr, *g_full);
+
+        // Move every seventh node, update one grid incrementally.
+        std::vector<int> moved;
+        for (int n = 0; n < g_incr->number_of_nodes; n += 7) {
+            moved.push_back(n);
+        }
+        moveNodes(*g_incr, moved, 0.1);
+        moveNodes(*g_full, moved, 0.1);
+        compute_geometry_incremental(g_incr.get(), moved.size(), moved.data());
+        compute_geometry(g_full.get());
+        checkSameGeometry(*g_incr, *g_full);
+
+        // Nothing moved.
+        compute_geometry_incremental(g_incr.get(), 0, nullptr);
+        checkSameGeometry(*g_incr, *g_full);
+    }
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(HexahedralGeometry)
+{
+    // Exercises the hexahedral fast path.
+    const double dx = 0.5, dy = 2.0, dz = 0.25;
+    GridPtr g(create_grid_hexa3d(4, 3, 2, dx, dy, dz));
+    BOOST_REQUIRE(g);
+    for (int c = 0; c < g->number_of_cells; ++c) {
+        BOOST_CHECK_CLOSE(g->cell_volumes[c], dx*dy*dz, 1e-10);
+    }
+    for (int f = 0; f < g->number_of_faces; ++f) {
+        const double* n = g->face_normals + 3*f;
+        BOOST_CHECK_CLOSE(std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]), g->face_areas[f], 1e-10);
+    }
+
+    // Deformed grid still fills the same total volume when only
+    // interior nodes move.
+    std::vector<int> interior;
+    for (int n = 0; n < g->number_of_nodes; ++n) {
+        const double* x = g->node_coordinates + 3*n;
+        const bool on_boundary = x[0] < 1e-12 || x[0] > 4*dx - 1e-12
+            || x[1] < 1e-12 || x[1] > 3*dy - 1e-12
+            || x[2] < 1e-12 || x[2] > 2*dz - 1e-12;
+        if (!on_boundary) {
+            interior.push_back(n);
+        }
+    }
+    moveNodes(*g, interior, 0.05);
+    compute_geometry_incremental(g.get(), interior.size(), interior.data());
+    const double total = std::accumulate(g->cell_volumes, g->cell_volumes + g->number_of_cells, 0.0);
+    BOOST_CHECK_CLOSE(total, 24*dx*dy*dz, 1e-10);
+}
+
+
+BOOST_AUTO_TEST_CASE(Incremental3D)
+{
+    checkIncremental(GridPtr(create_grid_hexa3d(5, 4, 3, 1.0, 1.0, 1.0)),
+                     GridPtr(create_grid_hexa3d(5, 4, 3, 1.0, 1.0, 1.0)));
+}
+
+
+BOOST_AUTO_TEST_CASE(Incremental2D)
+{
+    checkIncremental(GridPtr(create_grid_cart2d(6, 5, 1.0, 1.0)),
+                     GridPtr(create_grid_cart2d(6, 5, 1.0, 1.0)));
+}
@@ -27,6 +27,9 @@
 
 #include <opm/grid/MinpvProcessor.hpp>
 
+#include <map>
+#include <vector>
+
 BOOST_AUTO_TEST_CASE(Pinch)
 {
     // Set up a simple example.
@@ -204,3 +207,66 @@ BOOST_AUTO_TEST_CASE(Processing)
     BOOST_CHECK_EQUAL(minpv_result6.nnc.size(), 1);
     BOOST_CHECK_EQUAL_COLLECTIONS(z6.begin(), z6.end(), zcorn4after.begin(), zcorn4after.end());
 }
+
+BOOST_AUTO_TEST_CASE(Columns)
+{
+    // 3 x 2 columns with the layers of the Processing case.
+    const int nx = 3, ny = 2, nz = 4;
+    const double depth[nz + 1] = { 0, 2, 3, 3, 6 };
+    std::vector<double> zcorn(8 * nx * ny * nz);
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j < 2 * ny; ++j) {
+            for (int i = 0; i < 2 * nx; ++i) {
+                zcorn[i + 2 * nx * (j + 2 * ny * 2 * k)] = depth[k];
+                zcorn[i + 2 * nx * (j + 2 * ny * (2 * k + 1))] = depth[k + 1];
+            }
+        }
+    }
+    const int num_cells = nx * ny * nz;
+    const double layer_pv[nz] = { 2, 1, 0, 3 };
+    const int layer_actnum[nz] = { 1, 1, 0, 1 };
+    std::vector<double> pv(num_cells), thickness(num_cells);
+    std::vector<int> actnum(num_cells);
+    for (int c = 0; c < num_cells; ++c) {
+        const int k = c / (nx * ny);
+        pv[c] = layer_pv[k];
+        actnum[c] = layer_actnum[k];
+        thickness[c] = depth[k + 1] - depth[k];
+    }
+    // Nothing to remove in column (1, 1).
+    const int column = 1 + nx * 1;
+    for (int k = 0; k < nz; ++k) {
+        pv[column + nx * ny * k] = 10.0;
+        actnum[column + nx * ny * k] = 1;
+    }
+    const std::vector<double> minpvv(num_cells, 1.5);
+
+    Opm::MinpvProcessor mp(nx, ny, nz);
+    auto z1 = zcorn;
+    const auto result = mp.process(thickness, 0.0, pv, minpvv, actnum, false, z1.data());
+
+    std::vector<std::size_t> removed;
+    std::map<int, int> nnc;
+    for (int c = 0; c < nx * ny; ++c) {
+        if (c != column) {
+            removed.push_back(c + nx * ny);
+            nnc.emplace(c, c + 3 * nx * ny);
+        }
+    }
+    BOOST_CHECK(result.removed_cells == removed);
+    BOOST_CHECK(result.nnc == nnc);
+
+    // The thickness computed from zcorn gives the same result.
+    auto z2 = zcorn;
+    const auto result2 = mp.process({}, 0.0, pv, minpvv, actnum, false, z2.data());
+    BOOST_CHECK(result2.removed_cells == removed);
+    BOOST_CHECK(result2.nnc == nnc);
+    BOOST_CHECK_EQUAL_COLLECTIONS(z1.begin(), z1.end(), z2.begin(), z2.end());
+    for (int c = 0; c < num_cells; ++c) {
+        const int i = c % nx, j = (c / nx) % ny, k = c / (nx * ny);
+        BOOST_CHECK_EQUAL(mp.cellThickness(i, j, k, zcorn.data()), thickness[c]);
+    }
+
+    // Wrong size of thickness input.
+    BOOST_CHECK_THROW(mp.process(std::vector<double>(3), 0.0, pv, minpvv, actnum, false, z2.data()), std::exception);
+}
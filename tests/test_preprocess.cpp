@@ -0,0 +1,170 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE PreprocessTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/cpgpreprocess/preprocess.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    using Point = std::array<double, 3>;
+
+    using Tops = std::array<double, 2>;
+
+    /// Two cells side by side along i, with a fault between them on the
+    /// pillars at x = 1. The tops of the left and right cell are at
+    /// left[j] and right[j] on the pillars at y = j. The bottoms are at
+    /// z = 2 and z = 2.5 and do not cross any line on the other side,
+    /// such that the fault face has exactly one intersection node: the
+    /// crossing of the two top lines.
+    struct FaultedPair
+    {
+        FaultedPair(const Tops& left, const Tops& right)
+        {
+            for (int j = 0; j <= 1; ++j) {
+                for (int i = 0; i <= 2; ++i) {
+                    const double pillar[6] = { double(i), double(j), -1.0, double(i), double(j), 3.0 };
+                    coord.insert(coord.end(), pillar, pillar + 6);
+                }
+            }
+            // Corners (2i + di, 2j + dj) of the top, then the bottom layer.
+            const Tops top[2] = { left, right };
+            const double bottom[2] = { 2.0, 2.5 };
+            for (int layer = 0; layer < 2; ++layer) {
+                for (int dj = 0; dj < 2; ++dj) {
+                    for (int c = 0; c < 4; ++c) {
+                        const int cell = c / 2;
+                        zcorn.push_back(layer == 0 ? top[cell][dj] : bottom[cell]);
+                    }
+                }
+            }
+            actnum.assign(2, 1);
+            g.dims[0] = 2;
+            g.dims[1] = 1;
+            g.dims[2] = 1;
+            g.coord = coord.data();
+            g.zcorn = zcorn.data();
+            g.actnum = actnum.data();
+            process_grdecl(&g, 0.0, nullptr, &out, false);
+        }
+
+        ~FaultedPair()
+        {
+            free_processed_grid(&out);
+        }
+
+        Point node(const int n) const
+        {
+            return {{ out.node_coordinates[3*n], out.node_coordinates[3*n + 1],
+                      out.node_coordinates[3*n + 2] }};
+        }
+
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        std::vector<int> actnum;
+        grdecl g;
+        processed_grid out;
+    };
+
+    /// The intersection as computed before the fallback for degenerate
+    /// lines was introduced. Lines p0-p1 and p2-p3, where p0 and p2 lie
+    /// on the first pillar.
+    Point previousIntersection(const Point& p0, const Point& p1, const Point& p2, const Point& p3)
+    {
+        const double z0 = p0[2], z1 = p1[2], z2 = p2[2], z3 = p3[2];
+        double a = 0;
+        if (std::fabs((z1 - z0) - (z3 - z2)) > 0.0) {
+            a = (z2 - z0) / ((z1 - z0) - (z3 - z2));
+        }
+        const double z = z0*(1.0 - a) + z1*a;
+        double b1 = (z2 - z) / (z2 - z0);
+        double b2 = (z - z0) / (z2 - z0);
+        const double x1 = p0[0]*b1 + p2[0]*b2;
+        const double y1 = p0[1]*b1 + p2[1]*b2;
+        b1 = (z - z3) / (z1 - z3);
+        b2 = (z1 - z) / (z1 - z3);
+        const double x2 = p1[0]*b1 + p3[0]*b2;
+        const double y2 = p1[1]*b1 + p3[1]*b2;
+        return {{ x1*(1.0 - a) + x2*a, y1*(1.0 - a) + y2*a, z }};
+    }
+
+    void checkInBoundingBox(const Point& node, const std::array<Point, 4>& corners)
+    {
+        for (int d = 0; d < 3; ++d) {
+            double low = corners[0][d], high = corners[0][d];
+            for (const auto& corner : corners) {
+                low = std::min(low, corner[d]);
+                high = std::max(high, corner[d]);
+            }
+            BOOST_CHECK_MESSAGE(node[d] >= low && node[d] <= high,
+                                "Coordinate " << d << " = " << node[d]
+                                << " outside [" << low << ", " << high << "]");
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(DegenerateIntersections)
+{
+    // The lines cross very close to the pillar at y = 0, and they are
+    // nearly parallel.
+    const std::array<Tops, 2> cases[2] = { {{ {{ 0.0, 0.0 }}, {{ -1e-11, 0.5 }} }},
+                                           {{ {{ 0.0, 1.0 }}, {{ -1e-11, 1.0 + 1e-11 }} }} };
+    for (const auto& tops : cases) {
+        const FaultedPair pair(tops[0], tops[1]);
+        const int np = pair.out.number_of_nodes_on_pillars;
+        BOOST_REQUIRE_EQUAL(pair.out.number_of_nodes - np, 1);
+        BOOST_CHECK(pair.out.number_of_degenerate_intersections > 0);
+        const std::array<Point, 4> corners = {{ {{ 1.0, 0.0, tops[0][0] }}, {{ 1.0, 1.0, tops[0][1] }},
+                                                {{ 1.0, 0.0, tops[1][0] }}, {{ 1.0, 1.0, tops[1][1] }} }};
+        checkInBoundingBox(pair.node(np), corners);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(WellConditionedIntersections)
+{
+    const Tops left = {{ 0.0, 0.0 }}, right = {{ -0.3, 0.7 }};
+    const FaultedPair pair(left, right);
+    const int np = pair.out.number_of_nodes_on_pillars;
+    BOOST_REQUIRE_EQUAL(pair.out.number_of_nodes - np, 1);
+    BOOST_CHECK_EQUAL(pair.out.number_of_degenerate_intersections, 0);
+
+    // Which line and pillar come first depends on the face topology,
+    // hence the node has to equal the previous formula for one of the
+    // orderings, bit by bit.
+    const Point left0 = {{ 1.0, 0.0, left[0] }}, left1 = {{ 1.0, 1.0, left[1] }};
+    const Point right0 = {{ 1.0, 0.0, right[0] }}, right1 = {{ 1.0, 1.0, right[1] }};
+    const Point node = pair.node(np);
+    const Point candidates[4] = { previousIntersection(left0, left1, right0, right1),
+                                  previousIntersection(right0, right1, left0, left1),
+                                  previousIntersection(left1, left0, right1, right0),
+                                  previousIntersection(right1, right0, left1, left0) };
+    BOOST_CHECK(std::find(std::begin(candidates), std::end(candidates), node) != std::end(candidates));
+    BOOST_CHECK_CLOSE(node[1], 0.3, 1e-10);
+    BOOST_CHECK_SMALL(node[2], 1e-14);
+}
@@ -0,0 +1,262 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define NVERBOSE // to suppress our messages when throwing
+
+#define BOOST_TEST_MODULE ReadGridTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/cart_grid.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct GridDeleter
+    {
+        void operator()(UnstructuredGrid* g) const { destroy_grid(g); }
+    };
+    using GridPtr = std::unique_ptr<UnstructuredGrid, GridDeleter>;
+
+    template <typename T>
+    void writeArray(std::ostream& os, const T* a, const int n)
+    {
+        for (int i = 0; i < n; ++i) {
+            os << a[i] << ((i % 7 == 6) ? '\n' : ' ');
+        }
+        os << '\n';
+    }
+
+    // Write the character representation read by read_grid().
+    void writeGridText(const UnstructuredGrid& g, const std::string& fname)
+    {
+        std::ofstream os(fname);
+        os.precision(17);
+        const int nd = g.dimensions;
+        const int nc = g.number_of_cells;
+        const int nf = g.number_of_faces;
+        os << nd << ' ' << nc << ' ' << nf << ' ' << g.number_of_nodes << ' '
+           << g.face_nodepos[nf] << ' ' << g.cell_facepos[nc] << ' '
+           << (g.cell_facetag != nullptr) << ' ' << (g.global_cell != nullptr) << '\n';
+        writeArray(os, g.cartdims, nd);
+        writeArray(os, g.node_coordinates, nd*g.number_of_nodes);
+        writeArray(os, g.face_nodepos, nf + 1);
+        writeArray(os, g.face_nodes, g.face_nodepos[nf]);
+        writeArray(os, g.face_cells, 2*nf);
+        writeArray(os, g.face_areas, nf);
+        writeArray(os, g.face_centroids, nd*nf);
+        writeArray(os, g.face_normals, nd*nf);
+        writeArray(os, g.cell_facepos, nc + 1);
+        for (int i = 0; i < g.cell_facepos[nc]; ++i) {
+            os << g.cell_faces[i];
+            if (g.cell_facetag != nullptr) {
+                os << '\t' << g.cell_facetag[i];
+            }
+            os << '\n';
+        }
+        if (g.global_cell != nullptr) {
+            writeArray(os, g.global_cell, nc);
+        }
+        writeArray(os, g.cell_volumes, nc);
+        writeArray(os, g.cell_centroids, nd*nc);
+    }
+
+    template <typename T>
+    void checkArray(const T* a, const T* b, const int n)
+    {
+        BOOST_REQUIRE((a == nullptr) == (b == nullptr));
+        if (a != nullptr) {
+            BOOST_CHECK_EQUAL_COLLECTIONS(a, a + n, b, b + n);
+        }
+    }
+
+    // Bitwise identical grids.
+    void checkIdentical(const UnstructuredGrid& g1, const UnstructuredGrid& g2)
+    {
+        BOOST_REQUIRE_EQUAL(g1.dimensions, g2.dimensions);
+        BOOST_REQUIRE_EQUAL(g1.number_of_cells, g2.number_of_cells);
+        BOOST_REQUIRE_EQUAL(g1.number_of_faces, g2.number_of_faces);
+        BOOST_REQUIRE_EQUAL(g1.number_of_nodes, g2.number_of_nodes);
+        const int nd = g1.dimensions;
+        const int nc = g1.number_of_cells;
+        const int nf = g1.number_of_faces;
+        checkArray(g1.cartdims, g2.cartdims, 3);
+        checkArray(g1.node_coordinates, g2.node_coordinates, nd*g1.number_of_nodes);
+        checkArray(g1.face_nodepos, g2.face_nodepos, nf + 1);
+        checkArray(g1.face_nodes, g2.face_nodes, g1.face_nodepos[nf]);
+        checkArray(g1.face_cells, g2.face_cells, 2*nf);
+        checkArray(g1.face_areas, g2.face_areas, nf);
+        checkArray(g1.face_centroids, g2.face_centroids, nd*nf);
+        checkArray(g1.face_normals, g2.face_normals, nd*nf);
+        checkArray(g1.cell_facepos, g2.cell_facepos, nc + 1);
+        checkArray(g1.cell_faces, g2.cell_faces, g1.cell_facepos[nc]);
+        checkArray(g1.cell_facetag, g2.cell_facetag, g1.cell_facepos[nc]);
+        checkArray(g1.global_cell, g2.global_cell, nc);
+        checkArray(g1.cell_volumes, g2.cell_volumes, nc);
+        checkArray(g1.cell_centroids, g2.cell_centroids, nd*nc);
+    }
+
+    GridPtr makeGrid(const bool with_tags, const bool with_indexmap)
+    {
+        // Large enough that the parallel reader uses many chunks.
+        GridPtr g(create_grid_hexa3d(23, 17, 11, 0.1, 0.3, 0.7));
+        for (int n = 0; n < 3*g->number_of_nodes; ++n) {
+            g->node_coordinates[n] += 1.0e-3*(n % 13); // Non-representable decimals.
+        }
+        if (!with_tags) {
+            free(g->cell_facetag);
+            g->cell_facetag = nullptr;
+        }
+        if (with_indexmap) {
+            g->global_cell = static_cast<int*>(malloc(g->number_of_cells * sizeof *g->global_cell));
+            for (int c = 0; c < g->number_of_cells; ++c) {
+                g->global_cell[c] = 2*c + 1;
+            }
+        }
+        return g;
+    }
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(TextReadersAgree)
+{
+    const std::string fname = "test_read_grid.txt";
+    for (const bool with_tags : { false, true }) {
+        for (const bool with_indexmap : { false, true }) {
+            GridPtr orig = makeGrid(with_tags, with_indexmap);
+            writeGridText(*orig, fname);
+            GridPtr seq(read_grid_text_sequential(fname.c_str()));
+            GridPtr par(read_grid_text_parallel(fname.c_str()));
+            GridPtr dflt(read_grid(fname.c_str()));
+            BOOST_REQUIRE(seq && par && dflt);
+            checkIdentical(*seq, *par);
+            checkIdentical(*seq, *dflt);
+        }
+    }
+    std::remove(fname.c_str());
+}
+
+
+BOOST_AUTO_TEST_CASE(TextReaderTokenization)
+{
+    // Mixed whitespace, explicit signs and trailing data.
+    const std::string fname = "test_read_grid_tokens.txt";
+    {
+        std::ofstream os(fname);
+        os << "3 1 3 3 6 3 0 0\r\n"
+           << "0\t0 0\r\n"
+           << "+0.0 0.0 1.0   0.0 1.0e0 0.0 0.0 1.0 1.0\n"
+           << "0 2 +4 6\n"
+           << "0 1 0 2 1 2\n"
+           << "0 -1 0 -1 0 -1\n"
+           << "1.4142135623730951 1.0 1.0\n"
+           << "0.0 0.5 0.5 0.0 0.5 1.0 0.0 1.0 0.5\n"
+           << "-1.1102230246251565e-16 -1.0 -1.0 1.1102230246251565e-16 0.0 1.0 0.0 1.0 0.0\n"
+           << "0 3\n"
+           << "0 1 2\n"
+           << "0.5\n"
+           << "0.0 0.6666666666666666 0.6666666666666666\n"
+           << "123 trailing data\n";
+    }
+    GridPtr seq(read_grid_text_sequential(fname.c_str()));
+    GridPtr par(read_grid_text_parallel(fname.c_str()));
+    BOOST_REQUIRE(seq && par);
+    checkIdentical(*seq, *par);
+
+    // Truncated file.
+    {
+        std::ofstream os(fname);
+        os << "3 1 3 3 6 3 0 0\n0 0 0\n0.0 0.0 1.0\n";
+    }
+    BOOST_CHECK(!GridPtr(read_grid_text_parallel(fname.c_str())));
+    BOOST_CHECK(!GridPtr(read_grid(fname.c_str())));
+    std::remove(fname.c_str());
+}
+
+
+BOOST_AUTO_TEST_CASE(BinaryRoundTrip)
+{
+    const std::string fname = "test_read_grid.bin";
+    const std::string text_fname = "test_read_grid_bin.txt";
+    for (const bool with_tags : { false, true }) {
+        for (const bool with_indexmap : { false, true }) {
+            GridPtr orig = makeGrid(with_tags, with_indexmap);
+            BOOST_REQUIRE(write_grid(orig.get(), fname.c_str()));
+            GridPtr bin(read_grid_binary(fname.c_str()));
+            GridPtr dflt(read_grid(fname.c_str()));
+            BOOST_REQUIRE(bin && dflt);
+            checkIdentical(*orig, *bin);
+            checkIdentical(*orig, *dflt);
+
+            // Same result as the text parser.
+            writeGridText(*orig, text_fname);
+            GridPtr seq(read_grid_text_sequential(text_fname.c_str()));
+            BOOST_REQUIRE(seq);
+            checkIdentical(*seq, *bin);
+        }
+    }
+    // Not a binary grid file.
+    BOOST_CHECK(!GridPtr(read_grid_binary(text_fname.c_str())));
+    std::remove(fname.c_str());
+    std::remove(text_fname.c_str());
+}
+
+
+BOOST_AUTO_TEST_CASE(BinaryInvalidHeader)
+{
+    const std::string fname = "test_read_grid_invalid.bin";
+    GridPtr orig = makeGrid(false, false);
+    BOOST_REQUIRE(write_grid(orig.get(), fname.c_str()));
+    std::string contents;
+    {
+        std::ifstream is(fname, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    // The header starts with the byte order mark, followed by the int size,
+    // the dimension and the entity counts.
+    const long long bom = 0x0102030405060708LL;
+    const auto header = contents.find(std::string(reinterpret_cast<const char*>(&bom), sizeof bom));
+    BOOST_REQUIRE(header != std::string::npos);
+
+    // Dimension, cell count, face count, node count.
+    const std::pair<int, long long> invalid[] = {
+        { 2, 4 }, { 2, 0 }, { 3, -1 }, { 4, 1LL << 40 }, { 5, -5 }
+    };
+    for (const auto& field : invalid) {
+        std::string corrupt = contents;
+        corrupt.replace(header + field.first * sizeof(long long), sizeof(long long),
+                        reinterpret_cast<const char*>(&field.second), sizeof(long long));
+        {
+            std::ofstream os(fname, std::ios::binary);
+            os.write(corrupt.data(), corrupt.size());
+        }
+        BOOST_CHECK(!GridPtr(read_grid_binary(fname.c_str())));
+    }
+    std::remove(fname.c_str());
+}
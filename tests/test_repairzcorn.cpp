@@ -55,6 +55,39 @@ namespace {
             }
         }
     }
+
+    void check_equal_stat(const ::Opm::UgGridHelpers::RepairZCORN::ZCornChangeCount& s1,
+                          const ::Opm::UgGridHelpers::RepairZCORN::ZCornChangeCount& s2)
+    {
+        BOOST_CHECK_EQUAL(s1.cells  , s2.cells);
+        BOOST_CHECK_EQUAL(s1.corners, s2.corners);
+    }
+
+    // Repair moved-in ZCORN values, checking that in-place repair of a
+    // copy gives the same values and statistics.
+    ::Opm::UgGridHelpers::RepairZCORN
+    repairBothWays(std::vector<double>&&   zcorn,
+                   const std::vector<int>& actnum,
+                   const std::vector<int>& cartDims)
+    {
+        auto in_place = zcorn;
+        const auto in_place_repair = ::Opm::UgGridHelpers::RepairZCORN{
+            in_place.data(), actnum, cartDims
+        };
+
+        auto repair = ::Opm::UgGridHelpers::RepairZCORN{
+            std::vector<double>(zcorn), actnum, cartDims
+        };
+
+        BOOST_CHECK_EQUAL(in_place_repair.switchedToDepth(), repair.switchedToDepth());
+        check_equal_stat(in_place_repair.statTopBelowBottom(), repair.statTopBelowBottom());
+        check_equal_stat(in_place_repair.statBottomBelowLowerTop(), repair.statBottomBelowLowerTop());
+        check_is_close(in_place, repair.destructivelyGrabSanitizedValues());
+
+        return ::Opm::UgGridHelpers::RepairZCORN{
+            std::move(zcorn), actnum, cartDims
+        };
+    }
 } // Namespace anonymous
 
 BOOST_AUTO_TEST_SUITE (Repair_AllActive)
@@ -78,9 +111,7 @@ BOOST_AUTO_TEST_CASE (NoChange)
 
     const auto expect = zcorn;
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -132,9 +163,7 @@ BOOST_AUTO_TEST_CASE (TopBelowBottom)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -186,9 +215,7 @@ BOOST_AUTO_TEST_CASE (BottomBelowLowerTop)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -240,9 +267,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -294,9 +319,7 @@ BOOST_AUTO_TEST_CASE (Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -348,9 +371,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -402,9 +423,7 @@ BOOST_AUTO_TEST_CASE (BBLT_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -456,9 +475,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -511,9 +528,7 @@ BOOST_AUTO_TEST_CASE (NoChange)
 
     const auto expect = zcorn;
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -575,9 +590,7 @@ BOOST_AUTO_TEST_CASE (TopBelowBottom)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -639,9 +652,7 @@ BOOST_AUTO_TEST_CASE (BottomBelowLowerTop)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -703,9 +714,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -767,9 +776,7 @@ BOOST_AUTO_TEST_CASE (Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -831,9 +838,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -895,9 +900,7 @@ BOOST_AUTO_TEST_CASE (BBLT_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -959,9 +962,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -1014,9 +1015,7 @@ BOOST_AUTO_TEST_CASE (NoChange)
 
     const auto expect = zcorn;
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -1078,9 +1077,7 @@ BOOST_AUTO_TEST_CASE (TopBelowBottom)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -1142,9 +1139,7 @@ BOOST_AUTO_TEST_CASE (BottomBelowLowerTop)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -1206,9 +1201,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), false);
 
@@ -1270,9 +1263,7 @@ BOOST_AUTO_TEST_CASE (Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -1337,9 +1328,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_Elevation)
         -2.0, -2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     // Only active input cell is twisted and doesn't allow determining sign
     // of ZCORN delta.  This is a deficiency of the current implementation.
@@ -1405,9 +1394,7 @@ BOOST_AUTO_TEST_CASE (BBLT_And_Elevation)
         2.0, 2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     BOOST_CHECK_EQUAL(repair.switchedToDepth(), true);
 
@@ -1472,9 +1459,7 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT_And_Elevation)
         -2.0, -2.0,
     };
 
-    auto repair = ::Opm::UgGridHelpers::RepairZCORN{
-        std::move(zcorn), actnum, cartDims
-    };
+    auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
 
     // Only active input cell is twisted and doesn't allow determining sign
     // of ZCORN delta.  This is a deficiency of the current implementation.
@@ -1502,3 +1487,122 @@ BOOST_AUTO_TEST_CASE (TBB_And_BBLT_And_Elevation)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+// =====================================================================
+
+namespace {
+    struct ReferenceRepair
+    {
+        std::vector<double> zcorn;
+        bool switchedToDepth{false};
+        std::size_t tbbCells{0}, tbbCorners{0}, bbltCells{0}, bbltCorners{0};
+    };
+
+    // Straightforward implementation of the three separate sweeps over
+    // the model: sign reversal, TBB, and BBLT in increasing cell order.
+    ReferenceRepair referenceRepair(std::vector<double>     zcorn,
+                                    const std::vector<int>& actnum,
+                                    const std::size_t nx, const std::size_t ny,
+                                    const std::size_t nz)
+    {
+        const auto layer = 4 * nx * ny;
+        const std::size_t pillar[] = { 0, 1, 2 * nx, 2 * nx + 1 };
+        auto start = [nx, ny](const std::size_t c)
+        {
+            const auto i = c % nx, j = (c / nx) % ny, k = c / (nx * ny);
+            return 2*i + 2*nx*(2*j + 2*ny*(2*k));
+        };
+
+        ReferenceRepair ref;
+
+        std::vector<int> signs;
+        for (std::size_t c = 0; c < nx * ny * nz; ++c) {
+            if (! actnum[c]) { continue; }
+            std::vector<int> sgn;
+            for (const auto off : pillar) {
+                const auto dz = zcorn[start(c) + off + layer] - zcorn[start(c) + off];
+                sgn.push_back((dz > 0.0) - (dz < 0.0));
+            }
+            const bool mixed = std::count(sgn.begin(), sgn.end(), 1) && std::count(sgn.begin(), sgn.end(), -1);
+            signs.push_back(mixed ? 0 : sgn.front());
+        }
+        const auto first = std::find_if(signs.begin(), signs.end(), [](const int s) { return s != 0; });
+        if ((first != signs.end()) && (*first == -1) && (std::count(signs.begin(), signs.end(), 1) == 0)) {
+            for (auto& z : zcorn) { z = -z; }
+            ref.switchedToDepth = true;
+        }
+
+        for (std::size_t c = 0; c < nx * ny * nz; ++c) {
+            if (! actnum[c]) { continue; }
+            std::size_t corners = 0;
+            for (const auto off : pillar) {
+                auto& zt = zcorn[start(c) + off];
+                if (zt > zcorn[start(c) + off + layer]) { zt = zcorn[start(c) + off + layer]; ++corners; }
+            }
+            ref.tbbCorners += corners;
+            ref.tbbCells   += corners > 0;
+        }
+
+        for (std::size_t c = 0; c < nx * ny * nz; ++c) {
+            if (! actnum[c]) { continue; }
+            auto below = c + nx * ny;
+            while ((below < nx * ny * nz) && ! actnum[below]) { below += nx * ny; }
+            if (below >= nx * ny * nz) { continue; }
+            std::size_t corners = 0;
+            for (const auto off : pillar) {
+                const auto zbu = zcorn[start(c) + off + layer];
+                auto&      ztd = zcorn[start(below) + off];
+                if (zbu > ztd) { ztd = zbu; ++corners; }
+            }
+            ref.bbltCorners += corners;
+            ref.bbltCells   += corners > 0;
+        }
+
+        ref.zcorn = std::move(zcorn);
+        return ref;
+    }
+} // Namespace anonymous
+
+BOOST_AUTO_TEST_SUITE (Repair_MultipleColumns)
+
+BOOST_AUTO_TEST_CASE (CompareToSeparateSweeps)
+{
+    const std::size_t nx = 5, ny = 4, nz = 6;
+    const auto cartDims = std::vector<int>{ int(nx), int(ny), int(nz) };
+
+    for (const double direction : { 1.0, -1.0 }) {
+        // Depth (or elevation) increasing down the pillars with pseudo-
+        // random perturbations making some cells' tops and bottoms cross.
+        auto zcorn = std::vector<double>(8 * nx * ny * nz);
+        auto actnum = std::vector<int>(nx * ny * nz);
+        unsigned int state = 12345;
+        auto next = [&state]() { state = 1103515245u*state + 12345u; return (state >> 16) % 100; };
+        for (std::size_t k = 0; k < 2 * nz; ++k) {
+            for (std::size_t j = 0; j < 2 * ny; ++j) {
+                for (std::size_t i = 0; i < 2 * nx; ++i) {
+                    const double z = ((k + 1) / 2) + ((next() < 20) ? 0.6 : 0.0) - ((next() < 20) ? 0.6 : 0.0);
+                    zcorn[i + 2*nx*(j + 2*ny*k)] = direction * z;
+                }
+            }
+        }
+        for (auto& a : actnum) { a = next() < 80; }
+
+        const auto ref = referenceRepair(zcorn, actnum, nx, ny, nz);
+        BOOST_CHECK_EQUAL(ref.switchedToDepth, direction < 0.0);
+        BOOST_CHECK(ref.tbbCells > 0);
+        BOOST_CHECK(ref.bbltCells > 0);
+
+        auto repair = repairBothWays(std::move(zcorn), actnum, cartDims);
+
+        BOOST_CHECK_EQUAL(repair.switchedToDepth(), ref.switchedToDepth);
+        BOOST_CHECK_EQUAL(repair.statTopBelowBottom().cells, ref.tbbCells);
+        BOOST_CHECK_EQUAL(repair.statTopBelowBottom().corners, ref.tbbCorners);
+        BOOST_CHECK_EQUAL(repair.statBottomBelowLowerTop().cells, ref.bbltCells);
+        BOOST_CHECK_EQUAL(repair.statBottomBelowLowerTop().corners, ref.bbltCorners);
+
+        zcorn = repair.destructivelyGrabSanitizedValues();
+        BOOST_CHECK(zcorn == ref.zcorn);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
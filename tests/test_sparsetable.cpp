@@ -42,6 +42,10 @@
 
 #include <opm/grid/utility/SparseTable.hpp>
 
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 using namespace Opm;
 
 BOOST_AUTO_TEST_CASE(construction_and_queries)
@@ -136,3 +140,38 @@ BOOST_AUTO_TEST_CASE(construction_and_queries)
     BOOST_CHECK_THROW(const SparseTable<int> st6(elem, elem + num_elem, err_rs, err_rs + num_rows), std::exception);
 #endif
 }
+
+
+BOOST_AUTO_TEST_CASE(index_type)
+{
+    // The index type only bounds the total number of entries. Use a
+    // narrow index type to exercise tables beyond its range without
+    // the memory a table beyond the range of int would need.
+    const int num_rows = 300;
+    const std::vector<signed char> rowsizes(num_rows, 120);
+    const std::vector<char> elem(num_rows * 120, 'x');
+
+    // Row sizes are accumulated in the index type, not in the type of the sizes.
+    const SparseTable<char, std::int32_t> st1(elem.begin(), elem.end(), rowsizes.begin(), rowsizes.end());
+    BOOST_CHECK_EQUAL(st1.size(), num_rows);
+    BOOST_CHECK_EQUAL(st1.dataSize(), num_rows * 120);
+    BOOST_CHECK_EQUAL(st1.rowSize(num_rows - 1), 120);
+    BOOST_CHECK_EQUAL(st1[num_rows - 1].size(), 120);
+
+    // 36000 entries do not fit a 16-bit index type.
+    using NarrowTable = SparseTable<char, std::int16_t>;
+    BOOST_CHECK_THROW(const NarrowTable st2(elem.begin(), elem.end(), rowsizes.begin(), rowsizes.end()), std::exception);
+    const NarrowTable st3(elem.begin(), elem.begin() + 270 * 120, rowsizes.begin(), rowsizes.begin() + 270);
+    BOOST_CHECK_EQUAL(st3.dataSize(), 270 * 120);
+
+    // The default index type follows the build configuration.
+    static_assert(std::is_same<SparseTable<int>::index_type, SparseTableIndexType>::value,
+                  "Unexpected default index type");
+    SparseTable<int, std::int64_t> st4;
+    const int row[3] = { 1, 2, 3 };
+    st4.appendRow(row, row + 3);
+    st4.appendRow(row, row + 1);
+    BOOST_CHECK_EQUAL(st4.dataSize(), std::int64_t(4));
+    BOOST_CHECK_EQUAL(st4.rowSize(1), 1);
+    BOOST_CHECK_EQUAL(st4.data(3), 1);
+}
@@ -24,7 +24,7 @@
 #define BOOST_TEST_MODULE VelocityInterpolationTest
 #include <boost/test/unit_test.hpp>
 
-#include <opm/core/utility/VelocityInterpolation.hpp>
+#include <opm/grid/utility/VelocityInterpolation.hpp>
 #include <opm/grid/GridManager.hpp>
 #include <opm/grid/UnstructuredGrid.h>
 #include <cmath>
@@ -482,3 +482,47 @@ BOOST_AUTO_TEST_CASE(test_VelocityInterpolationECVI)
 }
 
 
+
+BOOST_AUTO_TEST_CASE(test_VelocityInterpolationECVIBatch)
+{
+    // The batched interpolation must give the same result as
+    // interpolating one point at a time.
+    GridManager g(3, 2, 2);
+    const UnstructuredGrid& grid = *g.c_grid();
+    std::vector<double> v0 = { 0.12345, -0.6789, 0.4242 };
+    std::vector<double> v1 = { 0.1, 0.2, -0.3 };
+    std::vector<double> flux;
+    computeFluxLinear(grid, v0, v1, flux);
+    VelocityInterpolationECVI vic(grid);
+    vic.setupFluxes(&flux[0]);
+
+    const int dim = grid.dimensions;
+    const int num_cells = grid.number_of_cells;
+    const int points_per_cell = 3;
+    std::vector<int> cells;
+    std::vector<double> x;
+    for (int cell = 0; cell < num_cells; ++cell) {
+        for (int p = 0; p < points_per_cell; ++p) {
+            cells.push_back(cell);
+            for (int dd = 0; dd < dim; ++dd) {
+                x.push_back(grid.cell_centroids[dim*cell + dd] + 0.1*(p - 1)*(dd + 1));
+            }
+        }
+    }
+    const int num_points = cells.size();
+    std::vector<double> v_single(dim*num_points);
+    for (int p = 0; p < num_points; ++p) {
+        vic.interpolate(cells[p], &x[dim*p], &v_single[dim*p]);
+    }
+
+    std::vector<double> v_pairs(dim*num_points);
+    vic.interpolateBatch(num_points, cells.data(), x.data(), v_pairs.data());
+    BOOST_CHECK(vectorDiff2(v_single, v_pairs) < 1e-24);
+
+    std::vector<double> v_cell(dim*num_points);
+    for (int cell = 0; cell < num_cells; ++cell) {
+        const int offset = dim*points_per_cell*cell;
+        vic.interpolateBatch(cell, points_per_cell, &x[offset], &v_cell[offset]);
+    }
+    BOOST_CHECK(vectorDiff2(v_single, v_cell) < 1e-24);
+}
@@ -24,7 +24,7 @@
 #define BOOST_TEST_MODULE WachspressCoordTest
 #include <boost/test/unit_test.hpp>
 
-#include <opm/core/utility/WachspressCoord.hpp>
+#include <opm/grid/utility/WachspressCoord.hpp>
 #include <opm/grid/GridManager.hpp>
 #include <opm/grid/UnstructuredGrid.h>
 #include <cmath>